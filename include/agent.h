@@ -0,0 +1,127 @@
+/**
+ * @file agent.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _AGENT_H_
+#define _AGENT_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "state.h"
+
+/**
+ * @def AGENT_ACT_SYMBOL
+ * @brief Function a plugin must export, a PFNAGENTACT
+ */
+#define AGENT_ACT_SYMBOL "iAgentAct"
+
+/**
+ * @def AGENT_INIT_SYMBOL
+ * @brief Optional function of a plugin called once, a PFNAGENTINIT
+ */
+#define AGENT_INIT_SYMBOL "bAgentInit"
+
+/**
+ * @def AGENT_CLOSE_SYMBOL
+ * @brief Optional function of a plugin called on exit, a PFNAGENTCLOSE
+ */
+#define AGENT_CLOSE_SYMBOL "vAgentClose"
+
+/**
+ * @def AGENT_HEADLESS_MAX_TICKS
+ * @brief Decisions after which a headless agent run stops, the level time
+ * only runs once a dot is eaten
+ */
+#define AGENT_HEADLESS_MAX_TICKS 1000000UL
+
+/**
+ * @typedef PFNAGENTACT
+ * @brief Choose the move of the hero after a tick
+ *
+ * The state is the whole game (see state.h, check its usVersion), the hero
+ * is astEntity[0]. Called by the simulation on each tick, without events.
+ *
+ * @return UP_MOVEMENT, LEFT_MOVEMENT, DOWN_MOVEMENT, RIGHT_MOVENT or
+ * NONE_MOVEMENT to keep the current one
+ */
+typedef int (*PFNAGENTACT)(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @typedef PFNAGENTINIT
+ * @brief Set the agent up
+ *
+ * @return FALSE refuses to play (state version not supported...)
+ */
+typedef boolean (*PFNAGENTINIT)(Uint32 uiSeed);
+
+/**
+ * @typedef PFNAGENTCLOSE
+ * @brief Free what the agent holds
+ */
+typedef void (*PFNAGENTCLOSE)(void);
+
+/**
+ * @brief Select the agent that drives the hero
+ *
+ * @param kpszAgent Built-in agent (random, greedy or mcts) or path of a shared
+ * library exporting AGENT_ACT_SYMBOL
+ * @param uiSeed Seed of the agent, its random numbers are not the game ones
+ * @return TRUE agent ready
+ * @return FALSE unknown agent, library or symbol not found, init refused
+ */
+boolean bInitAgent(const char* kpszAgent, Uint32 uiSeed);
+
+/**
+ * @brief Check if an agent drives the hero
+ *
+ * @return TRUE agent selected
+ * @return FALSE keyboard only
+ */
+boolean bAgentActive(void);
+
+/**
+ * @brief Give the game to the agent and post its move, called by the
+ * simulation after each tick and when a level starts
+ */
+void vRunAgent(void);
+
+/**
+ * @brief Get the decisions taken by the agent
+ *
+ * @return Decisions
+ */
+unsigned long ulGetAgentDecisions(void);
+
+/**
+ * @brief Print the decisions of the agent and their rate
+ *
+ * @param fpOut Output file
+ * @param ullElapsed Time taken (us)
+ */
+void vPrintAgentStats(FILE* fpOut, Uint64 ullElapsed);
+
+/**
+ * @brief Close the agent and unload its library
+ */
+void vCloseAgent(void);
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file anim.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _ANIM_H_
+#define _ANIM_H_
+
+#include <SDL2/SDL.h>
+#include "entity.h"
+
+/**
+ * @def ANIM_MAX_FRAMES
+ * @brief Maximum frames of an animation
+ */
+#define ANIM_MAX_FRAMES 4
+
+/**
+ * @def ANIM_DIRECTIONS
+ * @brief Directions of the animation table, NONE_MOVEMENT up to RIGHT_MOVENT
+ */
+#define ANIM_DIRECTIONS 5
+
+/**
+ * @def HERO_WALK_FRAME_MS
+ * @brief Time each hero walk frame is shown, a whole cycle per tick
+ */
+#define HERO_WALK_FRAME_MS 125
+
+/**
+ * @enum ENUM_ANIM_STATE
+ * @brief What the entity is doing
+ */
+typedef enum ENUM_ANIM_STATE {
+  ANIM_IDLE,       /**< Standing         */
+  ANIM_WALK,       /**< Moving           */
+  ANIM_SCARED,     /**< Ghost under power */
+  ANIM_STATE_COUNT
+} ENUM_ANIM_STATE, *PENUM_ANIM_STATE;
+
+/**
+ * @struct STRUCT_ANIMATION
+ * @brief Sprite indexes of an animation loop
+ */
+typedef struct STRUCT_ANIMATION {
+  int aiFrame[ANIM_MAX_FRAMES]; /**< Sprite of each frame    */
+  int iCtFrames;                /**< Frames in the loop      */
+  Uint32 uiFrameMs;             /**< Time of a frame (ms)    */
+} STRUCT_ANIMATION, *PSTRUCT_ANIMATION;
+
+/**
+ * @brief Get the sprite of an entity at a moment of its animation
+ *
+ * @param pstEntity Entity (type and movement direction)
+ * @param eState What the entity is doing
+ * @param uiElapsedMs Animation clock in ms
+ * @return Index of the sprite in the entity sprite sheet
+ */
+int iGetAnimationSprite(PSTRUCT_ENTITY pstEntity, ENUM_ANIM_STATE eState, Uint32 uiElapsedMs);
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file assets.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _ASSETS_H_
+#define _ASSETS_H_
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include "util.h"
+
+/**
+ * @def MAX_ASSETS
+ * @brief Maximum assets queued at once
+ */
+#define MAX_ASSETS 32
+
+/**
+ * @def ASSET_MAX_WORKERS
+ * @brief Maximum decoding threads
+ */
+#define ASSET_MAX_WORKERS 4
+
+/**
+ * @def ASSET_POLL_MS
+ * @brief Interval between two loading screen updates
+ */
+#define ASSET_POLL_MS 15
+
+/**
+ * @enum ENUM_ASSET_KIND
+ * @brief What an asset file is decoded to
+ */
+typedef enum ENUM_ASSET_KIND {
+  ASSET_IMAGE, /**< SDL_Surface, uploaded as SDL_Texture */
+  ASSET_SOUND, /**< Mix_Chunk                            */
+  ASSET_MUSIC  /**< Mix_Music                            */
+} ENUM_ASSET_KIND, *PENUM_ASSET_KIND;
+
+/**
+ * @typedef PFNASSETPROGRESS
+ * @brief Called by the loading thread while the assets are decoded
+ */
+typedef void (*PFNASSETPROGRESS)(int iCtDone, int iCtTotal);
+
+/**
+ * @brief Queue an asset to be decoded by bLoadAssets
+ *
+ * @param eKind What the file is decoded to
+ * @param kpszPath File path
+ * @return Handle of the asset or -1 when the queue is full
+ */
+int iQueueAsset(ENUM_ASSET_KIND eKind, const char* kpszPath);
+
+/**
+ * @brief Decode the queued assets in a pool of threads
+ *
+ * The images are uploaded as textures by the calling thread as soon as they
+ * are decoded, so it must be the render thread.
+ *
+ * @param pfnProgress Called while waiting (may be NULL)
+ * @return TRUE all threads finished (some asset may have failed)
+ * @return FALSE no thread could be created, the assets were decoded serially
+ */
+boolean bLoadAssets(PFNASSETPROGRESS pfnProgress);
+
+/**
+ * @brief Take the texture of a decoded image, the caller owns it
+ *
+ * @param iHandle Asset handle
+ * @return The texture or NULL on error
+ */
+SDL_Texture* pstTakeAssetTexture(int iHandle);
+
+/**
+ * @brief Take a decoded sound, the caller owns it
+ *
+ * @param iHandle Asset handle
+ * @return The sound or NULL on error
+ */
+Mix_Chunk* pstTakeAssetSound(int iHandle);
+
+/**
+ * @brief Take a decoded music, the caller owns it
+ *
+ * @param iHandle Asset handle
+ * @return The music or NULL on error
+ */
+Mix_Music* pstTakeAssetMusic(int iHandle);
+
+/**
+ * @brief Free every asset not taken and empty the queue
+ */
+void vDestroyAssets(void);
+
+#endif
@@ -24,6 +24,7 @@
 #define _AUDIO_H_
 
 #include <SDL2/SDL_mixer.h>
+#include "util.h"
 
 /**
  * @def AUDIO_FREQUENCY
@@ -38,4 +39,106 @@
  */
 #define AUDIO_CHUNKSIZE 2048
 
+/**
+ * @def AUDIO_CHANNELS
+ * @brief Default output channels (stereo)
+ */
+#define AUDIO_CHANNELS 2
+
+/**
+ * @struct STRUCT_AUDIO_SPEC
+ * @brief Format of the sound device
+ */
+typedef struct STRUCT_AUDIO_SPEC {
+  int iFrequency; /**< Sample rate in Hz                    */
+  int iChunkSize; /**< Buffer size in sample frames         */
+  int iChannels;  /**< Output channels                      */
+} STRUCT_AUDIO_SPEC, *PSTRUCT_AUDIO_SPEC;
+
+/**
+ * @enum ENUM_AUDIO_BACKEND
+ * @brief Where the sound goes
+ */
+typedef enum ENUM_AUDIO_BACKEND {
+  AUDIO_BACKEND_MIXER, /**< SDL_mixer on the default device      */
+  AUDIO_BACKEND_NULL   /**< Nothing decoded and nothing played   */
+} ENUM_AUDIO_BACKEND, *PENUM_AUDIO_BACKEND;
+
+/**
+ * @struct STRUCT_AUDIO_BACKEND
+ * @brief Operations of an audio backend
+ */
+typedef struct STRUCT_AUDIO_BACKEND {
+  const char* kpszName;                     /**< Name shown in the trace */
+  boolean (*pfnOpen)(void);                 /**< Open the device         */
+  void (*pfnClose)(void);                   /**< Close the device        */
+  void (*pfnPlayMusic)(Mix_Music* pstMusic);/**< Play a music in loop    */
+  void (*pfnPauseMusic)(void);              /**< Pause the music         */
+  void (*pfnHaltMusic)(void);               /**< Stop the music          */
+} STRUCT_AUDIO_BACKEND, *PSTRUCT_AUDIO_BACKEND;
+
+/**
+ * @var geAudioBackend
+ * @brief Backend requested by the command line, set before bOpenAudio
+ */
+extern ENUM_AUDIO_BACKEND geAudioBackend;
+
+/**
+ * @var gstAudioSpec
+ * @brief Format requested by bSetAudioSpec, updated by bOpenAudio with the
+ * format the device accepted
+ */
+extern STRUCT_AUDIO_SPEC gstAudioSpec;
+
+/**
+ * @brief Validate and set the format the device is opened with
+ *
+ * @param iFrequency Sample rate in Hz (8000 to 192000, 0 default)
+ * @param iChunkSize Buffer in sample frames, power of two (64 to 8192, 0
+ * default)
+ * @param iChannels Output channels (1, 2, 4, 6 or 8, 0 default)
+ * @return TRUE format set
+ * @return FALSE some value out of range
+ */
+boolean bSetAudioSpec(int iFrequency, int iChunkSize, int iChannels);
+
+/**
+ * @brief Open the requested backend, falling back to the null one when the
+ * device can not be opened
+ *
+ * @return TRUE sound enabled
+ * @return FALSE null backend, the sounds must not be loaded
+ */
+boolean bOpenAudio(void);
+
+/**
+ * @brief Close the backend opened by bOpenAudio
+ */
+void vCloseAudio(void);
+
+/**
+ * @brief Check if the sound is enabled
+ *
+ * @return TRUE the mixer is open
+ * @return FALSE null backend
+ */
+boolean bAudioEnabled(void);
+
+/**
+ * @brief Play a music in loop
+ *
+ * @param pstMusic Music (may be NULL)
+ */
+void vPlayMusic(Mix_Music* pstMusic);
+
+/**
+ * @brief Pause the music
+ */
+void vPauseMusic(void);
+
+/**
+ * @brief Stop the music
+ */
+void vHaltMusic(void);
+
 #endif
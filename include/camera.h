@@ -0,0 +1,124 @@
+/**
+ * @file camera.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _CAMERA_H_
+#define _CAMERA_H_
+
+#include "util.h"
+
+/**
+ * @def VIEW_COLS
+ * @brief Map cols shown across the screen without zoom
+ */
+#define VIEW_COLS 16
+
+/**
+ * @def VIEW_ROWS
+ * @brief Map rows shown down the screen without zoom
+ */
+#define VIEW_ROWS 16
+
+/**
+ * @def CAMERA_ZOOM_LEVELS
+ * @brief Quantity of zoom levels
+ */
+#define CAMERA_ZOOM_LEVELS 5
+
+/**
+ * @def CAMERA_DEFAULT_ZOOM
+ * @brief Zoom level at start (no zoom)
+ */
+#define CAMERA_DEFAULT_ZOOM 2
+
+/**
+ * @def MINIMAP_SIZE
+ * @brief Side of the minimap in logical pixels
+ */
+#define MINIMAP_SIZE 120
+
+/**
+ * @def MINIMAP_TOP
+ * @brief Logical y of the minimap, below the clock
+ */
+#define MINIMAP_TOP 40
+
+/**
+ * @struct STRUCT_CAMERA
+ * @brief Part of the map shown on the screen
+ */
+typedef struct STRUCT_CAMERA {
+  float fCol;         /**< Map col at the left edge of the screen */
+  float fRow;         /**< Map row at the top edge of the screen  */
+  float fCellWidth;   /**< Logical width of a cell                */
+  float fCellHeight;  /**< Logical height of a cell               */
+  int iZoom;          /**< Zoom level                             */
+  int iFirstCol;      /**< First visible col                      */
+  int iFirstRow;      /**< First visible row                      */
+  int iLastCol;       /**< Last visible col                       */
+  int iLastRow;       /**< Last visible row                       */
+  boolean bMinimap;   /**< Minimap shown                          */
+} STRUCT_CAMERA, *PSTRUCT_CAMERA;
+
+/**
+ * @var gstCamera
+ * @brief Camera of the render
+ */
+extern STRUCT_CAMERA gstCamera;
+
+/**
+ * @brief Center the camera on a map position, clamped to the map edges, and
+ * compute the visible cells
+ *
+ * @param fFocusCol Map col to follow
+ * @param fFocusRow Map row to follow
+ */
+void vUpdateCamera(float fFocusCol, float fFocusRow);
+
+/**
+ * @brief Change the zoom level
+ *
+ * @param iStep Positive zooms in, negative zooms out
+ */
+void vZoomCamera(int iStep);
+
+/**
+ * @brief Show or hide the minimap
+ */
+void vToggleMinimap(void);
+
+/**
+ * @brief Convert a map col to a logical x
+ *
+ * @param fCol Map col
+ * @return Logical x of the left edge of the col
+ */
+float fCameraX(float fCol);
+
+/**
+ * @brief Convert a map row to a logical y
+ *
+ * @param fRow Map row
+ * @return Logical y of the top edge of the row
+ */
+float fCameraY(float fRow);
+
+#endif
@@ -25,6 +25,16 @@
 
 #include "sprite.h"
 
+/**
+ * @enum ENUM_ENTITY_TYPE
+ * @brief Kind of the entity, selects its animations
+ */
+typedef enum ENUM_ENTITY_TYPE {
+  ENTITY_HERO,      /**< The player */
+  ENTITY_GHOST,     /**< An enemy   */
+  ENTITY_TYPE_COUNT
+} ENUM_ENTITY_TYPE, *PENUM_ENTITY_TYPE;
+
 /**
  * @struct STRUCT_ENTITY
  * @brief Structure that represents an entity
@@ -32,13 +42,15 @@
 typedef struct STRUCT_ENTITY {
   int iX;                              /**< Current col                            */
   int iY;                              /**< Current row                            */
+  int iPrevX;                          /**< Col at the previous tick               */
+  int iPrevY;                          /**< Row at the previous tick               */
   int iInitialX;                       /**< Initial col                            */
   int iInitialY;                       /**< Initial row                            */
-  PSTRUCT_SPRITE_SHEET pstSpriteSheet; /**< Sprite sheet of the entity             */
   char chLetter;                       /**< Representation of the entity in gszMap */
   char chOldXY;                        /**< Old character in gszMap                */
   int iLives;                          /**< Quantity of the entity's lives         */
   int iMovementDirection;              /**< Move direction of the entity           */
+  ENUM_ENTITY_TYPE eType;              /**< Kind of the entity                     */
 } STRUCT_ENTITY, *PSTRUCT_ENTITY;
 
 #endif
@@ -38,6 +38,21 @@
 #include "map.h"
 #include "hud.h"
 #include "gui.h"
+#include "pacer.h"
+#include "profile.h"
+#include "timeline.h"
+#include "rng.h"
+#include "replay.h"
+#include "anim.h"
+#include "snapshot.h"
+#include "state.h"
+#include "rules.h"
+#include "rewind.h"
+#include "agent.h"
+#include "mcts.h"
+#include "vecenv.h"
+#include "sim.h"
+#include "assets.h"
 
 /******************************************************************************
  *                                                                            *
@@ -117,6 +132,30 @@ typedef struct STRUCT_COMMAND_LINE {
   char szLevelDir[_MAX_PATH]; /**< Level dir path  */
   char szFontDir[_MAX_PATH];  /**< TTFs dir path   */
   char szAudioDir[_MAX_PATH]; /**< Audio dir path  */
+  int iOffscreenFrames;       /**< Offscreen frames */
+  char szFrameDumpDir[_MAX_PATH]; /**< Offscreen PNG dir */
+  char szFramePacing[32];     /**< Frame pacing mode */
+  boolean bFrameStats;        /**< Print frame stats on exit */
+  boolean bThreaded;          /**< Simulation in its own thread */
+  boolean bNoAudio;           /**< Null audio backend */
+  int iAudioRate;             /**< Sample rate, 0 default */
+  int iAudioBuffer;           /**< Buffer frames, 0 default */
+  int iAudioChannels;         /**< Output channels, 0 default */
+  boolean bAudioLatencyTest;  /**< Print the sound latency on exit */
+  long lTraceMaxSize;         /**< Trace rotation size, 0 never */
+  char szTraceFormat[32];     /**< Trace format, text or binary */
+  char szProfileOut[_MAX_PATH]; /**< Per frame phase times CSV */
+  char szTraceEvents[_MAX_PATH]; /**< Chrome trace event JSON */
+  char szRecord[_MAX_PATH];   /**< Replay file written */
+  char szReplay[_MAX_PATH];   /**< Replay file played */
+  char szReplaySpeed[32];     /**< Replay speed, normal or max */
+  boolean bHeadless;          /**< Replay without window */
+  char szStateFile[_MAX_PATH]; /**< Quick save file */
+  char szAgent[_MAX_PATH];    /**< Agent name or library */
+  int iMctsBudget;            /**< Search ms of the mcts agent, 0 default */
+  int iMctsThreads;           /**< Searches of the mcts agent, 0 per CPU */
+  char szVecEnv[_MAX_PATH];   /**< Shared memory of the environments */
+  int iVecEnvCount;           /**< Environments served, 0 default */
 } STRUCT_COMMAND_LINE, *PSTRUCT_COMMAND_LINE;
 
 /**
@@ -155,12 +194,6 @@ extern const char* gkpaszHelpCmdLineMessages[];
  *                                                                            *
  ******************************************************************************/
 
-/**
- * @typedef PFNMOVEMENTS
- * @brief Function pointer to movement functions
- */
-typedef void (*PFNMOVEMENTS)(void);
-
 /**
  * @enum ENUM_STATUS
  * @brief Enumeration that represents game's status
@@ -185,7 +218,8 @@ typedef enum ENUM_STATUS {
 boolean bInitGame(void);
 
 /**
- * @brief Load all sprites of the game
+ * @brief Create the sprite sheets of the images decoded by bInitGame, called
+ * once by the render side
  *
  * @return TRUE load with success
  * @return FALSE sprite load error
@@ -224,13 +258,17 @@ void vHandleEvents(void);
 
 /**
  * @brief Show the map of the current level on the screen
+ *
+ * @param pstSnapshot Simulation state drawn
  */
-void vDrawMap(void);
+void vDrawMap(PSTRUCT_SNAPSHOT pstSnapshot);
 
 /**
  * @brief Draw game info on the screen
+ *
+ * @param pstSnapshot Simulation state drawn
  */
-void vDrawGameInfo(void);
+void vDrawGameInfo(PSTRUCT_SNAPSHOT pstSnapshot);
 
 /**
  * @brief ...
@@ -281,32 +319,58 @@ boolean bLevelComplete(void);
 boolean bWinGame(void);
 
 /**
- * @brief Command press up or w key
+ * @brief Run the rules of a tick on the game through a view (vRuleHeroMove and
+ * vRuleGhostsMove), then play their sounds and messages
  */
-void vUp(void);
+void vMove(void);
 
 /**
- * @brief Command press a or left key
+ * @brief Run the simulation: overlay close functions, inputs, status and the
+ * tick when it is due, then publish a snapshot if anything changed
  */
-void vLeft(void);
+void vSimStep(void);
 
 /**
- * @brief Command press down or s key
+ * @brief Hash the map, the scores, the level time and the entities, two runs
+ * ended in the same game have the same hash
+ *
+ * @return ullHashBytes of the game state folded to 32 bits
  */
-void vDown(void);
+Uint32 uiGameStateHash(void);
 
 /**
- * @brief Command press right or d key
+ * @brief Check if the overlay on the screen ends the game
+ *
+ * @return TRUE game over or last level won
+ * @return FALSE the game goes on after the overlay
  */
-void vRight(void);
+boolean bGameFinished(void);
 
 /**
- * @brief Call vHeroMove and vGhostsMove
+ * @brief Publish the game again after its globals were replaced, called by
+ * the simulation when a state is restored
+ *
+ * @param bLevelChanged TRUE when the walls may differ, the render drops its
+ * chunks
  */
-void vMove(void);
+void vRefreshGameState(boolean bLevelChanged);
 
 /**
- * @brief Update the screen
+ * @brief Print the level, the score, the lives and the state hash
+ *
+ * @param fpOut Output file
+ */
+void vPrintGameResult(FILE* fpOut);
+
+/**
+ * @brief Get the time left to the next simulation tick
+ *
+ * @return Milliseconds, 0 when the tick is due
+ */
+Uint32 uiGetTickWaitMs(void);
+
+/**
+ * @brief Draw the newest simulation snapshot on the screen
  */
 void vUpdateScreen(void);
 
@@ -376,10 +440,4 @@ extern int giCurrentLevelTime;
  */
 extern Mix_Music* gpstMusic;
 
-/**
- * @var gpstGameOverSound
- * @brief It's the game over sound
- */
-static Mix_Chunk* gpstGameOverSound = NULL;
-
 #endif
@@ -0,0 +1,114 @@
+/**
+ * @file gfxstat.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _GFXSTAT_H_
+#define _GFXSTAT_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include "util.h"
+
+/**
+ * @enum ENUM_GFX_COUNTER
+ * @brief Renderer and resource counters
+ */
+typedef enum ENUM_GFX_COUNTER {
+  GFX_DRAW_CALLS,         /**< Clear, copy, rect and geometry calls */
+  GFX_COLOR_CHANGES,      /**< SDL_SetRenderDrawColor calls         */
+  GFX_TEXTURES_CREATED,   /**< Textures created                     */
+  GFX_TEXTURES_DESTROYED, /**< Textures destroyed                   */
+  GFX_SURFACES_CREATED,   /**< Surfaces created, loaded or rendered */
+  GFX_FONTS_OPENED,       /**< TTF_OpenFont calls                   */
+  GFX_BYTES_UPLOADED,     /**< Pixel bytes sent to new textures     */
+  GFX_COUNTER_COUNT
+} ENUM_GFX_COUNTER, *PENUM_GFX_COUNTER;
+
+/**
+ * @struct STRUCT_GFX_STATS
+ * @brief Statistics of a counter over the recorded frames
+ */
+typedef struct STRUCT_GFX_STATS {
+  Uint64 ullTotal;  /**< Count since the start, skipped frames included */
+  Uint32 uiLast;    /**< Count in the last frame                        */
+  Uint32 uiMax;     /**< Maximum count in a frame                       */
+  Uint32 uiAvg;     /**< Average count per frame                        */
+} STRUCT_GFX_STATS, *PSTRUCT_GFX_STATS;
+
+/**
+ * @brief Close the current frame of the counters
+ */
+void vEndGfxFrame(void);
+
+/**
+ * @brief Add the counts of the current frame to the totals only, used when
+ * the loop was blocked waiting for the user
+ */
+void vSkipGfxFrame(void);
+
+/**
+ * @brief Get the statistics of a counter
+ *
+ * @param eCounter Counter
+ * @param pstStats Receives the statistics
+ */
+void vGetGfxStats(ENUM_GFX_COUNTER eCounter, PSTRUCT_GFX_STATS pstStats);
+
+/**
+ * @brief Get the name of a counter
+ *
+ * @param eCounter Counter
+ * @return Short name, also the CSV column
+ */
+const char* kpszGfxCounterName(ENUM_GFX_COUNTER eCounter);
+
+/**
+ * @brief Print the counter statistics
+ *
+ * @param fpOut Output file
+ */
+void vPrintGfxStats(FILE* fpOut);
+
+/*
+ * Counted versions of the SDL calls, same parameters and return as the SDL
+ * function of the same name
+ */
+int iGfxRenderClear(SDL_Renderer* pstRenderer);
+int iGfxRenderCopy(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Rect* pstSrc, const SDL_Rect* pstDst);
+int iGfxRenderCopyF(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Rect* pstSrc, const SDL_FRect* pstDst);
+int iGfxRenderDrawRect(SDL_Renderer* pstRenderer, const SDL_Rect* pstRect);
+int iGfxRenderDrawRectF(SDL_Renderer* pstRenderer, const SDL_FRect* pstRect);
+int iGfxRenderFillRect(SDL_Renderer* pstRenderer, const SDL_Rect* pstRect);
+int iGfxRenderFillRectF(SDL_Renderer* pstRenderer, const SDL_FRect* pstRect);
+int iGfxRenderGeometry(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Vertex* pstVertices, int iCtVertices, const int* kpiIndices, int iCtIndices);
+int iGfxSetRenderDrawColor(SDL_Renderer* pstRenderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+SDL_Texture* pstGfxCreateTextureFromSurface(SDL_Renderer* pstRenderer, SDL_Surface* pstSurface);
+void vGfxDestroyTexture(SDL_Texture* pstTexture);
+SDL_Surface* pstGfxCreateRGBSurfaceWithFormat(Uint32 uiFlags, int iWidth, int iHeight, int iDepth, Uint32 uiFormat);
+SDL_Surface* pstGfxLoadImage(const char* kpszFile);
+SDL_Texture* pstGfxLoadTexture(SDL_Renderer* pstRenderer, const char* kpszFile);
+TTF_Font* pstGfxOpenFont(const char* kpszFile, int iSize);
+SDL_Surface* pstGfxRenderTextBlended(TTF_Font* pstFont, const char* kpszText, SDL_Color stColor);
+SDL_Surface* pstGfxRenderGlyphBlended(TTF_Font* pstFont, Uint16 usGlyph, SDL_Color stColor);
+
+#endif
@@ -24,7 +24,7 @@
 #define _GHOST_H_
 
 #include "entity.h"
-#include "audio.h"
+#include "sound.h"
 
 /**
  * @def MAX_GHOSTS
@@ -80,10 +80,4 @@ typedef struct STRUCT_ENTITY STRUCT_GHOST;
  */
 extern STRUCT_GHOST gastGhost[MAX_GHOSTS];
 
-/**
- * @var gpstGhostDeathSound
- * @brief It's the ghost death sound
- */
-extern Mix_Chunk* gpstGhostDeathSound;
-
 #endif
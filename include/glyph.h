@@ -0,0 +1,123 @@
+/**
+ * @file glyph.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _GLYPH_H_
+#define _GLYPH_H_
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+/**
+ * @def GLYPH_FIRST
+ * @brief First printable character stored in the atlas
+ */
+#define GLYPH_FIRST ' '
+
+/**
+ * @def GLYPH_LAST
+ * @brief Last printable character stored in the atlas
+ */
+#define GLYPH_LAST '~'
+
+/**
+ * @def GLYPH_COUNT
+ * @brief Quantity of glyphs stored in the atlas
+ */
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+
+/**
+ * @def GLYPH_ATLAS_WIDTH
+ * @brief Width in pixels of the atlas texture
+ */
+#define GLYPH_ATLAS_WIDTH 512
+
+/**
+ * @def GLYPH_MAX_BATCH
+ * @brief Maximum glyphs drawn by a single call of iDrawGlyphText
+ */
+#define GLYPH_MAX_BATCH 256
+
+/**
+ * @def MAX_GLYPH_ATLAS
+ * @brief Maximum font sizes cached at the same time
+ */
+#define MAX_GLYPH_ATLAS 4
+
+/**
+ * @struct STRUCT_GLYPH_ATLAS
+ * @brief Printable ASCII glyphs of one font size rasterized in a texture
+ */
+typedef struct STRUCT_GLYPH_ATLAS {
+  SDL_Texture* pstTexture;        /**< Atlas texture (white glyphs)     */
+  SDL_Rect astGlyph[GLYPH_COUNT]; /**< Glyph rects inside the atlas     */
+  int iAtlasWidth;                /**< Atlas texture width              */
+  int iAtlasHeight;               /**< Atlas texture height             */
+  int iFontSize;                  /**< Logical font size                */
+  float fScale;                   /**< Atlas pixels per logical pixel   */
+  int iHeight;                    /**< Logical line height of the font  */
+} STRUCT_GLYPH_ATLAS, *PSTRUCT_GLYPH_ATLAS;
+
+/**
+ * @brief Get the glyph atlas of a font size, rasterizing it on first use
+ *
+ * Glyphs are rasterized at the current render scale, so the atlases must be
+ * destroyed when it changes.
+ *
+ * @param iFontSize Font size
+ * @return Pointer to the atlas or NULL on error
+ */
+PSTRUCT_GLYPH_ATLAS pstGetGlyphAtlas(int iFontSize);
+
+/**
+ * @brief Free all atlases created by pstGetGlyphAtlas
+ */
+void vDestroyGlyphAtlases(void);
+
+/**
+ * @brief Measure the width of a text drawn with an atlas
+ *
+ * @param pstAtlas Glyph atlas
+ * @param kpszText Text
+ * @return Width in logical pixels
+ */
+int iGlyphTextWidth(PSTRUCT_GLYPH_ATLAS pstAtlas, const char* kpszText);
+
+/**
+ * @brief Draw a text as one batch of textured quads
+ *
+ * @param pstRenderer Pointer to renderer
+ * @param pstAtlas Glyph atlas
+ * @param iX Left position
+ * @param iY Top position
+ * @param kpszText Text
+ * @param stColor Text color
+ * @return Width in logical pixels of the drawn text
+ */
+int iDrawGlyphText(
+  SDL_Renderer* pstRenderer,
+  PSTRUCT_GLYPH_ATLAS pstAtlas,
+  int iX,
+  int iY,
+  const char* kpszText,
+  SDL_Color stColor);
+
+#endif
@@ -26,8 +26,11 @@
 #include <SDL2/SDL_image.h>
 #include "util.h"
 #include "trace.h"
-#include "audio.h"
+#include "sound.h"
 #include "hud.h"
+#include "overlay.h"
+#include "render.h"
+#include "gfxstat.h"
 
 /**
  * @def WINDOW_WIDTH
@@ -40,17 +43,37 @@
  */
 #define WINDOW_HEIGHT 625
 
+/**
+ * @def LOGICAL_WIDTH
+ * @brief Width of the logical screen where everything is drawn, SDL scales
+ * it to the window size
+ */
+#define LOGICAL_WIDTH  WINDOW_WIDTH
+
+/**
+ * @def LOGICAL_HEIGHT
+ * @brief Height of the logical screen where everything is drawn
+ */
+#define LOGICAL_HEIGHT WINDOW_HEIGHT
+
 /**
  * @def FPS
- * @brief Frame Per Second
+ * @brief Simulation ticks per second, the entities move one cell per tick
  */
 #define FPS 2
 
 /**
- * @def FRAME_DELAY
- * @brief Frame delay based in FPS define
+ * @def TICK_PERIOD_US
+ * @brief Simulation tick period in microseconds
  */
-#define FRAME_DELAY (1000 / FPS)
+#define TICK_PERIOD_US (1000000UL / FPS)
+
+/**
+ * @def RENDER_FPS
+ * @brief Frames drawn per second, the entities are interpolated between
+ * ticks
+ */
+#define RENDER_FPS 60
 
 /**
  * @def FONT_NAME
@@ -72,16 +95,31 @@ boolean bInitSDL(void);
 void vDestroySDL(void);
 
 /**
- * @var giFrameStart
- * @brief It's the start frame of main loop
+ * @brief Handle a window event stored in gunEvent (resize limits)
  */
-extern Uint32 giFrameStart;
+void vHandleWindowEvent(void);
 
 /**
- * @var giFrameTime
- * @brief It's the frame time between the start frame and the end of the game loop
+ * @brief Present the frame drawn in the renderer
+ *
+ * In offscreen mode the frame hash is printed and the frame may be saved as
+ * PNG.
  */
-extern Uint32 giFrameTime;
+void vPresentFrame(void);
+
+/**
+ * @brief Draw the progress of the asset loading, nothing is drawn offscreen
+ *
+ * @param iCtDone Assets decoded
+ * @param iCtTotal Assets queued
+ */
+void vDrawLoadingScreen(int iCtDone, int iCtTotal);
+
+/**
+ * @brief Recompute gfRenderScale from the renderer output size and drop the
+ * prescaled textures when it changed
+ */
+void vUpdateRenderScale(void);
 
 /**
  * @var gbRun
@@ -119,6 +157,31 @@ extern int giWindowWidth;
  */
 extern int giWindowHeight;
 
+/**
+ * @var gfRenderScale
+ * @brief Output pixels per logical pixel, used to prescale cached textures
+ */
+extern float gfRenderScale;
+
+/**
+ * @var gbVSync
+ * @brief Create the renderer with the presents synchronized with the display
+ */
+extern boolean gbVSync;
+
+/**
+ * @var giOffscreenFrames
+ * @brief Frames rendered in offscreen mode before exit (0 uses a window)
+ */
+extern int giOffscreenFrames;
+
+/**
+ * @var gszFrameDumpDir
+ * @brief Directory where the offscreen frames are saved as PNG (empty to
+ * disable)
+ */
+extern char gszFrameDumpDir[_MAX_PATH];
+
 /**
  * @brief ...
  *
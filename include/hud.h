@@ -23,19 +23,24 @@
 #ifndef _HUD_H_
 #define _HUD_H_
 
+#include "glyph.h"
+
+/**
+ * @def HUD_FONT_SIZE
+ * @brief Font size of the HUD texts
+ */
+#define HUD_FONT_SIZE 20
+
 /**
  * @struct STRUCT_HUD
  * @brief Struct that represents a game HUD
  */
 typedef struct STRUCT_HUD {
-  SDL_Surface* pstSurface;
-  SDL_Texture* pstTexture;
+  PSTRUCT_GLYPH_ATLAS pstAtlas;
   SDL_Rect stRect;
   SDL_Rect stTextRect;
-  char szFont[512];
-  int iFontSize;
   SDL_Color stTextColor;
-  char szText[2048];
+  char szText[128];
 } STRUCT_HUD, *PSTRUCT_HUD;
 
 #endif
@@ -26,19 +26,24 @@
 #include "util.h"
 #include "player.h"
 #include "ghost.h"
-#include "audio.h"
+#include "sound.h"
+#include "overlay.h"
 
 /**
  * @def MAP_ROW
- * @brief Max map rows
+ * @brief Max map rows (make MAP_ROW=n overrides it)
  */
-#define MAP_ROW 16
+#ifndef MAP_ROW
+  #define MAP_ROW 16
+#endif
 
 /**
  * @def MAP_COL
- * @brief Max map cols
+ * @brief Max map cols (make MAP_COL=n overrides it)
  */
-#define MAP_COL 16
+#ifndef MAP_COL
+  #define MAP_COL 16
+#endif
 
 /**
  * @def NONE_MOVEMENT
@@ -70,19 +75,6 @@
  */
 #define RIGHT_MOVENT   3
 
-/**
- * @brief Set the coordinates of character in the map
- *
- * @param iX New col
- * @param iY New row
- */
-void vSetCoordinates(int iX, int iY);
-
-/**
- * @brief Update the map with new coordinates
- */
-void vUpdateMap(void);
-
 /**
  * @brief Get the initial player x, y coordinates
  */
@@ -161,22 +153,4 @@ extern int giLevel;
  */
 extern boolean gbGameOver;
 
-/**
- * @var gpstPowerUpSound
- * @brief It's the power up sound
- */
-extern Mix_Chunk* gpstPowerUpSound;
-
-/**
- * @var gpstLevelUpSound
- * @brief It's the level up sound
- */
-extern Mix_Chunk* gpstLevelUpSound;
-
-/**
- * @var gpstGameWinSound
- * @brief It's the game win sound
- */
-extern Mix_Chunk* gpstGameWinSound;
-
 #endif
@@ -0,0 +1,145 @@
+/**
+ * @file mcts.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+
+#ifndef _MCTS_H_
+#define _MCTS_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "state.h"
+
+/**
+ * @def MCTS_DEFAULT_BUDGET_MS
+ * @brief Search time of a decision in ms, a tick is TICK_PERIOD_US
+ */
+#define MCTS_DEFAULT_BUDGET_MS 40
+
+/**
+ * @def MCTS_MAX_THREADS
+ * @brief Searches run in parallel at most, the simulation thread included
+ */
+#define MCTS_MAX_THREADS 64
+
+/**
+ * @def MCTS_MAX_NODES
+ * @brief Nodes of the tree of each search, when full the search only rolls
+ * out from its leaves
+ */
+#define MCTS_MAX_NODES 32768
+
+/**
+ * @def MCTS_HORIZON_TICKS
+ * @brief Ticks played by an iteration, in the tree and rolled out
+ */
+#define MCTS_HORIZON_TICKS 30
+
+/**
+ * @def MCTS_EXPLORATION
+ * @brief Weight of the exploration term of UCB1, low as the values of the
+ * moves are close (a dot is a small part of a full return)
+ */
+#define MCTS_EXPLORATION 0.3
+
+/**
+ * @def MCTS_DISCOUNT
+ * @brief Weight of each tick after the previous one, the sooner the better
+ */
+#define MCTS_DISCOUNT 0.95
+
+/**
+ * @def MCTS_SCORE_SCALE
+ * @brief Points worth a reward of 1
+ */
+#define MCTS_SCORE_SCALE 100.0
+
+/**
+ * @def MCTS_DEATH_PENALTY
+ * @brief Reward of a life lost
+ */
+#define MCTS_DEATH_PENALTY 1.0
+
+/**
+ * @def MCTS_TIME_OUT_PENALTY
+ * @brief Reward of the level time running out, a life lost too
+ */
+#define MCTS_TIME_OUT_PENALTY 1.0
+
+/**
+ * @def MCTS_NEAR_DOT_BONUS
+ * @brief Reward of a dot next to the hero when the iteration stops, divided
+ * by the distance, so the search finds the dots past its horizon
+ */
+#define MCTS_NEAR_DOT_BONUS 0.1
+
+/**
+ * @def MCTS_LEVEL_BONUS
+ * @brief Reward of the last dot of the level
+ */
+#define MCTS_LEVEL_BONUS 2.0
+
+/**
+ * @brief Set the search of the mcts agent, before bInitAgent
+ *
+ * @param iBudgetMs Search time of a decision, 0 MCTS_DEFAULT_BUDGET_MS
+ * @param iThreads Parallel searches, 0 one per CPU
+ */
+void vSetMctsParams(int iBudgetMs, int iThreads);
+
+/**
+ * @brief Start the worker threads of the search, a PFNAGENTINIT
+ *
+ * @param uiSeed Seed of the rollouts
+ * @return TRUE agent ready
+ * @return FALSE no memory for the trees
+ */
+boolean bMctsInit(Uint32 uiSeed);
+
+/**
+ * @brief Search the moves for the budget and take the most visited one, a
+ * PFNAGENTACT
+ *
+ * Each thread grows its own tree from the same state (root parallelism),
+ * their visits are added at the end. The tree keeps the moves, not the
+ * states: each iteration plays them again on a copy of the game with ghosts
+ * drawn from the generator of the thread, the real one is never looked at.
+ *
+ * @param kpstState Game
+ * @return Movement
+ */
+int iMctsAct(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @brief Stop the worker threads and free the trees, a PFNAGENTCLOSE
+ */
+void vMctsClose(void);
+
+/**
+ * @brief Print the rollouts and the ticks simulated by the search and their
+ * rate
+ *
+ * @param fpOut Output file
+ */
+void vPrintMctsStats(FILE* fpOut);
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ * @file overlay.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _OVERLAY_H_
+#define _OVERLAY_H_
+
+#include "util.h"
+
+/**
+ * @def OVERLAY_FONT_SIZE
+ * @brief Font size of the overlay message
+ */
+#define OVERLAY_FONT_SIZE 15
+
+/**
+ * @def OVERLAY_FOOTER_FONT_SIZE
+ * @brief Font size of the overlay footer message
+ */
+#define OVERLAY_FOOTER_FONT_SIZE 10
+
+/**
+ * @def OVERLAY_WAIT_TIMEOUT
+ * @brief Maximum time in ms blocked waiting for an event while an overlay is
+ * shown
+ */
+#define OVERLAY_WAIT_TIMEOUT 250
+
+/**
+ * @typedef PFNOVERLAYCLOSE
+ * @brief Function called when the overlay is dismissed
+ */
+typedef void (*PFNOVERLAYCLOSE)(void);
+
+/**
+ * @brief Create the lock shared by the simulation and the render
+ *
+ * @return TRUE overlay ready
+ * @return FALSE mutex error
+ */
+boolean bInitOverlay(void);
+
+/**
+ * @brief Show a modal message over the game screen
+ *
+ * Only records the message, the overlay is drawn by the frame loop and the
+ * game stays paused until a key is pressed. Called by the simulation.
+ *
+ * @param kpszMsg Message
+ * @param kpszFooterMsg Footer message
+ * @param pfnOnClose Function called by bRunOverlayCallbacks after the overlay
+ * is dismissed (may be NULL)
+ */
+void vShowOverlay(const char* kpszMsg, const char* kpszFooterMsg, PFNOVERLAYCLOSE pfnOnClose);
+
+/**
+ * @brief Check if there is an overlay on the screen
+ *
+ * @return TRUE an overlay is shown
+ * @return FALSE no overlay
+ */
+boolean bOverlayActive(void);
+
+/**
+ * @brief Check if the screen under the overlay must be drawn again
+ *
+ * @return TRUE the frame must be redrawn
+ * @return FALSE the last presented frame is still valid
+ */
+boolean bOverlayDirty(void);
+
+/**
+ * @brief Run the close functions of the overlays dismissed since the last
+ * call, called by the simulation
+ *
+ * @return TRUE some overlay was dismissed
+ * @return FALSE nothing dismissed
+ */
+boolean bRunOverlayCallbacks(void);
+
+/**
+ * @brief Take the count of overlays dismissed since the last call, called by
+ * the simulation at the start of a step
+ *
+ * @return Overlays dismissed
+ */
+int iTakeOverlayDismissals(void);
+
+/**
+ * @brief Dismiss overlays as if a key was pressed, used by the replays
+ *
+ * @param iCount Overlays dismissed
+ */
+void vDismissOverlays(int iCount);
+
+/**
+ * @brief Draw the overlay box over the current frame
+ */
+void vDrawOverlay(void);
+
+/**
+ * @brief Wait for the events while the overlay is shown and dismiss it on key
+ * press
+ */
+void vHandleOverlayEvents(void);
+
+/**
+ * @brief Free the fonts and textures cached by the overlay
+ */
+void vDestroyOverlay(void);
+
+#endif
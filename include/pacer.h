@@ -0,0 +1,122 @@
+/**
+ * @file pacer.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _PACER_H_
+#define _PACER_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+
+/**
+ * @def FRAME_STATS_WINDOW
+ * @brief Quantity of last frames used by the frame time statistics
+ */
+#define FRAME_STATS_WINDOW 1024
+
+/**
+ * @def PACER_SPIN_US
+ * @brief Time in microseconds before the deadline when the hybrid wait stops
+ * sleeping and starts spinning
+ */
+#define PACER_SPIN_US 2000
+
+/**
+ * @enum ENUM_PACING
+ * @brief How the end of the frame is waited
+ */
+typedef enum ENUM_PACING {
+  PACING_HYBRID,   /**< Sleep most of the wait, spin the last PACER_SPIN_US */
+  PACING_VSYNC,    /**< Present waits the display, sleep what is left       */
+  PACING_UNLIMITED /**< No wait at all                                      */
+} ENUM_PACING, *PENUM_PACING;
+
+/**
+ * @struct STRUCT_FRAME_STATS
+ * @brief Frame time statistics of the last FRAME_STATS_WINDOW frames (us)
+ */
+typedef struct STRUCT_FRAME_STATS {
+  int iCtFrames;   /**< Frames in the window    */
+  Uint32 uiAvg;    /**< Average frame time      */
+  Uint32 uiMin;    /**< Minimum frame time      */
+  Uint32 uiMax;    /**< Maximum frame time      */
+  Uint32 uiP50;    /**< 50th percentile         */
+  Uint32 uiP95;    /**< 95th percentile         */
+  Uint32 uiP99;    /**< 99th percentile         */
+} STRUCT_FRAME_STATS, *PSTRUCT_FRAME_STATS;
+
+/**
+ * @brief Parse a pacing name (hybrid, vsync or unlimited)
+ *
+ * @param kpszPacing Pacing name
+ * @param pePacing Receives the pacing
+ * @return TRUE valid name
+ * @return FALSE unknown name
+ */
+boolean bParsePacing(const char* kpszPacing, PENUM_PACING pePacing);
+
+/**
+ * @brief Start the frame pacer
+ *
+ * @param ePacing How the end of the frame is waited
+ * @param iFps Frames per second (period of the frames)
+ */
+void vInitFramePacer(ENUM_PACING ePacing, int iFps);
+
+/**
+ * @brief Mark the beginning of a frame, recording the time of the last one
+ */
+void vBeginFrame(void);
+
+/**
+ * @brief Wait the end of the current frame according to the pacing
+ */
+void vEndFrame(void);
+
+/**
+ * @brief Forget the current frame, used when the loop was blocked waiting
+ * for the user and its time means nothing
+ */
+void vSkipFrame(void);
+
+/**
+ * @brief Get the frame time statistics
+ *
+ * @param pstStats Receives the statistics
+ */
+void vGetFrameStats(PSTRUCT_FRAME_STATS pstStats);
+
+/**
+ * @brief Print the frame time statistics
+ *
+ * @param fpOut Output file
+ */
+void vPrintFrameStats(FILE* fpOut);
+
+/**
+ * @brief Get the performance counter in microseconds
+ *
+ * @return Microseconds since an arbitrary point
+ */
+Uint64 ullGetMicroseconds(void);
+
+#endif
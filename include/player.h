@@ -24,7 +24,7 @@
 #define _PLAYER_H_
 
 #include "entity.h"
-#include "audio.h"
+#include "sound.h"
 
 /**
  * @def HERO_SPRITE_SHEET
@@ -92,10 +92,4 @@ extern STRUCT_PLAYER gstPlayer;
  */
 extern PSTRUCT_SPRITE_SHEET gpstHeartSpriteSheet;
 
-/**
- * @var gpstHeroDeathSound
- * @brief It's the hero death sound
- */
-extern Mix_Chunk* gpstHeroDeathSound;
-
 #endif
@@ -0,0 +1,135 @@
+/**
+ * @file profile.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "gfxstat.h"
+
+/**
+ * @def PROFILE_WINDOW
+ * @brief Quantity of last frames used by the phase statistics
+ */
+#define PROFILE_WINDOW 120
+
+/**
+ * @def PROFILE_FONT_SIZE
+ * @brief Font size of the profiler overlay
+ */
+#define PROFILE_FONT_SIZE 12
+
+/**
+ * @def PROFILE_OVERLAY_LINES
+ * @brief Lines of the overlay: a title and the phases plus the frame, a title
+ * and the render counters
+ */
+#define PROFILE_OVERLAY_LINES (PROFILE_PHASE_COUNT + GFX_COUNTER_COUNT + 3)
+
+/**
+ * @enum ENUM_PROFILE_PHASE
+ * @brief Timed phases of a frame
+ */
+typedef enum ENUM_PROFILE_PHASE {
+  PROFILE_EVENTS,     /**< vHandleEvents         */
+  PROFILE_HERO_MOVE,  /**< vRuleHeroMove         */
+  PROFILE_GHOST_MOVE, /**< vRuleGhostsMove       */
+  PROFILE_DRAW_MAP,   /**< vDrawMap              */
+  PROFILE_DRAW_INFO,  /**< vDrawGameInfo         */
+  PROFILE_PRESENT,    /**< SDL_RenderPresent     */
+  PROFILE_PHASE_COUNT
+} ENUM_PROFILE_PHASE, *PENUM_PROFILE_PHASE;
+
+/**
+ * @struct STRUCT_PROFILE_STATS
+ * @brief Time of a phase in the last PROFILE_WINDOW frames (us)
+ */
+typedef struct STRUCT_PROFILE_STATS {
+  Uint32 uiLast;  /**< Time in the last frame */
+  Uint32 uiAvg;   /**< Average time           */
+  Uint32 uiMax;   /**< Maximum time           */
+} STRUCT_PROFILE_STATS, *PSTRUCT_PROFILE_STATS;
+
+/**
+ * @brief Open the CSV file that receives one row per frame
+ *
+ * @param kpszPath CSV file path
+ * @return TRUE file opened
+ * @return FALSE open error
+ */
+boolean bOpenProfileOutput(const char* kpszPath);
+
+/**
+ * @brief Start timing a phase
+ *
+ * Each phase must be timed by a single thread, the hero and the ghosts moves
+ * may run on the simulation thread.
+ *
+ * @param ePhase Phase
+ */
+void vProfileBegin(ENUM_PROFILE_PHASE ePhase);
+
+/**
+ * @brief Stop timing a phase, the time is added to the current frame
+ *
+ * @param ePhase Phase
+ */
+void vProfileEnd(ENUM_PROFILE_PHASE ePhase);
+
+/**
+ * @brief Close the current frame, updating the statistics, the render
+ * counters and the CSV
+ */
+void vEndProfileFrame(void);
+
+/**
+ * @brief Forget the current frame, used when the loop was blocked waiting
+ * for the user and its time means nothing
+ */
+void vSkipProfileFrame(void);
+
+/**
+ * @brief Get the statistics of a phase
+ *
+ * @param ePhase Phase or PROFILE_PHASE_COUNT for the whole frame
+ * @param pstStats Receives the statistics
+ */
+void vGetProfileStats(ENUM_PROFILE_PHASE ePhase, PSTRUCT_PROFILE_STATS pstStats);
+
+/**
+ * @brief Show or hide the profiler overlay
+ */
+void vToggleProfileOverlay(void);
+
+/**
+ * @brief Draw the profiler overlay over the current frame when it is shown
+ */
+void vDrawProfileOverlay(void);
+
+/**
+ * @brief Close the CSV file
+ */
+void vCloseProfile(void);
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file render.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _RENDER_H_
+#define _RENDER_H_
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "camera.h"
+
+/**
+ * @def CELL_WIDTH
+ * @brief Width of a map cell in logical pixels without zoom
+ */
+#define CELL_WIDTH  (LOGICAL_WIDTH / VIEW_COLS)
+
+/**
+ * @def CELL_HEIGHT
+ * @brief Height of a map cell in logical pixels without zoom
+ */
+#define CELL_HEIGHT (LOGICAL_HEIGHT / VIEW_ROWS)
+
+/**
+ * @def WALL_CHUNK_CELLS
+ * @brief Cols and rows of map cells in a wall chunk texture
+ */
+#define WALL_CHUNK_CELLS 16
+
+/**
+ * @def MAX_WALL_CHUNKS
+ * @brief Wall chunk textures kept, the least recently used is dropped
+ */
+#define MAX_WALL_CHUNKS 64
+
+/**
+ * @brief Drop every prescaled texture, they are rebuilt on the next use
+ *
+ * Called when a level is loaded and when the render scale or the zoom
+ * changes.
+ */
+void vInvalidateRenderCache(void);
+
+/**
+ * @brief Free every prescaled texture
+ */
+void vDestroyRenderCache(void);
+
+/**
+ * @brief Get the texture with the walls of a chunk of the map
+ *
+ * @param aszMap Map the chunk is built from when it is not cached
+ * @param iChunkRow Row of the chunk (map row / WALL_CHUNK_CELLS)
+ * @param iChunkCol Col of the chunk (map col / WALL_CHUNK_CELLS)
+ * @return Texture covering the cells of the chunk or NULL on error
+ */
+SDL_Texture* pstGetWallChunk(char aszMap[MAP_ROW][MAP_COL], int iChunkRow, int iChunkCol);
+
+/**
+ * @brief Get the texture of the minimap, one texel per cell with the walls
+ *
+ * @param aszMap Map the minimap is built from when it is not cached
+ * @return The texture or NULL on error
+ */
+SDL_Texture* pstGetMinimap(char aszMap[MAP_ROW][MAP_COL]);
+
+/**
+ * @brief Get the texture of a dot, covering a whole cell at the current zoom
+ *
+ * @return The texture or NULL on error
+ */
+SDL_Texture* pstGetDotTexture(void);
+
+/**
+ * @brief Get the texture of a power, covering a whole cell
+ *
+ * @return The texture or NULL on error
+ */
+SDL_Texture* pstGetPowerTexture(void);
+
+#endif
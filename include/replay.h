@@ -0,0 +1,195 @@
+/**
+ * @file replay.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+
+/**
+ * @def REPLAY_MAGIC
+ * @brief First bytes of a replay file (with the terminator)
+ */
+#define REPLAY_MAGIC "PPREPLY"
+
+/**
+ * @def REPLAY_VERSION
+ * @brief Version of the replay format
+ */
+#define REPLAY_VERSION 2
+
+/**
+ * @def REPLAY_MAX_STEPS
+ * @brief Maximum steps loaded from a replay (2 bytes each)
+ */
+#define REPLAY_MAX_STEPS (16L * 1024L * 1024L)
+
+/**
+ * @def REPLAY_FLUSH_STEPS
+ * @brief Steps recorded between two flushes of the recording, so a crash
+ *        loses at most that many steps
+ */
+#define REPLAY_FLUSH_STEPS 64
+
+/*
+ * Replay file, integers in little endian:
+ *
+ * header: REPLAY_MAGIC (8 bytes), Uint8 version, Uint32 seed, Uint32 hash
+ *         of the level files, Uint16 length and the bytes of the level dir
+ * step:   Uint8 flags, Uint8 overlays dismissed before the step
+ *
+ * A step is written for each vSimStep that changed the game. Flags: bit 0
+ * the step ran a tick, bits 1-3 the move posted (0 none, direction + 1),
+ * bits 4-5 the pauses posted (0 none, 1 odd count, 2 even count). The ticks
+ * are the clock of the replay, TICK_PERIOD_US apart.
+ */
+
+/**
+ * @enum ENUM_REPLAY_MODE
+ * @brief What the replay module does with the simulation steps
+ */
+typedef enum ENUM_REPLAY_MODE {
+  REPLAY_OFF,     /**< Live game, nothing recorded     */
+  REPLAY_RECORD,  /**< Live game, steps recorded       */
+  REPLAY_PLAY     /**< Steps read from a replay file   */
+} ENUM_REPLAY_MODE, *PENUM_REPLAY_MODE;
+
+/**
+ * @struct STRUCT_REPLAY_HEADER
+ * @brief What a replay needs besides the steps to play the same game
+ */
+typedef struct STRUCT_REPLAY_HEADER {
+  Uint32 uiSeed;              /**< Seed of the random generator */
+  Uint32 uiLevelHash;         /**< uiHashLevelSet of the levels */
+  char szLevelDir[_MAX_PATH]; /**< Level dir of the recording   */
+} STRUCT_REPLAY_HEADER, *PSTRUCT_REPLAY_HEADER;
+
+/**
+ * @struct STRUCT_REPLAY_STEP
+ * @brief Inputs of a simulation step
+ */
+typedef struct STRUCT_REPLAY_STEP {
+  boolean bTick;    /**< The step ran a tick                 */
+  int iMove;        /**< Move posted, 0 none or direction+1  */
+  int iPause;       /**< Pauses posted                       */
+  int iDismissed;   /**< Overlays dismissed before the step  */
+} STRUCT_REPLAY_STEP, *PSTRUCT_REPLAY_STEP;
+
+/**
+ * @brief Hash the level files, a replay only matches the levels it was
+ * recorded with
+ *
+ * @param kpszLevelDir Level dir
+ * @return ullHashBytes of the files folded to 32 bits, missing files count
+ * as empty
+ */
+Uint32 uiHashLevelSet(const char* kpszLevelDir);
+
+/**
+ * @brief Create a replay file and record the next steps in it
+ *
+ * @param kpszPath Replay file path
+ * @param pstHeader Seed, level hash and dir of the game
+ * @return TRUE recording
+ * @return FALSE open error
+ */
+boolean bStartRecording(const char* kpszPath, PSTRUCT_REPLAY_HEADER pstHeader);
+
+/**
+ * @brief Load a replay file, the next steps are read from it
+ *
+ * @param kpszPath Replay file path
+ * @param pstHeader Receives the header
+ * @return TRUE replay loaded
+ * @return FALSE open or format error
+ */
+boolean bLoadReplay(const char* kpszPath, PSTRUCT_REPLAY_HEADER pstHeader);
+
+/**
+ * @brief Get the replay mode
+ *
+ * @return The mode
+ */
+ENUM_REPLAY_MODE eGetReplayMode(void);
+
+/**
+ * @brief Parse a replay speed (normal or max)
+ *
+ * @param kpszSpeed Speed name
+ * @param pbMax Receives TRUE for max
+ * @return TRUE valid name
+ * @return FALSE unknown name
+ */
+boolean bParseReplaySpeed(const char* kpszSpeed, boolean* pbMax);
+
+/**
+ * @brief Play the ticks as fast as possible instead of on the game clock
+ *
+ * @param bMax Max speed
+ */
+void vSetReplayMaxSpeed(boolean bMax);
+
+/**
+ * @brief Check if the ticks are played as fast as possible
+ *
+ * @return TRUE max speed
+ * @return FALSE game clock
+ */
+boolean bReplayMaxSpeed(void);
+
+/**
+ * @brief Get the next step of the replay without consuming it
+ *
+ * @param pstStep Receives the step
+ * @return TRUE step read
+ * @return FALSE end of the replay
+ */
+boolean bPeekReplayStep(PSTRUCT_REPLAY_STEP pstStep);
+
+/**
+ * @brief Consume the step returned by bPeekReplayStep
+ */
+void vNextReplayStep(void);
+
+/**
+ * @brief Record a step
+ *
+ * @param pstStep Step
+ */
+void vRecordStep(PSTRUCT_REPLAY_STEP pstStep);
+
+/**
+ * @brief Print the steps and ticks recorded or played
+ *
+ * @param fpOut Output file
+ * @param ullElapsed Time taken (us)
+ */
+void vPrintReplayStats(FILE* fpOut, Uint64 ullElapsed);
+
+/**
+ * @brief Close the replay file and free the loaded steps
+ */
+void vCloseReplay(void);
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file rewind.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _REWIND_H_
+#define _REWIND_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "gui.h"
+#include "state.h"
+
+/**
+ * @def REWIND_SECONDS
+ * @brief Game time kept in the rewind history
+ */
+#define REWIND_SECONDS 300
+
+/**
+ * @def REWIND_MAX_TICKS
+ * @brief Ticks kept in the rewind history
+ */
+#define REWIND_MAX_TICKS (REWIND_SECONDS * FPS)
+
+/**
+ * @def REWIND_KEYFRAME_TICKS
+ * @brief Ticks between two full states, the others are deltas
+ */
+#define REWIND_KEYFRAME_TICKS 16
+
+/**
+ * @def REWIND_BUFFER_BYTES
+ * @brief Memory of the encoded history, the oldest ticks are dropped first.
+ * Always room for a worst case record, whatever the map size
+ */
+#define REWIND_BUFFER_BYTES (256 * 1024 + 2 * sizeof(STRUCT_GAME_STATE) + 2)
+
+/**
+ * @brief Forget the whole history, called when a level starts and when a
+ * state is restored. The next tick pushed is the base of the keyframes
+ */
+void vResetRewind(void);
+
+/**
+ * @brief Add the game after a tick to the history, called by the simulation
+ *
+ * Every REWIND_KEYFRAME_TICKS the state is kept as the run length coded XOR
+ * against the first tick after the reset, the other ticks against the
+ * previous tick.
+ */
+void vPushRewindTick(void);
+
+/**
+ * @brief Hold or release the rewind, called by the event handler
+ *
+ * @param bHeld TRUE while the key is down
+ */
+void vPostRewind(boolean bHeld);
+
+/**
+ * @brief Check if the rewind key is held
+ *
+ * @return TRUE rewinding
+ * @return FALSE playing
+ */
+boolean bRewindHeld(void);
+
+/**
+ * @brief Go back one tick, called by the simulation on its ticks while the
+ * rewind is held
+ *
+ * @return TRUE game restored to the previous tick
+ * @return FALSE history empty
+ */
+boolean bRewindTick(void);
+
+/**
+ * @brief Get the ticks kept in the history
+ *
+ * @return Ticks
+ */
+int iGetRewindTicks(void);
+
+/**
+ * @brief Decode a past tick without touching the game, to look at what the
+ * ghosts did
+ *
+ * @param iTicksAgo 0 is the last tick pushed
+ * @param pstState Receives the state
+ * @return TRUE state decoded
+ * @return FALSE the tick is not in the history
+ */
+boolean bGetRewindState(int iTicksAgo, PSTRUCT_GAME_STATE pstState);
+
+/**
+ * @brief Print the ticks and the memory of the history
+ *
+ * @param fpOut Output file
+ */
+void vPrintRewindStats(FILE* fpOut);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file rng.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _RNG_H_
+#define _RNG_H_
+
+#include <SDL2/SDL.h>
+
+/**
+ * @def RNG_DEFAULT_SEED
+ * @brief Seed used in place of 0, which xorshift can't leave
+ */
+#define RNG_DEFAULT_SEED 0x9E3779B9u
+
+/**
+ * @brief Seed the game random generator (xorshift32)
+ *
+ * The generator only belongs to the simulation, the same seed and inputs
+ * give the same game on every platform.
+ *
+ * @param uiSeed Seed, 0 is replaced by RNG_DEFAULT_SEED
+ */
+void vSeedRandom(Uint32 uiSeed);
+
+/**
+ * @brief Get a seed for a new game from the clocks
+ *
+ * @return Seed, never 0
+ */
+Uint32 uiNewRandomSeed(void);
+
+/**
+ * @brief Get the state of the generator, saved with the game
+ *
+ * @return State, never 0
+ */
+Uint32 uiGetRandomState(void);
+
+/**
+ * @brief Put back a state returned by uiGetRandomState
+ *
+ * @param uiState State
+ */
+void vSetRandomState(Uint32 uiState);
+
+/**
+ * @brief Get the next random number
+ *
+ * @return Number in [0, 2^32-1]
+ */
+Uint32 uiRandom(void);
+
+/**
+ * @brief Get a random number below a bound
+ *
+ * @param iBound Bound, greater than 0
+ * @return Number in [0, iBound-1]
+ */
+int iRandomBelow(int iBound);
+
+/**
+ * @brief Step a private generator, for the code outside the simulation
+ * (agents) that must not change the game sequence
+ *
+ * @param puiState State of the generator, never 0
+ * @return Number in [1, 2^32-1]
+ */
+Uint32 uiRandomFrom(Uint32* puiState);
+
+/**
+ * @brief Get a random number below a bound from a private generator
+ *
+ * @param puiState State of the generator, never 0
+ * @param iBound Bound, greater than 0
+ * @return Number in [0, iBound-1]
+ */
+int iRandomBelowFrom(Uint32* puiState, int iBound);
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file rules.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _RULES_H_
+#define _RULES_H_
+
+#include "util.h"
+#include "state.h"
+
+/**
+ * @struct STRUCT_RULE_EVENTS
+ * @brief What a move did besides changing the state, the game plays the
+ * sounds and shows the messages
+ */
+typedef struct STRUCT_RULE_EVENTS {
+  int iHeroDeaths;       /**< Lives lost                            */
+  int iGhostDeaths;      /**< Ghosts killed with a power            */
+  int iPowersUp;         /**< Powers eaten                          */
+  boolean bPowerMessage; /**< First power of the game, a message    */
+} STRUCT_RULE_EVENTS, *PSTRUCT_RULE_EVENTS;
+
+/**
+ * @struct STRUCT_RULE_VIEW
+ * @brief What the rules change: the map and the entities where they live, the
+ * counters and flags by value. The simulation points it at the game, the
+ * searches at their copies, nothing big is copied on a tick
+ */
+typedef struct STRUCT_RULE_VIEW {
+  char (*paszMap)[MAP_COL];      /**< Map of MAP_ROW rows                */
+  PSTRUCT_ENTITY pstHero;        /**< Hero                               */
+  PSTRUCT_ENTITY pastGhost;      /**< MAX_GHOSTS ghosts                  */
+  int iCurrentLevelScore;        /**< Points of the level                */
+  int iTotalCurrentLevelScore;   /**< Points of all the level dots       */
+  int iTotalGameScore;           /**< Points of the finished levels      */
+  int iCurrentLevelTime;         /**< Level time left                    */
+  int iPowersCollected;          /**< Powers held                        */
+  boolean bGameOver;             /**< No life left                       */
+  boolean bTimeOut;              /**< Level time over                    */
+  boolean bHeroEndMap;           /**< Hero in a tunnel                   */
+  boolean bGhostEndMap;          /**< Ghost in a tunnel                  */
+  boolean bShowPowerMessage;     /**< First power not eaten yet          */
+  Uint32 uiRandomState;          /**< Generator of the ghosts            */
+} STRUCT_RULE_VIEW, *PSTRUCT_RULE_VIEW;
+
+/**
+ * @brief Point a view at a state
+ *
+ * @param pstState Game, its map and entities are changed through the view
+ * @param pstView Receives the view
+ */
+void vGetStateView(PSTRUCT_GAME_STATE pstState, PSTRUCT_RULE_VIEW pstView);
+
+/**
+ * @brief Write the counters and flags of a view back to its state
+ *
+ * @param kpstView View
+ * @param pstState Game the view points at
+ */
+void vPutStateView(const STRUCT_RULE_VIEW* kpstView, PSTRUCT_GAME_STATE pstState);
+
+/**
+ * @brief Move the hero one cell in its direction
+ *
+ * The rules of the game, they only change the view so the simulation and
+ * the searches of the agents play the same game on their own copies.
+ *
+ * @param pstView Game
+ * @param pstEvents Events added to
+ */
+void vRuleHeroMove(PSTRUCT_RULE_VIEW pstView, PSTRUCT_RULE_EVENTS pstEvents);
+
+/**
+ * @brief Move each living ghost one cell in a random direction, drawn from
+ * the generator of the view
+ *
+ * @param pstView Game
+ * @param pstEvents Events added to
+ */
+void vRuleGhostsMove(PSTRUCT_RULE_VIEW pstView, PSTRUCT_RULE_EVENTS pstEvents);
+
+/**
+ * @brief Check if the level ended in a state
+ *
+ * @param kpstState Game
+ * @return TRUE game over, time out or no dot left
+ * @return FALSE the level goes on
+ */
+boolean bGameStateEnded(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @brief Run a whole tick on a copy of the game, as vUpdateGame without the
+ * messages (they are dismissed at once)
+ *
+ * @param pstState Game
+ * @param iMove Move posted before the tick or NONE_MOVEMENT
+ * @param pstEvents Events added to
+ */
+void vStepGameState(PSTRUCT_GAME_STATE pstState, int iMove, PSTRUCT_RULE_EVENTS pstEvents);
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file sim.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _SIM_H_
+#define _SIM_H_
+
+#include "util.h"
+#include "replay.h"
+
+/**
+ * @def SIM_MAX_WAIT_MS
+ * @brief Maximum time the simulation thread sleeps without checking gbRun
+ */
+#define SIM_MAX_WAIT_MS 100
+
+/**
+ * @brief Ask the hero to move, applied by the simulation on its next step
+ *
+ * @param iDirection Movement direction
+ */
+void vPostMove(int iDirection);
+
+/**
+ * @brief Ask the simulation to toggle the pause
+ */
+void vPostPause(void);
+
+/**
+ * @brief Apply the inputs posted since the last call (simulation side)
+ *
+ * A replay applies the inputs of its step instead, the keys are dropped.
+ *
+ * @param pstStep Step, receives the inputs applied
+ * @return TRUE some input was applied
+ * @return FALSE no input
+ */
+boolean bApplyInput(PSTRUCT_REPLAY_STEP pstStep);
+
+/**
+ * @brief Run the simulation in its own thread
+ *
+ * @return TRUE thread running
+ * @return FALSE thread error, the caller runs vSimStep itself
+ */
+boolean bStartSimThread(void);
+
+/**
+ * @brief Wake the simulation thread up before its next tick
+ */
+void vWakeSimThread(void);
+
+/**
+ * @brief Wait the simulation thread to finish, gbRun must be FALSE
+ */
+void vStopSimThread(void);
+
+/**
+ * @brief Check if the simulation runs in its own thread
+ *
+ * @return TRUE simulation thread running
+ * @return FALSE the main loop runs the simulation
+ */
+boolean bSimThreaded(void);
+
+#endif
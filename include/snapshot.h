@@ -0,0 +1,83 @@
+/**
+ * @file snapshot.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#include <SDL2/SDL.h>
+#include "map.h"
+
+/**
+ * @def SNAPSHOT_ENTITIES
+ * @brief Entities in a snapshot, the hero followed by the ghosts
+ */
+#define SNAPSHOT_ENTITIES (MAX_GHOSTS + 1)
+
+/**
+ * @struct STRUCT_SNAPSHOT
+ * @brief Everything the render needs from a simulation tick
+ */
+typedef struct STRUCT_SNAPSHOT {
+  char aszMap[MAP_ROW][MAP_COL];                /**< Map of the level               */
+  STRUCT_ENTITY astEntity[SNAPSHOT_ENTITIES];   /**< Hero and ghosts                */
+  int iLevel;                                   /**< Current level                  */
+  int iCurrentLevelScore;                       /**< Score of the level             */
+  int iTotalGameScore;                          /**< Score of the game              */
+  int iCurrentLevelTime;                        /**< Level time left                */
+  int iPowersCollected;                         /**< Powers not used yet            */
+  Uint32 uiLevelSerial;                         /**< Changes when a level is loaded */
+  Uint64 ullNextTick;                           /**< Game clock of the next tick    */
+} STRUCT_SNAPSHOT, *PSTRUCT_SNAPSHOT;
+
+/**
+ * @brief Clear the snapshots, called before the simulation starts
+ *
+ * The render may read a snapshot before the first publish, it then reads
+ * zeros.
+ */
+void vInitSnapshots(void);
+
+/**
+ * @brief Get the snapshot the simulation fills before publishing it
+ *
+ * Only the simulation side may call it.
+ *
+ * @return Snapshot owned by the simulation until vPublishSnapshot
+ */
+PSTRUCT_SNAPSHOT pstBeginSnapshot(void);
+
+/**
+ * @brief Hand the snapshot filled after pstBeginSnapshot to the render side
+ */
+void vPublishSnapshot(void);
+
+/**
+ * @brief Get the newest published snapshot
+ *
+ * Only the render side may call it, the snapshot stays valid until the next
+ * call.
+ *
+ * @return Newest snapshot (all zeros before the first publish)
+ */
+PSTRUCT_SNAPSHOT pstAcquireSnapshot(void);
+
+#endif
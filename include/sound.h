@@ -0,0 +1,104 @@
+/**
+ * @file sound.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _SOUND_H_
+#define _SOUND_H_
+
+#include <SDL2/SDL.h>
+#include "util.h"
+#include <stdio.h>
+#include "audio.h"
+
+/**
+ * @def SOUND_CHANNELS
+ * @brief Mixer channels shared by the sound effects
+ */
+#define SOUND_CHANNELS 8
+
+/**
+ * @enum ENUM_SOUND
+ * @brief Sound effects of the game
+ */
+typedef enum ENUM_SOUND {
+  SOUND_POWER_UP,    /**< Hero ate a power      */
+  SOUND_LEVEL_UP,    /**< Level finished        */
+  SOUND_GAME_WIN,    /**< Last level finished   */
+  SOUND_HERO_DEATH,  /**< Hero caught by a ghost */
+  SOUND_GHOST_DEATH, /**< Ghost eaten            */
+  SOUND_GAME_OVER,   /**< No lives or no time    */
+  SOUND_COUNT
+} ENUM_SOUND, *PENUM_SOUND;
+
+/**
+ * @brief Allocate the mixer channels and watch when they finish, called after
+ * the mixer is opened
+ */
+void vInitSounds(void);
+
+/**
+ * @brief Give the chunk of a sound effect to the sound queue, which frees it
+ * in vDestroySounds
+ *
+ * @param eSound Sound effect
+ * @param pstChunk Decoded chunk (may be NULL, the sound is then muted)
+ */
+void vSetSound(ENUM_SOUND eSound, Mix_Chunk* pstChunk);
+
+/**
+ * @brief Queue a sound effect, called by the simulation from any thread
+ *
+ * Returns at once with the null audio backend. Nothing is played here: the
+ * requests of the same sound are merged into one until the next
+ * vFlushSounds, which plays it.
+ *
+ * @param eSound Sound effect
+ */
+void vQueueSound(ENUM_SOUND eSound);
+
+/**
+ * @brief Play the queued sound effects, called once per frame by the render
+ *
+ * A sound is dropped when it played less than its coalescing window ago or
+ * when all its voices are busy. With no free channel, the sound with the
+ * lowest priority below its own is cut.
+ */
+void vFlushSounds(void);
+
+/**
+ * @brief Measure the time from vQueueSound to the first audio callback that
+ * mixes the sound, called before vInitSounds
+ */
+void vEnableSoundLatencyTest(void);
+
+/**
+ * @brief Print the latency measured since vEnableSoundLatencyTest
+ *
+ * @param fpOut Output file
+ */
+void vPrintSoundLatency(FILE* fpOut);
+
+/**
+ * @brief Halt the sound effects and free their chunks
+ */
+void vDestroySounds(void);
+
+#endif
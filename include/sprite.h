@@ -56,6 +56,23 @@ PSTRUCT_SPRITE_SHEET pstLoadSpriteSheet(
   int iTotalSprites,
   int iCols);
 
+/**
+ * @brief Create a sprite sheet from a texture already loaded
+ *
+ * @param pstTexture Texture of the sheet, owned by the sprite sheet
+ * @param iWidth Width of the sprite
+ * @param iHeight Height of the sprite
+ * @param iTotalSprites Total sprites in the sheet
+ * @param iCols Total cols in the sprite sheet
+ * @return Pointer to a sprite sheet or NULL on error (the texture is freed)
+ */
+PSTRUCT_SPRITE_SHEET pstCreateSpriteSheet(
+  SDL_Texture* pstTexture,
+  int iWidth,
+  int iHeight,
+  int iTotalSprites,
+  int iCols);
+
 /**
  * @brief Free sprite sheet loaded with pstLoadSpriteSheet
  *
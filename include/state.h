@@ -0,0 +1,145 @@
+/**
+ * @file state.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _STATE_H_
+#define _STATE_H_
+
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "map.h"
+
+/**
+ * @def STATE_MAGIC
+ * @brief First word of a game state ("PPST")
+ */
+#define STATE_MAGIC 0x50505354u
+
+/**
+ * @def STATE_VERSION
+ * @brief Version of STRUCT_GAME_STATE, changed with its fields
+ */
+#define STATE_VERSION 2
+
+/**
+ * @def STATE_ENTITIES
+ * @brief Entities in a state, the hero first
+ */
+#define STATE_ENTITIES (MAX_GHOSTS + 1)
+
+/**
+ * @struct STRUCT_GAME_STATE
+ * @brief The whole game in a fixed size blob without pointers
+ *
+ * Saving and restoring are plain copies, the blob can be cloned with memcpy
+ * and compared with memcmp (the padding is zeroed). Written to a file it
+ * keeps the byte order of the machine, like the binary trace.
+ */
+typedef struct STRUCT_GAME_STATE {
+  Uint32 uiMagic;                               /**< STATE_MAGIC                    */
+  Uint16 usVersion;                             /**< STATE_VERSION                  */
+  Uint32 uiMapRows;                             /**< MAP_ROW of the build           */
+  Uint32 uiMapCols;                             /**< MAP_COL of the build           */
+  char aszMap[MAP_ROW][MAP_COL];                /**< gszMap                         */
+  STRUCT_ENTITY astEntity[STATE_ENTITIES];      /**< gstPlayer and gastGhost        */
+  int iStatus;                                  /**< geStatus                       */
+  int iLevel;                                   /**< giLevel                        */
+  int iCurrentLevelScore;                       /**< giCurrentLevelScore            */
+  int iTotalCurrentLevelScore;                  /**< giTotalCurrentLevelScore       */
+  int iTotalGameScore;                          /**< giTotalGameScore               */
+  int iCurrentLevelTime;                        /**< giCurrentLevelTime             */
+  int iPowersCollected;                         /**< giPowersCollected              */
+  Uint8 ucGameOver;                             /**< gbGameOver                     */
+  Uint8 ucTimeOut;                              /**< gbTimeOut                      */
+  Uint8 ucHeroEndMap;                           /**< gbHeroEndMap                   */
+  Uint8 ucGhostEndMap;                          /**< gbGhostEndMap                  */
+  Uint8 ucShowPowerMessage;                     /**< gbShowPowerMessage             */
+  Uint32 uiRandomState;                         /**< State of the random generator  */
+} STRUCT_GAME_STATE, *PSTRUCT_GAME_STATE;
+
+/**
+ * @brief Copy the game to a state
+ *
+ * @param pstState Receives the state
+ */
+void vSaveGameState(PSTRUCT_GAME_STATE pstState);
+
+/**
+ * @brief Put back a state saved by vSaveGameState, called by the simulation
+ *
+ * Only copies, no file is read. The snapshot is published again, the render
+ * cache is dropped only when the level changes.
+ *
+ * @param kpstState State
+ * @return TRUE state restored
+ * @return FALSE magic, version or map size of another build
+ */
+boolean bRestoreGameState(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @brief Copy a state to the game without checking it nor publishing the
+ * snapshot, used after the rules ran on a copy of the game
+ *
+ * @param kpstState State
+ */
+void vApplyGameState(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @brief Ask the simulation to keep the game in the quick save slot
+ */
+void vPostQuickSave(void);
+
+/**
+ * @brief Ask the simulation to put back the quick save slot
+ */
+void vPostQuickLoad(void);
+
+/**
+ * @brief Apply the quick save and load posted since the last call, called by
+ * the simulation
+ *
+ * Dropped while an overlay is shown (the overlays are not in the state) and
+ * during record and replay (the replay would not match).
+ *
+ * @return TRUE the game was restored
+ * @return FALSE nothing restored
+ */
+boolean bApplyQuickState(void);
+
+/**
+ * @brief Write the current game to a file
+ *
+ * @param kpszPath File path
+ * @return TRUE saved
+ * @return FALSE write error
+ */
+boolean bSaveGameFile(const char* kpszPath);
+
+/**
+ * @brief Restore the game from a file written by bSaveGameFile
+ *
+ * @param kpszPath File path
+ * @return TRUE restored
+ * @return FALSE read error or state of another build
+ */
+boolean bLoadGameFile(const char* kpszPath);
+
+#endif
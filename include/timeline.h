@@ -0,0 +1,91 @@
+/**
+ * @file timeline.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#ifndef _TIMELINE_H_
+#define _TIMELINE_H_
+
+#include <SDL2/SDL.h>
+#include "util.h"
+
+/**
+ * @def TIMELINE_PID
+ * @brief Process id written in the events, the file has a single process
+ */
+#define TIMELINE_PID 1
+
+/**
+ * @brief Open the trace event file (Chrome/Perfetto JSON)
+ *
+ * The spans are written as they happen, one line per event, and the file is
+ * only valid JSON after vCloseTimeline. Without an open file every call below
+ * returns at once.
+ *
+ * @param kpszPath JSON file path
+ * @return TRUE file opened
+ * @return FALSE open error
+ */
+boolean bOpenTimeline(const char* kpszPath);
+
+/**
+ * @brief Name the calling thread in the timeline
+ *
+ * @param kpszName Thread name
+ */
+void vTimelineThreadName(const char* kpszName);
+
+/**
+ * @brief Begin a span on the calling thread
+ *
+ * @param kpszName Span name
+ */
+void vTimelineBegin(const char* kpszName);
+
+/**
+ * @brief End the last span begun on the calling thread
+ *
+ * @param kpszName Span name
+ */
+void vTimelineEnd(const char* kpszName);
+
+/**
+ * @brief Begin a span that may end on another thread
+ *
+ * @param kpszName Span name
+ * @param ulId Id shared by the begin and the end of the span
+ */
+void vTimelineAsyncBegin(const char* kpszName, unsigned long ulId);
+
+/**
+ * @brief End a span begun by vTimelineAsyncBegin
+ *
+ * @param kpszName Span name
+ * @param ulId Id given to vTimelineAsyncBegin
+ */
+void vTimelineAsyncEnd(const char* kpszName, unsigned long ulId);
+
+/**
+ * @brief Finish the JSON and close the file, called once the other threads
+ * have stopped
+ */
+void vCloseTimeline(void);
+
+#endif
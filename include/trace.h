@@ -30,76 +30,204 @@
 #include <stdarg.h>
 #include <string.h>
 
+/**
+ * @def TRACE_LEVEL
+ * @brief Highest debug level compiled in (make TRACE_LEVEL=n). The call sites
+ * of the levels above it are constant false and removed by the compiler
+ */
+#ifndef TRACE_LEVEL
+  #define TRACE_LEVEL 9
+#endif
+
 /**
  * @def DEBUG_INFO
  * @brief Trace info debug messages
  */
-#define DEBUG_INFO         gstTracePrm.szDebugLevel[0] > '0'
+#define DEBUG_INFO         (TRACE_LEVEL >= 1 && gstTracePrm.iLevel >= 1)
 
 /**
  * @def DEBUG_WARNING
  * @brief Trace warning debug messages
  */
-#define DEBUG_WARNING      gstTracePrm.szDebugLevel[0] > '1'
+#define DEBUG_WARNING      (TRACE_LEVEL >= 2 && gstTracePrm.iLevel >= 2)
 
 /**
  * @def DEBUG_ERROR
  * @brief Trace error debug messages
  */
-#define DEBUG_ERROR        gstTracePrm.szDebugLevel[0] > '2'
+#define DEBUG_ERROR        (TRACE_LEVEL >= 3 && gstTracePrm.iLevel >= 3)
 
 /**
  * @def DEBUG_FATAL
  * @brief Trace fatal debug messages
  */
-#define DEBUG_FATAL        gstTracePrm.szDebugLevel[0] > '3'
+#define DEBUG_FATAL        (TRACE_LEVEL >= 4 && gstTracePrm.iLevel >= 4)
 
 /**
  * @def DEBUG_DETAILS
  * @brief Trace debug details messages
  */
-#define DEBUG_DETAILS      gstTracePrm.szDebugLevel[0] > '4'
+#define DEBUG_DETAILS      (TRACE_LEVEL >= 5 && gstTracePrm.iLevel >= 5)
 
 /**
  * @def DEBUG_TRACE
  * @brief Trace debug messages
  */
-#define DEBUG_TRACE        gstTracePrm.szDebugLevel[0] > '5'
+#define DEBUG_TRACE        (TRACE_LEVEL >= 6 && gstTracePrm.iLevel >= 6)
 
 /**
  * @def DEBUG_MORE_DETAILS
  * @brief Trace debug more details messages
  */
-#define DEBUG_MORE_DETAILS gstTracePrm.szDebugLevel[0] > '6'
+#define DEBUG_MORE_DETAILS (TRACE_LEVEL >= 7 && gstTracePrm.iLevel >= 7)
 
 /**
  * @def DEBUG_VERBOSE
  * @brief Trace debug verbose messages
  */
-#define DEBUG_VERBOSE      gstTracePrm.szDebugLevel[0] > '7'
+#define DEBUG_VERBOSE      (TRACE_LEVEL >= 8 && gstTracePrm.iLevel >= 8)
 
 /**
  * @def DEBUG_ALL
  * @brief Trace all debug messages
  */
-#define DEBUG_ALL          gstTracePrm.szDebugLevel[0] > '8'
+#define DEBUG_ALL          (TRACE_LEVEL >= 9 && gstTracePrm.iLevel >= 9)
+
+/**
+ * @def TRACE_RING_SLOTS
+ * @brief Lines waiting to be written, a power of two
+ */
+#define TRACE_RING_SLOTS 1024
+
+/**
+ * @def TRACE_LINE_MAX
+ * @brief Longest line kept by the ring, longer ones are truncated
+ */
+#define TRACE_LINE_MAX 512
+
+/**
+ * @def TRACE_FORMAT_MAX
+ * @brief Size of the buffer a line is formatted in before being truncated
+ */
+#define TRACE_FORMAT_MAX 4096
+
+/**
+ * @def TRACE_FLUSH_MS
+ * @brief Longest wait of the flush thread, it is woken earlier when the ring
+ * is half full
+ */
+#define TRACE_FLUSH_MS 50
+
+/**
+ * @def TRACE_WRITE_SIZE
+ * @brief Bytes gathered by the flush thread before each write
+ */
+#define TRACE_WRITE_SIZE 65536
+
+/**
+ * @def TRACE_MAX_FORMATS
+ * @brief Format strings registered by the binary trace, a power of two
+ */
+#define TRACE_MAX_FORMATS 512
+
+/*
+ * Binary trace, native byte order, no padding:
+ *
+ * header: TRACE_MAGIC (8 bytes), Uint32 0x01020304, Uint32 version, Uint32
+ *         low and high words of the time_t of the start
+ * format: Uint8 TRACE_RECORD_FORMAT, Uint16 id, Uint16 length, the string
+ * event:  Uint8 TRACE_RECORD_EVENT, Uint16 id, Uint32 low and high words of
+ *         the microseconds since the start, Uint16 length, the arguments
+ *
+ * The arguments follow the conversions of the format: 4 bytes for int, 8 for
+ * long, double and pointer (low word first for the integers) and Uint16
+ * length plus the bytes for strings. An event may be cut short when it does
+ * not fit TRACE_LINE_MAX. A format may appear after its first event.
+ */
+
+/**
+ * @def TRACE_MAGIC
+ * @brief First bytes of a binary trace file (with the terminator)
+ */
+#define TRACE_MAGIC "PPTRACE"
+
+/**
+ * @def TRACE_BINARY_VERSION
+ * @brief Version of the binary trace records
+ */
+#define TRACE_BINARY_VERSION 1
+
+/**
+ * @def TRACE_RECORD_FORMAT
+ * @brief Record registering a format string
+ */
+#define TRACE_RECORD_FORMAT 1
+
+/**
+ * @def TRACE_RECORD_EVENT
+ * @brief Record of a vTrace call
+ */
+#define TRACE_RECORD_EVENT 2
+
+/**
+ * @def TRACE_TEXT_ID
+ * @brief Event id of the lines formatted as text because the format table was
+ * full, the only argument is the line
+ */
+#define TRACE_TEXT_ID 0xFFFF
 
 typedef struct STRUCT_TRACE_PRM {
   char szTrace[256];
   char szDebugLevel[32];
+  int iLevel;         /**< szDebugLevel parsed by vInitTrace, 0 off */
+  long lMaxSize;      /**< Rotation size in bytes, 0 never rotates */
+  int bBinary;        /**< Binary records instead of text lines    */
 } STRUCT_TRACE_PRM, *PSTRUCT_TRACE_PRM;
 
 extern STRUCT_TRACE_PRM gstTracePrm;
 
+/**
+ * @brief Open the trace file and start the flush thread
+ *
+ * The trace is flushed and closed at exit.
+ *
+ * @param kpszTrace Trace file path
+ * @param kpszDebugLevel Debug level
+ */
 void vInitTrace(const char *kpszTrace, const char *kpszDebugLevel);
 
+/**
+ * @brief Set the size that rotates the trace file, the old one is renamed
+ * with the ".1" suffix. Called before vInitTrace
+ *
+ * @param lMaxSize Size in bytes, 0 never rotates
+ */
+void vSetTraceMaxSize(long lMaxSize);
+
+/**
+ * @brief Select the trace format, called before vInitTrace
+ *
+ * @param kpszFormat text or binary
+ * @return 1 valid format
+ * @return 0 unknown format
+ */
+int bSetTraceFormat(const char* kpszFormat);
+
 /**
  * @brief Trace message in .log file
  *
+ * Only formats the line into a ring buffer, the flush thread writes it. When
+ * the ring is full the caller waits for the flush thread.
+ *
  * @param kpszMsg Message
  */
 void vTrace(const char* kpszFmt, ...);
 
+/**
+ * @brief Write the pending lines, stop the flush thread and close the file
+ */
+void vCloseTrace(void);
+
 /**
  * @brief Trace the command line in .log file
  *
@@ -53,6 +53,31 @@
  */
 typedef enum boolean { FALSE, TRUE } boolean;
 
+/**
+ * @def UINT64_FROM(HIGH, LOW)
+ * @brief Uint64 built from its 32 bit halves, C89 has no 64 bit literal and
+ * unsigned long is 32 bits on LLP64
+ */
+#define UINT64_FROM(HIGH, LOW) (((Uint64) (HIGH) << 32) | (Uint64) (LOW))
+
+/**
+ * @def HASH_SEED
+ * @brief Initial value of ullHashBytes (FNV-1a 64 offset basis)
+ */
+#define HASH_SEED UINT64_FROM(0xcbf29ce4UL, 0x84222325UL)
+
+/**
+ * @def HASH_PRIME
+ * @brief Multiplier of ullHashBytes (FNV-1a 64 prime)
+ */
+#define HASH_PRIME UINT64_FROM(0x00000100UL, 0x000001b3UL)
+
+/**
+ * @def HASH_FOLD32(HASH)
+ * @brief ullHashBytes folded to 32 bits, for the hashes stored as Uint32
+ */
+#define HASH_FOLD32(HASH) ((Uint32) (((HASH) >> 32) ^ ((HASH) & 0xFFFFFFFFUL)))
+
 /**
  * @brief Check if string is empty
  *
@@ -63,10 +88,13 @@ typedef enum boolean { FALSE, TRUE } boolean;
 boolean bStrIsEmpty(const char* kpszString);
 
 /**
- * @brief Show GUI message box
+ * @brief Hash a memory block with FNV-1a 64
  *
- * @param kpszMsg Message
+ * @param kpvData Memory block
+ * @param ulSize Size of the block
+ * @param ullHash Previous hash to chain blocks (HASH_SEED for the first one)
+ * @return The hash
  */
-void vMessageBox(const char* kpszMsg, const char* kpszFooterMsg);
+Uint64 ullHashBytes(const void* kpvData, size_t ulSize, Uint64 ullHash);
 
 #endif
@@ -0,0 +1,223 @@
+/**
+ * @file vecenv.h
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+
+#ifndef _VECENV_H_
+#define _VECENV_H_
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "util.h"
+#include "state.h"
+
+/**
+ * @def VECENV_LAYERS
+ * @brief Layers of an observation, each one a MAP_ROW x MAP_COL grid of 0/1:
+ * walls, dots, powers, hero, ghosts and powers held (the whole layer)
+ */
+#define VECENV_LAYERS 6
+
+/**
+ * @def VECENV_OBS_BYTES
+ * @brief Bytes of the observation of an environment
+ */
+#define VECENV_OBS_BYTES (VECENV_LAYERS * MAP_ROW * MAP_COL)
+
+/**
+ * @def VECENV_DEFAULT_COUNT
+ * @brief Environments served when --vecenv-count is not given
+ */
+#define VECENV_DEFAULT_COUNT 16
+
+/**
+ * @def VECENV_MAX_COUNT
+ * @brief Environments of a batch at most
+ */
+#define VECENV_MAX_COUNT 65536
+
+/**
+ * @def VECENV_MAX_TICKS
+ * @brief Ticks after which an episode is cut, the level time only runs once a
+ * dot is eaten and the ghosts wait for the hero
+ */
+#define VECENV_MAX_TICKS 2000
+
+/**
+ * @def VECENV_DONE_TERMINATED
+ * @brief Done flag of an episode ended by the game (game over, time out or
+ * no dot left)
+ */
+#define VECENV_DONE_TERMINATED 1
+
+/**
+ * @def VECENV_DONE_TRUNCATED
+ * @brief Done flag of an episode cut after VECENV_MAX_TICKS
+ */
+#define VECENV_DONE_TRUNCATED 2
+
+/**
+ * @def VECENV_POINTS_PER_REWARD
+ * @brief Points worth a reward of 1, a dot
+ */
+#define VECENV_POINTS_PER_REWARD 10.0
+
+/**
+ * @def VECENV_LIFE_REWARD
+ * @brief Reward of a life lost, by a ghost or by the time
+ */
+#define VECENV_LIFE_REWARD -5.0
+
+/**
+ * @def VECENV_SHM_MAGIC
+ * @brief First bytes of the shared memory once the server is ready
+ */
+#define VECENV_SHM_MAGIC 0x50505645u
+
+/**
+ * @def VECENV_SHM_VERSION
+ * @brief Layout of the shared memory, changed with STRUCT_VECENV_SHM
+ */
+#define VECENV_SHM_VERSION 1
+
+/**
+ * @def VECENV_SHM_ALIGN
+ * @brief Alignment of each area of the shared memory
+ */
+#define VECENV_SHM_ALIGN 64
+
+/**
+ * @enum ENUM_VECENV_COMMAND
+ * @brief What the trainer asks before posting the request semaphore
+ */
+typedef enum ENUM_VECENV_COMMAND {
+  VECENV_CMD_STEP,  /**< Step every environment with the actions    */
+  VECENV_CMD_RESET, /**< Start a new episode in every environment   */
+  VECENV_CMD_CLOSE  /**< Stop the server, the memory is unlinked    */
+} ENUM_VECENV_COMMAND, *PENUM_VECENV_COMMAND;
+
+/**
+ * @struct STRUCT_VECENV
+ * @brief A batch of environments, each one a copy of the game
+ */
+typedef struct STRUCT_VECENV {
+  int iCtEnvs;                   /**< Environments                       */
+  Uint32 uiRandomState;          /**< Ghosts of the new episodes         */
+  STRUCT_GAME_STATE stStart;     /**< Start of each episode              */
+  PSTRUCT_GAME_STATE pastGame;   /**< Game of each environment           */
+  int* paiTicks;                 /**< Ticks of the episode of each one   */
+  unsigned long ulSteps;         /**< Batches stepped                    */
+  unsigned long ulEpisodes;      /**< Episodes finished                  */
+  Uint64 ullStepCounts;          /**< Performance counts spent stepping  */
+} STRUCT_VECENV, *PSTRUCT_VECENV;
+
+/**
+ * @struct STRUCT_VECENV_SHM
+ * @brief Head of the shared memory, the areas follow at the offsets given
+ *
+ * The trainer writes iCommand and the actions, posts the request semaphore
+ * and waits the response one; the server has then written the
+ * observations, the rewards and the done flags. All offsets are in bytes
+ * from the head, the semaphores are process shared sem_t.
+ *
+ * The server stores uiMagic after a release barrier, once the rest of the
+ * head, the semaphores and the first observations are written. The trainer
+ * must read uiMagic with acquire ordering before it reads anything else.
+ */
+typedef struct STRUCT_VECENV_SHM {
+  Uint32 uiMagic;       /**< VECENV_SHM_MAGIC, written last        */
+  Uint16 usVersion;     /**< VECENV_SHM_VERSION                    */
+  Uint16 usLayers;      /**< VECENV_LAYERS                         */
+  Uint16 usRows;        /**< MAP_ROW                               */
+  Uint16 usCols;        /**< MAP_COL                               */
+  Sint32 iCtEnvs;       /**< Environments                          */
+  Sint32 iCommand;      /**< ENUM_VECENV_COMMAND                   */
+  Uint32 uiSize;        /**< Bytes of the whole shared memory      */
+  Uint32 uiRequest;     /**< Offset of the request semaphore       */
+  Uint32 uiResponse;    /**< Offset of the response semaphore      */
+  Uint32 uiActions;     /**< Offset of Sint32[iCtEnvs]             */
+  Uint32 uiObs;         /**< Offset of Uint8[iCtEnvs][VECENV_OBS_BYTES] */
+  Uint32 uiRewards;     /**< Offset of float[iCtEnvs]              */
+  Uint32 uiDones;       /**< Offset of Uint8[iCtEnvs]              */
+} STRUCT_VECENV_SHM, *PSTRUCT_VECENV_SHM;
+
+/**
+ * @brief Create a batch of environments, all at the start of the episode
+ *
+ * @param iCtEnvs Environments, 1 up to VECENV_MAX_COUNT
+ * @param kpstStart Game at the start of an episode (a level just loaded)
+ * @param uiSeed Seed of the ghosts of the episodes
+ * @return The batch or NULL on error
+ */
+PSTRUCT_VECENV pstCreateVecEnv(int iCtEnvs, const STRUCT_GAME_STATE* kpstStart, Uint32 uiSeed);
+
+/**
+ * @brief Start a new episode in every environment
+ *
+ * @param pstEnv Batch
+ * @param pucObs Receives iCtEnvs observations of VECENV_OBS_BYTES
+ */
+void vResetVecEnv(PSTRUCT_VECENV pstEnv, Uint8* pucObs);
+
+/**
+ * @brief Run a tick in every environment
+ *
+ * An environment whose episode ended (game over, time out or no dot left)
+ * or ran VECENV_MAX_TICKS gets its done flag and starts a new episode at
+ * once, its observation is the first one of the new episode.
+ *
+ * @param pstEnv Batch
+ * @param kpiActions Move of each hero, UP_MOVEMENT...RIGHT_MOVENT or
+ * NONE_MOVEMENT to keep the current one
+ * @param pucObs Receives iCtEnvs observations of VECENV_OBS_BYTES
+ * @param pfRewards Receives the reward of each environment
+ * @param pucDones Receives VECENV_DONE_TERMINATED or VECENV_DONE_TRUNCATED
+ * where the episode ended, 0 elsewhere
+ */
+void vStepVecEnv(PSTRUCT_VECENV pstEnv, const Sint32* kpiActions, Uint8* pucObs, float* pfRewards, Uint8* pucDones);
+
+/**
+ * @brief Serve the batch to another process through POSIX shared memory
+ * until it sends VECENV_CMD_CLOSE
+ *
+ * @param pstEnv Batch
+ * @param kpszName Shared memory name ("/name")
+ * @return TRUE closed by the trainer
+ * @return FALSE shared memory error
+ */
+boolean bServeVecEnv(PSTRUCT_VECENV pstEnv, const char* kpszName);
+
+/**
+ * @brief Print the steps of the batch and their rate
+ *
+ * @param fpOut Output file
+ * @param kpstEnv Batch
+ */
+void vPrintVecEnvStats(FILE* fpOut, const STRUCT_VECENV* kpstEnv);
+
+/**
+ * @brief Free a batch
+ *
+ * @param pstEnv Batch
+ */
+void vDestroyVecEnv(PSTRUCT_VECENV pstEnv);
+
+#endif
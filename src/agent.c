@@ -0,0 +1,275 @@
+/**
+ * @file agent.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <string.h>
+#include "game.h"
+#include "agent.h"
+
+/**
+ * @def AGENT_CELLS
+ * @brief Cells searched by the greedy agent
+ */
+#define AGENT_CELLS (MAP_ROW * MAP_COL)
+
+/**
+ * @struct STRUCT_AGENT
+ * @brief The agent driving the hero
+ */
+typedef struct STRUCT_AGENT {
+  char szName[_MAX_PATH];               /**< Built-in name or library path    */
+  PFNAGENTACT pfnAct;                   /**< NULL when no agent is selected   */
+  PFNAGENTCLOSE pfnClose;               /**< Close function of the library    */
+  void* pvLibrary;                      /**< Library or NULL for the built-in */
+  Uint32 uiRandomState;                 /**< Generator of the random agent    */
+  unsigned long ulDecisions;            /**< Calls of pfnAct                  */
+  STRUCT_GAME_STATE stObservation;      /**< Game given to pfnAct             */
+} STRUCT_AGENT, *PSTRUCT_AGENT;
+
+/**
+ * @struct STRUCT_BUILTIN_AGENT
+ * @brief An agent compiled in the game
+ */
+typedef struct STRUCT_BUILTIN_AGENT {
+  const char* kpszName;   /**< Name given to --agent */
+  PFNAGENTACT pfnAct;     /**< Its function          */
+  PFNAGENTINIT pfnInit;   /**< Set up or NULL        */
+  PFNAGENTCLOSE pfnClose; /**< Clean up or NULL      */
+} STRUCT_BUILTIN_AGENT, *PSTRUCT_BUILTIN_AGENT;
+
+/**
+ * @var gstAgent
+ * @brief The agent driving the hero
+ */
+static STRUCT_AGENT gstAgent;
+
+/**
+ * @var gaiFirstMove
+ * @brief Move from the hero leading to each cell, -2 not reached
+ */
+static int gaiFirstMove[AGENT_CELLS];
+
+/**
+ * @var gaiQueue
+ * @brief Cells to visit by the greedy agent
+ */
+static int gaiQueue[AGENT_CELLS];
+
+/**
+ * @var gkaiMoveRow
+ * @brief Row step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiMoveRow[4] = { -1, 0, 1, 0 };
+
+/**
+ * @var gkaiMoveCol
+ * @brief Col step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiMoveCol[4] = { 0, -1, 0, 1 };
+
+/**
+ * @brief Check if the hero can walk on a cell without dying
+ *
+ * @param kpstState Game
+ * @param iRow Row
+ * @param iCol Col
+ * @return TRUE free cell, or a ghost that a power kills
+ * @return FALSE wall, ghost or out of the map
+ */
+static boolean bAgentCellOpen(const STRUCT_GAME_STATE* kpstState, int iRow, int iCol);
+
+/**
+ * @brief Take a random open direction now and then, keep going otherwise
+ *
+ * @param kpstState Game
+ * @return Movement
+ */
+static int iRandomAgent(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @brief Walk the shortest path to the nearest dot or power, around the
+ * walls and the ghosts
+ *
+ * @param kpstState Game
+ * @return Movement
+ */
+static int iGreedyAgent(const STRUCT_GAME_STATE* kpstState);
+
+/**
+ * @var gkastBuiltinAgent
+ * @brief Agents selected by name, NULL terminated
+ */
+static const STRUCT_BUILTIN_AGENT gkastBuiltinAgent[] = {
+  { "random", iRandomAgent, NULL     , NULL       },
+  { "greedy", iGreedyAgent, NULL     , NULL       },
+  { "mcts"  , iMctsAct    , bMctsInit, vMctsClose },
+  { NULL    , NULL        , NULL     , NULL       }
+};
+
+static boolean bAgentCellOpen(const STRUCT_GAME_STATE* kpstState, int iRow, int iCol) {
+  char chCell = '\0';
+
+  if ( iRow < 0 || iRow >= MAP_ROW || iCol < 0 || iCol >= MAP_COL ) return FALSE;
+  chCell = kpstState->aszMap[iRow][iCol];
+  if ( chCell == '#' ) return FALSE;
+  if ( chCell == 'R' || chCell == 'G' || chCell == 'B' || chCell == 'A' ) return kpstState->iPowersCollected > 0;
+  return TRUE;
+}
+
+static int iRandomAgent(const STRUCT_GAME_STATE* kpstState) {
+  const STRUCT_ENTITY* kpstHero = &kpstState->astEntity[0];
+  int aiOpen[4];
+  int iCtOpen = 0;
+  int iMove = 0;
+
+  for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+    if ( bAgentCellOpen(kpstState, kpstHero->iY + gkaiMoveRow[iMove], kpstHero->iX + gkaiMoveCol[iMove]) ) aiOpen[iCtOpen++] = iMove;
+  }
+  if ( iCtOpen == 0 ) return NONE_MOVEMENT;
+  iMove = kpstHero->iMovementDirection;
+  /* Keep the way three times out of four while it is open */
+  if ( iMove != NONE_MOVEMENT
+    && bAgentCellOpen(kpstState, kpstHero->iY + gkaiMoveRow[iMove], kpstHero->iX + gkaiMoveCol[iMove])
+    && iRandomBelowFrom(&gstAgent.uiRandomState, 4) != 0 ) {
+    return NONE_MOVEMENT;
+  }
+  return aiOpen[iRandomBelowFrom(&gstAgent.uiRandomState, iCtOpen)];
+}
+
+static int iGreedyAgent(const STRUCT_GAME_STATE* kpstState) {
+  const STRUCT_ENTITY* kpstHero = &kpstState->astEntity[0];
+  int iHead = 0;
+  int iTail = 0;
+  int iMove = 0;
+  int ii = 0;
+
+  if ( kpstHero->iY < 0 || kpstHero->iY >= MAP_ROW || kpstHero->iX < 0 || kpstHero->iX >= MAP_COL ) return NONE_MOVEMENT;
+  for ( ii = 0; ii < AGENT_CELLS; ii++ ) {
+    gaiFirstMove[ii] = -2;
+  }
+  gaiFirstMove[kpstHero->iY * MAP_COL + kpstHero->iX] = NONE_MOVEMENT;
+  gaiQueue[iTail++] = kpstHero->iY * MAP_COL + kpstHero->iX;
+
+  /* Breadth first, the first dot reached is a nearest one */
+  while ( iHead < iTail ) {
+    int iCell = gaiQueue[iHead++];
+    int iRow = iCell / MAP_COL;
+    int iCol = iCell % MAP_COL;
+    char chCell = kpstState->aszMap[iRow][iCol];
+    if ( (chCell == '.' || chCell == 'O') && gaiFirstMove[iCell] != NONE_MOVEMENT ) return gaiFirstMove[iCell];
+    for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+      int iNextRow = iRow + gkaiMoveRow[iMove];
+      int iNextCol = iCol + gkaiMoveCol[iMove];
+      int iNext = iNextRow * MAP_COL + iNextCol;
+      if ( !bAgentCellOpen(kpstState, iNextRow, iNextCol) || gaiFirstMove[iNext] != -2 ) continue;
+      gaiFirstMove[iNext] = gaiFirstMove[iCell] == NONE_MOVEMENT ? iMove : gaiFirstMove[iCell];
+      gaiQueue[iTail++] = iNext;
+    }
+  }
+  return NONE_MOVEMENT;
+}
+
+boolean bInitAgent(const char* kpszAgent, Uint32 uiSeed) {
+  PFNAGENTINIT pfnInit = NULL;
+  void* pvSymbol = NULL;
+  int ii = 0;
+
+  memset(&gstAgent, 0x00, sizeof(gstAgent));
+  sprintf(gstAgent.szName, "%.*s", (int) sizeof(gstAgent.szName) - 1, kpszAgent);
+  /* Another stream than the ghosts, which start from the same seed */
+  gstAgent.uiRandomState = uiSeed ^ 0x5851F42Du;
+  if ( gstAgent.uiRandomState == 0 ) gstAgent.uiRandomState = RNG_DEFAULT_SEED;
+  for ( ii = 0; gkastBuiltinAgent[ii].kpszName; ii++ ) {
+    if ( strcmp(kpszAgent, gkastBuiltinAgent[ii].kpszName) == 0 ) {
+      gstAgent.pfnAct = gkastBuiltinAgent[ii].pfnAct;
+      gstAgent.pfnClose = gkastBuiltinAgent[ii].pfnClose;
+      pfnInit = gkastBuiltinAgent[ii].pfnInit;
+      if ( pfnInit && !pfnInit(gstAgent.uiRandomState) ) {
+        fprintf(stderr, "E: Agent [%s] refused to play\n", kpszAgent);
+        vCloseAgent();
+        return FALSE;
+      }
+      return TRUE;
+    }
+  }
+
+  if ( (gstAgent.pvLibrary = SDL_LoadObject(kpszAgent)) == NULL ) {
+    fprintf(stderr, "E: Impossible to load the agent [%s]: [%s]\n", kpszAgent, SDL_GetError());
+    return FALSE;
+  }
+  /* Through memcpy, ISO C has no cast from object to function pointers */
+  if ( (pvSymbol = SDL_LoadFunction(gstAgent.pvLibrary, AGENT_ACT_SYMBOL)) == NULL ) {
+    fprintf(stderr, "E: Agent [%s] has no [%s]: [%s]\n", kpszAgent, AGENT_ACT_SYMBOL, SDL_GetError());
+    vCloseAgent();
+    return FALSE;
+  }
+  memcpy(&gstAgent.pfnAct, &pvSymbol, sizeof(gstAgent.pfnAct));
+  if ( (pvSymbol = SDL_LoadFunction(gstAgent.pvLibrary, AGENT_CLOSE_SYMBOL)) != NULL ) {
+    memcpy(&gstAgent.pfnClose, &pvSymbol, sizeof(gstAgent.pfnClose));
+  }
+  if ( (pvSymbol = SDL_LoadFunction(gstAgent.pvLibrary, AGENT_INIT_SYMBOL)) != NULL ) {
+    memcpy(&pfnInit, &pvSymbol, sizeof(pfnInit));
+    if ( !pfnInit(gstAgent.uiRandomState) ) {
+      fprintf(stderr, "E: Agent [%s] refused to play\n", kpszAgent);
+      vCloseAgent();
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+boolean bAgentActive(void) {
+  return gstAgent.pfnAct != NULL;
+}
+
+void vRunAgent(void) {
+  int iMove = NONE_MOVEMENT;
+
+  if ( !gstAgent.pfnAct ) return;
+  vTimelineBegin("agent");
+  vSaveGameState(&gstAgent.stObservation);
+  iMove = gstAgent.pfnAct(&gstAgent.stObservation);
+  gstAgent.ulDecisions++;
+  vTimelineEnd("agent");
+  if ( iMove >= UP_MOVEMENT && iMove <= RIGHT_MOVENT ) vPostMove(iMove);
+}
+
+unsigned long ulGetAgentDecisions(void) {
+  return gstAgent.ulDecisions;
+}
+
+void vPrintAgentStats(FILE* fpOut, Uint64 ullElapsed) {
+  double dSeconds = (double) ullElapsed / 1000000.0;
+  if ( !gstAgent.pfnAct ) return;
+  fprintf(
+    fpOut, "Agent %s: %lu decisions in %.3f s (%.0f decisions/s)\n",
+    gstAgent.szName, gstAgent.ulDecisions, dSeconds,
+    dSeconds > 0.0 ? (double) gstAgent.ulDecisions / dSeconds : 0.0
+  );
+}
+
+void vCloseAgent(void) {
+  if ( gstAgent.pfnClose ) gstAgent.pfnClose();
+  if ( gstAgent.pvLibrary ) SDL_UnloadObject(gstAgent.pvLibrary);
+  gstAgent.pfnAct = NULL;
+  gstAgent.pfnClose = NULL;
+  gstAgent.pvLibrary = NULL;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file anim.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "map.h"
+#include "player.h"
+#include "ghost.h"
+#include "anim.h"
+
+/**
+ * @def HERO_SPRITE_COLS
+ * @brief Cols of the hero sprite sheet, one col per direction and one row
+ * per walk frame
+ */
+#define HERO_SPRITE_COLS 4
+
+/**
+ * @def HERO_WALK(SPRITE)
+ * @brief Walk loop of the hero going to the direction of SPRITE
+ */
+#define HERO_WALK(SPRITE) {                  \
+  {                                          \
+    (SPRITE),                                \
+    (SPRITE) + HERO_SPRITE_COLS,             \
+    (SPRITE) + HERO_SPRITE_COLS * 2,         \
+    (SPRITE) + HERO_SPRITE_COLS * 3          \
+  }, ANIM_MAX_FRAMES, HERO_WALK_FRAME_MS }
+
+/**
+ * @def STILL(SPRITE)
+ * @brief Animation of a single sprite
+ */
+#define STILL(SPRITE) { { (SPRITE), 0, 0, 0 }, 1, 1 }
+
+/**
+ * @var gkastAnimation
+ * @brief Animations by entity type, state and direction, the direction index
+ * is the movement direction + 1 (NONE_MOVEMENT, UP, LEFT, DOWN, RIGHT)
+ */
+static const STRUCT_ANIMATION gkastAnimation[ENTITY_TYPE_COUNT][ANIM_STATE_COUNT][ANIM_DIRECTIONS] = {
+  { /* ENTITY_HERO */
+    { /* ANIM_IDLE */
+      STILL(HERO_DOWN_SPRITE),
+      STILL(HERO_UP_SPRITE),
+      STILL(HERO_LEFT_SPRITE),
+      STILL(HERO_DOWN_SPRITE),
+      STILL(HERO_RIGHT_SPRITE)
+    },
+    { /* ANIM_WALK */
+      STILL(HERO_DOWN_SPRITE),
+      HERO_WALK(HERO_UP_SPRITE),
+      HERO_WALK(HERO_LEFT_SPRITE),
+      HERO_WALK(HERO_DOWN_SPRITE),
+      HERO_WALK(HERO_RIGHT_SPRITE)
+    },
+    { /* ANIM_SCARED, the hero is never scared */
+      STILL(HERO_DOWN_SPRITE),
+      HERO_WALK(HERO_UP_SPRITE),
+      HERO_WALK(HERO_LEFT_SPRITE),
+      HERO_WALK(HERO_DOWN_SPRITE),
+      HERO_WALK(HERO_RIGHT_SPRITE)
+    }
+  },
+  { /* ENTITY_GHOST, only looks to the left or to the right */
+    { /* ANIM_IDLE */
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_RIGHT_SPRITE)
+    },
+    { /* ANIM_WALK */
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_LEFT_SPRITE),
+      STILL(GHOST_NORMAL_RIGHT_SPRITE)
+    },
+    { /* ANIM_SCARED */
+      STILL(GHOST_SCARED_LEFT_SPRITE),
+      STILL(GHOST_SCARED_LEFT_SPRITE),
+      STILL(GHOST_SCARED_LEFT_SPRITE),
+      STILL(GHOST_SCARED_LEFT_SPRITE),
+      STILL(GHOST_SCARED_RIGHT_SPRITE)
+    }
+  }
+};
+
+int iGetAnimationSprite(PSTRUCT_ENTITY pstEntity, ENUM_ANIM_STATE eState, Uint32 uiElapsedMs) {
+  const STRUCT_ANIMATION* kpstAnimation = NULL;
+  int iDirection = pstEntity->iMovementDirection - NONE_MOVEMENT;
+
+  if ( iDirection < 0 || iDirection >= ANIM_DIRECTIONS ) iDirection = 0;
+  /* The ghost R looks to the right unless it goes to the left */
+  if ( pstEntity->eType == ENTITY_GHOST && pstEntity->chLetter == 'R' && iDirection != LEFT_MOVEMENT - NONE_MOVEMENT ) {
+    iDirection = RIGHT_MOVENT - NONE_MOVEMENT;
+  }
+  kpstAnimation = &gkastAnimation[pstEntity->eType][eState][iDirection];
+  return kpstAnimation->aiFrame[(uiElapsedMs / kpstAnimation->uiFrameMs) % (Uint32) kpstAnimation->iCtFrames];
+}
@@ -0,0 +1,233 @@
+/**
+ * @file assets.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gui.h"
+#include "assets.h"
+#include "timeline.h"
+
+/**
+ * @struct STRUCT_ASSET
+ * @brief An asset in the decoding queue
+ */
+typedef struct STRUCT_ASSET {
+  ENUM_ASSET_KIND eKind;    /**< What the file is decoded to       */
+  char szPath[_MAX_PATH];   /**< File path                         */
+  SDL_Surface* pstSurface;  /**< Decoded image                     */
+  SDL_Texture* pstTexture;  /**< Uploaded image                    */
+  Mix_Chunk* pstSound;      /**< Decoded sound                     */
+  Mix_Music* pstMusic;      /**< Decoded music                     */
+  SDL_atomic_t stDone;      /**< Set by the worker when decoded    */
+} STRUCT_ASSET, *PSTRUCT_ASSET;
+
+/**
+ * @var gastAsset
+ * @brief Decoding queue
+ */
+static STRUCT_ASSET gastAsset[MAX_ASSETS];
+
+/**
+ * @var giCtAssets
+ * @brief Assets in the queue
+ */
+static int giCtAssets = 0;
+
+/**
+ * @var gstNextAsset
+ * @brief Next asset a worker takes
+ */
+static SDL_atomic_t gstNextAsset;
+
+/**
+ * @brief Decode one asset
+ *
+ * @param pstAsset Asset
+ */
+static void vDecodeAsset(PSTRUCT_ASSET pstAsset);
+
+/**
+ * @brief Worker loop, decodes assets until the queue is empty
+ *
+ * @param pvData Not used
+ * @return 0
+ */
+static int iAssetWorker(void* pvData);
+
+/**
+ * @brief Entry of a worker thread, names it in the timeline
+ *
+ * @param pvData Not used
+ * @return 0
+ */
+static int iAssetThread(void* pvData);
+
+/**
+ * @brief Upload the decoded images not uploaded yet and count the decoded
+ * assets
+ *
+ * @return Assets decoded
+ */
+static int iCollectAssets(void);
+
+static void vDecodeAsset(PSTRUCT_ASSET pstAsset) {
+  switch ( pstAsset->eKind ) {
+    case ASSET_IMAGE: {
+      if ( (pstAsset->pstSurface = pstGfxLoadImage(pstAsset->szPath)) == NULL ) {
+        if ( DEBUG_WARNING ) vTrace("W: Error loading the image %s: %s", pstAsset->szPath, IMG_GetError());
+      }
+      break;
+    }
+    case ASSET_SOUND: {
+      if ( (pstAsset->pstSound = Mix_LoadWAV(pstAsset->szPath)) == NULL ) {
+        if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
+      }
+      break;
+    }
+    case ASSET_MUSIC: {
+      if ( (pstAsset->pstMusic = Mix_LoadMUS(pstAsset->szPath)) == NULL ) {
+        if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadMUS: [%s]!", Mix_GetError());
+      }
+      break;
+    }
+    default: break;
+  }
+  /* Full barrier, the results are visible before the flag */
+  SDL_AtomicSet(&pstAsset->stDone, 1);
+}
+
+static int iAssetWorker(void* pvData) {
+  int iIndex = 0;
+  (void) pvData;
+  while ( (iIndex = SDL_AtomicAdd(&gstNextAsset, 1)) < giCtAssets ) {
+    vTimelineBegin(gastAsset[iIndex].szPath);
+    vDecodeAsset(&gastAsset[iIndex]);
+    vTimelineEnd(gastAsset[iIndex].szPath);
+  }
+  return 0;
+}
+
+static int iAssetThread(void* pvData) {
+  vTimelineThreadName("assets");
+  return iAssetWorker(pvData);
+}
+
+static int iCollectAssets(void) {
+  int iCtDone = 0;
+  int ii = 0;
+  for ( ii = 0; ii < giCtAssets; ii++ ) {
+    PSTRUCT_ASSET pstAsset = &gastAsset[ii];
+    if ( !SDL_AtomicGet(&pstAsset->stDone) ) continue;
+    iCtDone++;
+    if ( pstAsset->pstSurface ) {
+      pstAsset->pstTexture = pstGfxCreateTextureFromSurface(gpstRenderer, pstAsset->pstSurface);
+      if ( !pstAsset->pstTexture && DEBUG_WARNING ) vTrace("W: Error uploading the image %s: %s", pstAsset->szPath, SDL_GetError());
+      SDL_FreeSurface(pstAsset->pstSurface);
+      pstAsset->pstSurface = NULL;
+    }
+  }
+  return iCtDone;
+}
+
+int iQueueAsset(ENUM_ASSET_KIND eKind, const char* kpszPath) {
+  PSTRUCT_ASSET pstAsset = NULL;
+  if ( giCtAssets == MAX_ASSETS ) {
+    if ( DEBUG_ERROR ) vTrace("E: Asset queue full, dropping [%s]", kpszPath);
+    return -1;
+  }
+  pstAsset = &gastAsset[giCtAssets];
+  memset(pstAsset, 0x00, sizeof(STRUCT_ASSET));
+  pstAsset->eKind = eKind;
+  sprintf(pstAsset->szPath, "%.*s", (int) sizeof(pstAsset->szPath) - 1, kpszPath);
+  return giCtAssets++;
+}
+
+boolean bLoadAssets(PFNASSETPROGRESS pfnProgress) {
+  SDL_Thread* apstWorker[ASSET_MAX_WORKERS];
+  int iCtWorkers = SDL_GetCPUCount();
+  int iCtDone = 0;
+  int ii = 0;
+
+  if ( iCtWorkers > ASSET_MAX_WORKERS ) iCtWorkers = ASSET_MAX_WORKERS;
+  if ( iCtWorkers > giCtAssets ) iCtWorkers = giCtAssets;
+  SDL_AtomicSet(&gstNextAsset, 0);
+
+  for ( ii = 0; ii < iCtWorkers; ii++ ) {
+    if ( (apstWorker[ii] = SDL_CreateThread(iAssetThread, "assets", NULL)) == NULL ) {
+      if ( DEBUG_WARNING ) vTrace("W: Impossible to create the asset thread: [%s]", SDL_GetError());
+      break;
+    }
+  }
+  iCtWorkers = ii;
+
+  if ( iCtWorkers == 0 ) {
+    iAssetWorker(NULL);
+    iCollectAssets();
+    return FALSE;
+  }
+
+  while ( (iCtDone = iCollectAssets()) < giCtAssets ) {
+    if ( pfnProgress ) pfnProgress(iCtDone, giCtAssets);
+    SDL_Delay(ASSET_POLL_MS);
+  }
+  if ( pfnProgress ) pfnProgress(iCtDone, giCtAssets);
+
+  for ( ii = 0; ii < iCtWorkers; ii++ ) {
+    SDL_WaitThread(apstWorker[ii], NULL);
+  }
+  return TRUE;
+}
+
+SDL_Texture* pstTakeAssetTexture(int iHandle) {
+  SDL_Texture* pstTexture = NULL;
+  if ( iHandle < 0 || iHandle >= giCtAssets ) return NULL;
+  pstTexture = gastAsset[iHandle].pstTexture;
+  gastAsset[iHandle].pstTexture = NULL;
+  return pstTexture;
+}
+
+Mix_Chunk* pstTakeAssetSound(int iHandle) {
+  Mix_Chunk* pstSound = NULL;
+  if ( iHandle < 0 || iHandle >= giCtAssets ) return NULL;
+  pstSound = gastAsset[iHandle].pstSound;
+  gastAsset[iHandle].pstSound = NULL;
+  return pstSound;
+}
+
+Mix_Music* pstTakeAssetMusic(int iHandle) {
+  Mix_Music* pstMusic = NULL;
+  if ( iHandle < 0 || iHandle >= giCtAssets ) return NULL;
+  pstMusic = gastAsset[iHandle].pstMusic;
+  gastAsset[iHandle].pstMusic = NULL;
+  return pstMusic;
+}
+
+void vDestroyAssets(void) {
+  int ii = 0;
+  for ( ii = 0; ii < giCtAssets; ii++ ) {
+    PSTRUCT_ASSET pstAsset = &gastAsset[ii];
+    if ( pstAsset->pstSurface ) SDL_FreeSurface(pstAsset->pstSurface);
+    if ( pstAsset->pstTexture ) vGfxDestroyTexture(pstAsset->pstTexture);
+    if ( pstAsset->pstSound ) Mix_FreeChunk(pstAsset->pstSound);
+    if ( pstAsset->pstMusic ) Mix_FreeMusic(pstAsset->pstMusic);
+  }
+  memset(gastAsset, 0x00, sizeof(gastAsset));
+  giCtAssets = 0;
+}
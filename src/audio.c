@@ -0,0 +1,177 @@
+/**
+ * @file audio.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "trace.h"
+#include "audio.h"
+
+ENUM_AUDIO_BACKEND geAudioBackend = AUDIO_BACKEND_MIXER;
+STRUCT_AUDIO_SPEC gstAudioSpec = { AUDIO_FREQUENCY, AUDIO_CHUNKSIZE, AUDIO_CHANNELS };
+
+/**
+ * @brief Open the mixer on the default device
+ *
+ * @return TRUE device opened
+ * @return FALSE no device
+ */
+static boolean bMixerOpen(void);
+
+/**
+ * @brief Close the mixer
+ */
+static void vMixerClose(void);
+
+/**
+ * @brief Play a music in loop with the mixer
+ *
+ * @param pstMusic Music
+ */
+static void vMixerPlayMusic(Mix_Music* pstMusic);
+
+/**
+ * @brief Pause the music of the mixer
+ */
+static void vMixerPauseMusic(void);
+
+/**
+ * @brief Stop the music of the mixer
+ */
+static void vMixerHaltMusic(void);
+
+/**
+ * @brief Nothing to open
+ *
+ * @return TRUE
+ */
+static boolean bNullOpen(void);
+
+/**
+ * @brief Do nothing
+ */
+static void vNullVoid(void);
+
+/**
+ * @brief Do nothing with a music
+ *
+ * @param pstMusic Not used
+ */
+static void vNullMusic(Mix_Music* pstMusic);
+
+/**
+ * @var gkastAudioBackend
+ * @brief Backends, indexed by ENUM_AUDIO_BACKEND
+ */
+static const STRUCT_AUDIO_BACKEND gkastAudioBackend[] = {
+  { "mixer", bMixerOpen, vMixerClose, vMixerPlayMusic, vMixerPauseMusic, vMixerHaltMusic },
+  { "null" , bNullOpen , vNullVoid  , vNullMusic     , vNullVoid       , vNullVoid       }
+};
+
+/**
+ * @var gpkstAudio
+ * @brief Backend in use, null until bOpenAudio
+ */
+static const STRUCT_AUDIO_BACKEND* gpkstAudio = &gkastAudioBackend[AUDIO_BACKEND_NULL];
+
+static boolean bMixerOpen(void) {
+  Uint16 usFormat = 0;
+  int iFrequency = 0;
+  int iChannels = 0;
+
+  if ( Mix_OpenAudio(gstAudioSpec.iFrequency, MIX_DEFAULT_FORMAT, gstAudioSpec.iChannels, gstAudioSpec.iChunkSize) < 0 ) {
+    if ( DEBUG_WARNING ) vTrace("W: Failure to start Mixer module: [%s]!", Mix_GetError());
+    return FALSE;
+  }
+  /* The device may not accept the format, the chunks are converted to this one */
+  if ( Mix_QuerySpec(&iFrequency, &usFormat, &iChannels) ) {
+    gstAudioSpec.iFrequency = iFrequency;
+    gstAudioSpec.iChannels = iChannels;
+  }
+  if ( DEBUG_INFO ) vTrace("I: Mixer %d Hz, %d channels, %d frames (%d ms)", gstAudioSpec.iFrequency, gstAudioSpec.iChannels, gstAudioSpec.iChunkSize, gstAudioSpec.iChunkSize * 1000 / gstAudioSpec.iFrequency);
+  return TRUE;
+}
+
+static void vMixerClose(void) {
+  Mix_CloseAudio();
+}
+
+static void vMixerPlayMusic(Mix_Music* pstMusic) {
+  if ( pstMusic ) Mix_PlayMusic(pstMusic, -1);
+}
+
+static void vMixerPauseMusic(void) {
+  Mix_PauseMusic();
+}
+
+static void vMixerHaltMusic(void) {
+  Mix_HaltMusic();
+}
+
+static boolean bNullOpen(void) {
+  return TRUE;
+}
+
+static void vNullVoid(void) {
+}
+
+static void vNullMusic(Mix_Music* pstMusic) {
+  (void) pstMusic;
+}
+
+boolean bSetAudioSpec(int iFrequency, int iChunkSize, int iChannels) {
+  if ( iFrequency == 0 ) iFrequency = AUDIO_FREQUENCY;
+  if ( iChunkSize == 0 ) iChunkSize = AUDIO_CHUNKSIZE;
+  if ( iChannels == 0 ) iChannels = AUDIO_CHANNELS;
+  if ( iFrequency < 8000 || iFrequency > 192000 ) return FALSE;
+  if ( iChunkSize < 64 || iChunkSize > 8192 || (iChunkSize & (iChunkSize - 1)) != 0 ) return FALSE;
+  if ( iChannels != 1 && iChannels != 2 && iChannels != 4 && iChannels != 6 && iChannels != 8 ) return FALSE;
+  gstAudioSpec.iFrequency = iFrequency;
+  gstAudioSpec.iChunkSize = iChunkSize;
+  gstAudioSpec.iChannels = iChannels;
+  return TRUE;
+}
+
+boolean bOpenAudio(void) {
+  gpkstAudio = &gkastAudioBackend[geAudioBackend];
+  if ( !gpkstAudio->pfnOpen() ) gpkstAudio = &gkastAudioBackend[AUDIO_BACKEND_NULL];
+  if ( DEBUG_INFO ) vTrace("I: Audio backend [%s]", gpkstAudio->kpszName);
+  return bAudioEnabled();
+}
+
+void vCloseAudio(void) {
+  gpkstAudio->pfnClose();
+  gpkstAudio = &gkastAudioBackend[AUDIO_BACKEND_NULL];
+}
+
+boolean bAudioEnabled(void) {
+  return gpkstAudio != &gkastAudioBackend[AUDIO_BACKEND_NULL];
+}
+
+void vPlayMusic(Mix_Music* pstMusic) {
+  gpkstAudio->pfnPlayMusic(pstMusic);
+}
+
+void vPauseMusic(void) {
+  gpkstAudio->pfnPauseMusic();
+}
+
+void vHaltMusic(void) {
+  gpkstAudio->pfnHaltMusic();
+}
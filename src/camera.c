@@ -0,0 +1,118 @@
+/**
+ * @file camera.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gui.h"
+#include "map.h"
+#include "camera.h"
+
+STRUCT_CAMERA gstCamera = { 0.0f, 0.0f, 0.0f, 0.0f, CAMERA_DEFAULT_ZOOM, 0, 0, 0, 0, FALSE };
+
+/**
+ * @var gkafZoom
+ * @brief Scale of each zoom level
+ */
+static const float gkafZoom[CAMERA_ZOOM_LEVELS] = { 0.5f, 0.75f, 1.0f, 1.5f, 2.0f };
+
+/**
+ * @brief Get the first visible map position of an axis
+ *
+ * @param fFocus Position followed
+ * @param fView Cells that fit in the screen
+ * @param iMapCells Cells of the map in the axis
+ * @param iScreen Logical size of the screen in the axis
+ * @param fCell Logical size of a cell
+ * @return First visible position, negative when the map is centered
+ */
+static float fCameraOrigin(float fFocus, float fView, int iMapCells, int iScreen, float fCell);
+
+/**
+ * @brief Get the last visible cell of an axis
+ *
+ * @param fOrigin First visible position
+ * @param fView Cells that fit in the screen
+ * @param iMapCells Cells of the map in the axis
+ * @return Last visible cell
+ */
+static int iLastVisible(float fOrigin, float fView, int iMapCells);
+
+static float fCameraOrigin(float fFocus, float fView, int iMapCells, int iScreen, float fCell) {
+  float fOrigin = 0.0f;
+  float fMargin = 0.0f;
+  int iMargin = 0;
+
+  /* The whole map fits, center it on whole logical pixels */
+  if ( fView >= (float) iMapCells ) {
+    fMargin = ((float) iScreen - (float) iMapCells * fCell) / 2.0f;
+    iMargin = (int) fMargin;
+    return -(float) iMargin / fCell;
+  }
+  fOrigin = fFocus + 0.5f - fView / 2.0f;
+  if ( fOrigin < 0.0f ) fOrigin = 0.0f;
+  if ( fOrigin > (float) iMapCells - fView ) fOrigin = (float) iMapCells - fView;
+  return fOrigin;
+}
+
+static int iLastVisible(float fOrigin, float fView, int iMapCells) {
+  float fEnd = fOrigin + fView;
+  int iLast = (int) fEnd;
+  return iLast >= iMapCells ? iMapCells - 1 : iLast;
+}
+
+void vUpdateCamera(float fFocusCol, float fFocusRow) {
+  float fViewCols = 0.0f;
+  float fViewRows = 0.0f;
+
+  gstCamera.fCellWidth = (float) CELL_WIDTH * gkafZoom[gstCamera.iZoom];
+  gstCamera.fCellHeight = (float) CELL_HEIGHT * gkafZoom[gstCamera.iZoom];
+  fViewCols = (float) LOGICAL_WIDTH / gstCamera.fCellWidth;
+  fViewRows = (float) LOGICAL_HEIGHT / gstCamera.fCellHeight;
+
+  gstCamera.fCol = fCameraOrigin(fFocusCol, fViewCols, MAP_COL, LOGICAL_WIDTH, gstCamera.fCellWidth);
+  gstCamera.fRow = fCameraOrigin(fFocusRow, fViewRows, MAP_ROW, LOGICAL_HEIGHT, gstCamera.fCellHeight);
+
+  gstCamera.iFirstCol = gstCamera.fCol > 0.0f ? (int) gstCamera.fCol : 0;
+  gstCamera.iFirstRow = gstCamera.fRow > 0.0f ? (int) gstCamera.fRow : 0;
+  gstCamera.iLastCol = iLastVisible(gstCamera.fCol, fViewCols, MAP_COL);
+  gstCamera.iLastRow = iLastVisible(gstCamera.fRow, fViewRows, MAP_ROW);
+}
+
+void vZoomCamera(int iStep) {
+  int iZoom = gstCamera.iZoom + iStep;
+  if ( iZoom < 0 ) iZoom = 0;
+  if ( iZoom > CAMERA_ZOOM_LEVELS - 1 ) iZoom = CAMERA_ZOOM_LEVELS - 1;
+  if ( iZoom == gstCamera.iZoom ) return;
+  gstCamera.iZoom = iZoom;
+  /* Cached textures are prescaled to the cell size */
+  vInvalidateRenderCache();
+}
+
+void vToggleMinimap(void) {
+  gstCamera.bMinimap = !gstCamera.bMinimap;
+}
+
+float fCameraX(float fCol) {
+  return (fCol - gstCamera.fCol) * gstCamera.fCellWidth;
+}
+
+float fCameraY(float fRow) {
+  return (fRow - gstCamera.fRow) * gstCamera.fCellHeight;
+}
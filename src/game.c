@@ -37,143 +37,270 @@ int giCurrentLevelTime = gkaiLevelsTime[0];
 Mix_Music* gpstMusic = NULL;
 
 /**
- * @brief Move the hero in the map
+ * @brief Reset the level variables after the level up message
  */
-static void vHeroMove(void);
+static void vStartNextLevel(void);
 
 /**
- * @brief Move the ghosts in the map
+ * @brief Resume the game after the pause message
  */
-static void vGhostsMove(void);
+static void vResumeGame(void);
 
 /**
- * @var gpaMovements
- * @brief Movements array variable
+ * @brief Get the time of the game clock
+ *
+ * Offscreen the clock advances a fixed RENDER_FPS step per frame so the
+ * frames are the same in every run.
+ *
+ * @return Microseconds since an arbitrary point
+ */
+static Uint64 ullGameClock(void);
+
+/**
+ * @brief Check if the next simulation tick is due
+ *
+ * @return TRUE run a tick now
+ * @return FALSE keep drawing the current tick
+ */
+static boolean bTickDue(void);
+
+/**
+ * @brief Run one simulation tick: move the entities, count down the level
+ * time and check the end of the level
+ */
+static void vUpdateGame(void);
+
+/**
+ * @brief Remember the cells of the entities before they move
+ */
+static void vSavePreviousPositions(void);
+
+/**
+ * @brief Put back the level saved in gstLevelStart, keeping the lives
+ */
+static void vRestoreLevelStart(void);
+
+/**
+ * @brief Set the entities up before a level is read
+ */
+static void vInitEntities(void);
+
+/**
+ * @brief Copy the state the render needs to a snapshot and publish it
+ */
+static void vPublishGameSnapshot(void);
+
+/**
+ * @brief Point a rules view at the game, the map and the entities in place
+ *
+ * @param pstView Receives the view
+ */
+static void vGetGameView(PSTRUCT_RULE_VIEW pstView);
+
+/**
+ * @brief Write the counters and flags of a view back to the game
+ *
+ * @param kpstView View of the game
+ */
+static void vPutGameView(const STRUCT_RULE_VIEW* kpstView);
+
+/**
+ * @brief Get the fraction of the tick of a snapshot already elapsed
+ *
+ * @param pstSnapshot Snapshot drawn
+ * @return 0 at the tick up to 1 at the next one
+ */
+static float fGetTickAlpha(PSTRUCT_SNAPSHOT pstSnapshot);
+
+/**
+ * @brief Draw a sprite of an entity between its previous and current cell
+ *
+ * @param pstEntity Entity
+ * @param iSpriteIndex Sprite in the entity sprite sheet
+ * @param fAlpha Fraction of the tick elapsed, 0 previous cell, 1 current
+ */
+static void vDrawEntity(PSTRUCT_ENTITY pstEntity, int iSpriteIndex, float fAlpha);
+
+/**
+ * @brief Get the position an entity is drawn at
+ *
+ * @param pstEntity Entity
+ * @param fAlpha Fraction of the tick elapsed
+ * @param pfCol Receives the map col, may be fractional
+ * @param pfRow Receives the map row, may be fractional
+ */
+static void vGetEntityPosition(PSTRUCT_ENTITY pstEntity, float fAlpha, float* pfCol, float* pfRow);
+
+/**
+ * @brief Draw the minimap with the entities and the visible area
+ *
+ * @param pstSnapshot Simulation state drawn
+ */
+static void vDrawMinimap(PSTRUCT_SNAPSHOT pstSnapshot);
+
+/**
+ * @brief Copy a sprite to a cell position that may be fractional
+ *
+ * @param pstTexture Sprite sheet texture
+ * @param pstSrcRect Sprite in the texture
+ * @param fCol Map col
+ * @param fRow Map row
  */
-static PFNMOVEMENTS gpaMovements[] = {
-  vUp,
-  vLeft,
-  vDown,
-  vRight
+static void vCopyToCell(SDL_Texture* pstTexture, const SDL_Rect* pstSrcRect, float fCol, float fRow);
+
+/**
+ * @var gullNextTick
+ * @brief Game clock time of the next simulation tick, 0 restarts the clock
+ */
+static Uint64 gullNextTick = 0;
+
+/**
+ * @var gullCtFrames
+ * @brief Frames drawn, drives the game clock offscreen
+ */
+static Uint64 gullCtFrames = 0;
+
+/**
+ * @var guiLevelSerial
+ * @brief Incremented each time a level is loaded
+ */
+static Uint32 guiLevelSerial = 0;
+
+/**
+ * @var guiDrawnLevelSerial
+ * @brief Level of the textures in the render cache
+ */
+static Uint32 guiDrawnLevelSerial = 0;
+
+/**
+ * @var gstLevelStart
+ * @brief Game right after the last level was read, restarting the level
+ * copies it back instead of reading the file again
+ */
+static STRUCT_GAME_STATE gstLevelStart;
+
+/**
+ * @var gkapszSoundFile
+ * @brief Sound effect files, indexed by ENUM_SOUND
+ */
+static const char* gkapszSoundFile[SOUND_COUNT] = {
+  POWER_UP_SOUND_FILE,
+  LEVEL_UP_SOUND_FILE,
+  GAME_WIN_SOUND_FILE,
+  HERO_DEATH_SOUND_FILE,
+  GHOST_DEATH_SOUND_FILE,
+  GAME_OVER_SOUND_FILE
 };
 
-boolean bInitGame(void) {
-  char szMusicPath[512] = "";
-  char szSoundPath[512] = "";
+/**
+ * @var giHeroAsset
+ * @brief Asset handle of the hero sprite sheet
+ */
+static int giHeroAsset = -1;
 
-  memset(szMusicPath, 0x00, sizeof(szMusicPath));
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
+/**
+ * @var giHeartAsset
+ * @brief Asset handle of the heart sprite sheet
+ */
+static int giHeartAsset = -1;
 
-  sprintf(szMusicPath, "%s%cmusic%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, GAME_MUSIC_FILE);
-  gpstMusic = Mix_LoadMUS(szMusicPath);
-  if ( !gpstMusic ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadMUS: [%s]!", Mix_GetError());
-  }
+/**
+ * @var giGhostAsset
+ * @brief Asset handle of the ghost sprite sheet
+ */
+static int giGhostAsset = -1;
 
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, POWER_UP_SOUND_FILE);
-  gpstPowerUpSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstPowerUpSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
-  }
+/**
+ * @var gapstSpriteSheet
+ * @brief Sprite sheet of each entity type, owned by the render side
+ */
+static PSTRUCT_SPRITE_SHEET gapstSpriteSheet[ENTITY_TYPE_COUNT];
 
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, LEVEL_UP_SOUND_FILE);
-  gpstLevelUpSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstLevelUpSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
-  }
+boolean bInitGame(void) {
+  char szPath[_MAX_PATH + 64] = "";
+  int aiSoundAsset[SOUND_COUNT];
+  int iMusicAsset = -1;
+  boolean bLoaded = FALSE;
+  int ii = 0;
 
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, GAME_WIN_SOUND_FILE);
-  gpstGameWinSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstGameWinSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
+  memset(szPath, 0x00, sizeof(szPath));
+  vInitSnapshots();
+  /* Nothing would play them, the null backend skips the decoding */
+  for ( ii = 0; ii < SOUND_COUNT; ii++ ) {
+    aiSoundAsset[ii] = -1;
   }
-
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, HERO_DEATH_SOUND_FILE);
-  gpstHeroDeathSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstHeroDeathSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
+  if ( bAudioEnabled() ) {
+    sprintf(szPath, "%s%cmusic%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, GAME_MUSIC_FILE);
+    iMusicAsset = iQueueAsset(ASSET_MUSIC, szPath);
+    for ( ii = 0; ii < SOUND_COUNT; ii++ ) {
+      sprintf(szPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, gkapszSoundFile[ii]);
+      aiSoundAsset[ii] = iQueueAsset(ASSET_SOUND, szPath);
+    }
   }
-
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, GHOST_DEATH_SOUND_FILE);
-  gpstGhostDeathSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstGhostDeathSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
+  sprintf(szPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, HERO_SPRITE_SHEET);
+  giHeroAsset = iQueueAsset(ASSET_IMAGE, szPath);
+  sprintf(szPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, HEART_SPRITE_SHEET);
+  giHeartAsset = iQueueAsset(ASSET_IMAGE, szPath);
+  sprintf(szPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, GHOST_SPRITE_SHEET);
+  giGhostAsset = iQueueAsset(ASSET_IMAGE, szPath);
+
+  vTimelineBegin("bLoadAssets");
+  bLoadAssets(vDrawLoadingScreen);
+  vTimelineEnd("bLoadAssets");
+
+  gpstMusic = pstTakeAssetMusic(iMusicAsset);
+  for ( ii = 0; ii < SOUND_COUNT; ii++ ) {
+    vSetSound((ENUM_SOUND) ii, pstTakeAssetSound(aiSoundAsset[ii]));
   }
 
-  memset(szSoundPath, 0x00, sizeof(szSoundPath));
-  sprintf(szSoundPath, "%s%csfx%c%s", gstCmdLine.szAudioDir, DIR_SEPARATOR, DIR_SEPARATOR, GAME_OVER_SOUND_FILE);
-  gpstGameOverSound = Mix_LoadWAV(szSoundPath);
-  if ( !gpstGameOverSound ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure in the MixLoadWAV: [%s]!", Mix_GetError());
+  vTimelineBegin("bLoadSprites");
+  bLoaded = bLoadSprites();
+  vTimelineEnd("bLoadSprites");
+  if ( !bLoaded ) {
+    if ( DEBUG_FATAL ) vTrace("bInitGame - F: Fatal error in bLoadSprites");
+    vDestroyAssets();
+    return FALSE;
   }
+  vDestroyAssets();
 
   return TRUE;
 }
 
 boolean bLoadSprites(void) {
+  gapstSpriteSheet[ENTITY_HERO] = pstCreateSpriteSheet(pstTakeAssetTexture(giHeroAsset), 48, 48, 16, 4);
+  gpstHeartSpriteSheet = pstCreateSpriteSheet(pstTakeAssetTexture(giHeartAsset), 48, 48, 1, 1);
+  /* The ghosts only differ in the map, they share the sheet */
+  gapstSpriteSheet[ENTITY_GHOST] = pstCreateSpriteSheet(pstTakeAssetTexture(giGhostAsset), 20, 20, 4, 2);
+  return TRUE;
+}
+
+void vDestroySprites(void) {
+  int ii = 0;
+  vFreeSpriteSheet(gpstHeartSpriteSheet);
+  gpstHeartSpriteSheet = NULL;
+  for ( ii = 0; ii < ENTITY_TYPE_COUNT; ii++ ) {
+    vFreeSpriteSheet(gapstSpriteSheet[ii]);
+    gapstSpriteSheet[ii] = NULL;
+  }
+}
+
+static void vInitEntities(void) {
   int ii = 0;
   char achLetter[MAX_GHOSTS] = { 'R', 'G', 'B', 'A' };
-  char szHeroSpriteSheetPath[_MAX_PATH] = "";
-  char szGhostSpriteSheetPath[_MAX_PATH] = "";
-  char szHeartSpriteSheetPath[_MAX_PATH] = "";
-  memset(szHeroSpriteSheetPath, 0x00, sizeof(szHeroSpriteSheetPath));
-  memset(szGhostSpriteSheetPath, 0x00, sizeof(szGhostSpriteSheetPath));
-  memset(szHeartSpriteSheetPath, 0x00, sizeof(szHeartSpriteSheetPath));
-  sprintf(szHeroSpriteSheetPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, HERO_SPRITE_SHEET);
-  gstPlayer.pstSpriteSheet = pstLoadSpriteSheet(gpstRenderer, szHeroSpriteSheetPath, 48, 48, 16, 4);
   gstPlayer.iLives = HERO_LIVES;
   gstPlayer.iMovementDirection = NONE_MOVEMENT;
-  sprintf(szHeartSpriteSheetPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, HEART_SPRITE_SHEET);
-  gpstHeartSpriteSheet = pstLoadSpriteSheet(gpstRenderer, szHeartSpriteSheetPath, 48, 48, 1, 1);
-  sprintf(szGhostSpriteSheetPath, "%s%c%s", gstCmdLine.szImgDir, DIR_SEPARATOR, GHOST_SPRITE_SHEET);
+  gstPlayer.eType = ENTITY_HERO;
   for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
-    gastGhost[ii].pstSpriteSheet = pstLoadSpriteSheet(gpstRenderer, szGhostSpriteSheetPath, 20, 20, 4, 2);
     gastGhost[ii].chLetter = achLetter[ii];
     gastGhost[ii].chOldXY = ' ';
     gastGhost[ii].iMovementDirection = LEFT_MOVEMENT;
-  }
-  return TRUE;
-}
-
-void vDestroySprites(void) {
-  int ii = 0;
-  vFreeSpriteSheet(gstPlayer.pstSpriteSheet);
-  vFreeSpriteSheet(gpstHeartSpriteSheet);
-  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
-    vFreeSpriteSheet(gastGhost[ii].pstSpriteSheet);
+    gastGhost[ii].eType = ENTITY_GHOST;
   }
 }
 
 void vDestroyGame(void) {
   vDestroySprites();
-  if ( gpstGameOverSound ) {
-    Mix_FreeChunk(gpstGameOverSound);
-    gpstGameOverSound = NULL;
-  }
-  if ( gpstGhostDeathSound ) {
-    Mix_FreeChunk(gpstGhostDeathSound);
-    gpstGhostDeathSound = NULL;
-  }
-  if ( gpstHeroDeathSound ) {
-    Mix_FreeChunk(gpstHeroDeathSound);
-    gpstHeroDeathSound = NULL;
-  }
-  if ( gpstGameWinSound ) {
-    Mix_FreeChunk(gpstGameWinSound);
-    gpstGameWinSound = NULL;
-  }
-  if ( gpstLevelUpSound ) {
-    Mix_FreeChunk(gpstLevelUpSound);
-    gpstLevelUpSound = NULL;
-  }
-  if ( gpstPowerUpSound ) {
-    Mix_FreeChunk(gpstPowerUpSound);
-    gpstPowerUpSound = NULL;
-  }
+  vDestroySounds();
   if ( gpstMusic ) {
     Mix_FreeMusic(gpstMusic);
     gpstMusic = NULL;
@@ -182,7 +309,7 @@ void vDestroyGame(void) {
 
 boolean bLoadLevel(const char *kpszMapFile) {
   FILE *fpMap = NULL;
-  char szFileLine[64] = "";
+  char szFileLine[MAP_COL + 3] = "";
   int iRow = 0;
   int iLives = gstPlayer.iLives > 0 ? gstPlayer.iLives : HERO_LIVES;
 
@@ -190,23 +317,27 @@ boolean bLoadLevel(const char *kpszMapFile) {
 
   if ( DEBUG_INFO ) vTrace("bLoadLevel - begin");
 
-  if ( !bLoadSprites() ) {
-    if ( DEBUG_FATAL ) vTrace("bLoadLevel - F: Fatal error in bLoadSprites");
-    return FALSE;
-  }
+  vInitEntities();
   gstPlayer.iLives = iLives;
 
   if ( (fpMap = fopen(kpszMapFile, "r")) == NULL ) {
-    vTrace("F: Impossible to open the file [%s]: %s", kpszMapFile, strerror(errno));
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the file [%s]: %s", kpszMapFile, strerror(errno));
     return FALSE;
   }
-  while ( fgets(szFileLine, sizeof(szFileLine), fpMap) ) {
-    szFileLine[strcspn(szFileLine, "\r\n")] = '\0';
-    sprintf(gszMap[iRow], "%s", szFileLine);
+  memset(gszMap, 0x00, sizeof(gszMap));
+  while ( iRow < MAP_ROW && fgets(szFileLine, sizeof(szFileLine), fpMap) ) {
+    size_t ulLen = strcspn(szFileLine, "\r\n");
+    /* Cells past MAP_COL are cut, the rows have no terminator */
+    memcpy(gszMap[iRow], szFileLine, ulLen < MAP_COL ? ulLen : MAP_COL);
+    if ( szFileLine[ulLen] == '\0' && ulLen == sizeof(szFileLine) - 1 ) {
+      int iCh = 0;
+      while ( (iCh = fgetc(fpMap)) != EOF && iCh != '\n' );
+    }
     iRow++;
   }
   fclose(fpMap);
   fpMap = NULL;
+  guiLevelSerial++;
   vGetInitialPlayerPosition();
   vGetInitialGhostsPosition();
   vGetTotalScoreLevel();
@@ -218,18 +349,32 @@ boolean bLoadLevel(const char *kpszMapFile) {
 
 void vMainMenu(void) {
   char szLevel[512] = "";
+  boolean bLoaded = FALSE;
   memset(szLevel, 0x00, sizeof(szLevel));
   if ( DEBUG_INFO ) vTrace("vMainMenu - begin");
   gstPlayer.iMovementDirection = NONE_MOVEMENT;
   gbGameOver = FALSE;
   /* TODO: Criar o menu aqui */
-  Mix_PlayMusic(gpstMusic, -1);
-  sprintf(szLevel, "%s%c%d.txt", gstCmdLine.szLevelDir, DIR_SEPARATOR, giLevel);
-  if ( !bLoadLevel(szLevel) ) {
-    vTrace("Error loading the level [%s]", szLevel);
-    return;
+  vPlayMusic(gpstMusic);
+  if ( gstLevelStart.uiMagic == STATE_MAGIC && gstLevelStart.iLevel == giLevel ) {
+    vRestoreLevelStart();
+  }
+  else {
+    sprintf(szLevel, "%s%c%d.txt", gstCmdLine.szLevelDir, DIR_SEPARATOR, giLevel);
+    vTimelineBegin("bLoadLevel");
+    bLoaded = bLoadLevel(szLevel);
+    vTimelineEnd("bLoadLevel");
+    if ( !bLoaded ) {
+      if ( DEBUG_ERROR ) vTrace("Error loading the level [%s]", szLevel);
+      return;
+    }
+    vSaveGameState(&gstLevelStart);
   }
   geStatus = STATUS_RUN;
+  gullNextTick = 0;
+  /* Going back past the start of the level would replay its end */
+  vResetRewind();
+  vPushRewindTick();
   if ( DEBUG_INFO ) vTrace("vMainMenu - end");
   return;
 }
@@ -237,7 +382,12 @@ void vMainMenu(void) {
 
 
 void vHandleEvents(void) {
-  if ( giCurrentLevelTime == 0 ) return;
+  if ( bOverlayActive() ) {
+    /* The overlay takes the key up */
+    vPostRewind(FALSE);
+    vHandleOverlayEvents();
+    return;
+  }
   while ( SDL_PollEvent(&gunEvent) ) {
     switch ( gunEvent.type ) {
       case SDL_QUIT: {
@@ -248,49 +398,74 @@ void vHandleEvents(void) {
         switch ( gunEvent.key.keysym.sym ) {
           case SDLK_UP:
           case SDLK_w: {
-            gstPlayer.iMovementDirection = UP_MOVEMENT;
-            geStatus = STATUS_RUN;
+            vPostMove(UP_MOVEMENT);
             break;
           }
           case SDLK_LEFT:
           case SDLK_a: {
-            gstPlayer.iMovementDirection = LEFT_MOVEMENT;
-            geStatus = STATUS_RUN;
+            vPostMove(LEFT_MOVEMENT);
             break;
           }
           case SDLK_DOWN:
           case SDLK_s: {
-            gstPlayer.iMovementDirection = DOWN_MOVEMENT;
-            geStatus = STATUS_RUN;
+            vPostMove(DOWN_MOVEMENT);
             break;
           }
           case SDLK_RIGHT:
           case SDLK_d: {
-            gstPlayer.iMovementDirection = RIGHT_MOVENT;
-            geStatus = STATUS_RUN;
+            vPostMove(RIGHT_MOVENT);
+            break;
+          }
+          case SDLK_F2: {
+            vPrintFrameStats(stdout);
+            vPrintGfxStats(stdout);
+            break;
+          }
+          case SDLK_F3: {
+            vToggleProfileOverlay();
+            break;
+          }
+          case SDLK_BACKSPACE: {
+            vPostRewind(TRUE);
+            break;
+          }
+          case SDLK_F5: {
+            vPostQuickSave();
+            break;
+          }
+          case SDLK_F9: {
+            vPostQuickLoad();
+            break;
+          }
+          case SDLK_PLUS:
+          case SDLK_EQUALS:
+          case SDLK_KP_PLUS: {
+            vZoomCamera(1);
+            break;
+          }
+          case SDLK_MINUS:
+          case SDLK_KP_MINUS: {
+            vZoomCamera(-1);
+            break;
+          }
+          case SDLK_m: {
+            vToggleMinimap();
             break;
           }
           case SDLK_SPACE: {
-            geStatus = (geStatus == STATUS_IDLE ? STATUS_IDLE : (geStatus == STATUS_PAUSE ? STATUS_RUN : STATUS_PAUSE));
+            vPostPause();
             break;
           }
           default: break;
         }
         break;
+      }
+      case SDL_KEYUP: {
+        if ( gunEvent.key.keysym.sym == SDLK_BACKSPACE ) vPostRewind(FALSE);
+        break;
       }
           case SDL_WINDOWEVENT: {
-            if ( gunEvent.window.event == SDL_WINDOWEVENT_RESIZED ) {
-              int iNewWidth = gunEvent.window.data1;
-              int iNewHeight = gunEvent.window.data2;
-
-              if ( iNewWidth < WINDOW_WIDTH || iNewHeight < WINDOW_HEIGHT ) {
-                SDL_SetWindowSize(gpstWindow, giWindowWidth, giWindowHeight);
-              }
-              else {
-                giWindowWidth = iNewWidth;
-                giWindowHeight = iNewHeight;
-              }
-            }
+            vHandleWindowEvent();
             break;
           }
           default: break;
@@ -298,218 +473,230 @@ void vHandleEvents(void) {
   }
 }
 
-void vDrawMap(void) {
+void vDrawMap(PSTRUCT_SNAPSHOT pstSnapshot) {
   int iRow = 0;
   int iCol = 0;
-  int iCellWidth = giWindowWidth / MAP_COL;
-  int iCellHeight = giWindowHeight / MAP_ROW;
-  SDL_SetRenderDrawColor(gpstRenderer, 0, 0, 0, 0);
-  SDL_RenderClear(gpstRenderer);
-  for ( iRow = 0; iRow < MAP_ROW; iRow++ ) {
-    for ( iCol = 0; iCol < MAP_COL; iCol++ ) {
-      SDL_Rect stRect;
-      stRect.x = iCol * iCellWidth;
-      stRect.y = iRow * iCellHeight;
-      stRect.w = iCellWidth;
-      stRect.h = iCellHeight;
-
-      if ( gszMap[iRow][iCol] == '#' ) {
-        SDL_SetRenderDrawColor(gpstRenderer, 0, 0, 255, 255);
-        SDL_RenderFillRect(gpstRenderer, &stRect);
-      }
-      else if ( gszMap[iRow][iCol] == '.' ) {
-        int iCenterX = stRect.x + stRect.w / 2;
-        int iCenterY = stRect.y + stRect.h / 2;
-        int iRadius = (iCellWidth < iCellHeight ? iCellWidth : iCellHeight) / 5;
-        int iY = 0;
-        int iX = 0;
-        SDL_SetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
-        for ( iY = -iRadius; iY <= iRadius; iY++ ) {
-          for ( iX = -iRadius; iX <= iRadius; iX++ ) {
-            if ( iX * iX + iY * iY <= iRadius * iRadius ) {
-              SDL_RenderDrawPoint(gpstRenderer, iCenterX + iX, iCenterY + iY);
-            }
-          }
-        }
-      }
-      else if ( gszMap[iRow][iCol] == 'O' ) {
-        int iCenterX = stRect.x + stRect.w / 2;
-        int iCenterY = stRect.y + stRect.h / 2;
-        int iRadius = (iCellWidth < iCellHeight ? iCellWidth : iCellHeight) / 3;
-        int iY = 0;
-        int iX = 0;
-        SDL_SetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
-        for ( iY = -iRadius; iY <= iRadius; iY++ ) {
-          for ( iX = -iRadius; iX <= iRadius; iX++ ) {
-            if ( iX * iX + iY * iY <= iRadius * iRadius ) {
-              SDL_RenderDrawPoint(gpstRenderer, iCenterX + iX, iCenterY + iY);
-            }
-          }
-        }
-      }
-      else if ( gszMap[iRow][iCol] == 'H' ) {
-        int iSpriteIndex = -1;
-        switch ( gstPlayer.iMovementDirection ) {
-          case UP_MOVEMENT  : iSpriteIndex = HERO_UP_SPRITE   ; break;
-          case LEFT_MOVEMENT: iSpriteIndex = HERO_LEFT_SPRITE ; break;
-          case RIGHT_MOVENT : iSpriteIndex = HERO_RIGHT_SPRITE; break;
-          case DOWN_MOVEMENT:
-          case NONE_MOVEMENT:
-          default           : iSpriteIndex = HERO_DOWN_SPRITE; break;
-        }
-        SDL_RenderCopy(gpstRenderer, gstPlayer.pstSpriteSheet->pstTextures, &gstPlayer.pstSpriteSheet->pstRects[iSpriteIndex], &stRect);
-      }
-      else if ( gszMap[iRow][iCol] == 'R' ) {
-        int iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_LEFT_SPRITE : GHOST_NORMAL_LEFT_SPRITE;
-        if ( gastGhost[0].iMovementDirection != LEFT_MOVEMENT ){
-          iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_RIGHT_SPRITE : GHOST_NORMAL_RIGHT_SPRITE;
-        }
-        SDL_RenderCopy(gpstRenderer, gastGhost[0].pstSpriteSheet->pstTextures, &gastGhost[0].pstSpriteSheet->pstRects[iSpriteIndex], &stRect);
-      }
-      else if ( gszMap[iRow][iCol] == 'G' ) {
-        int iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_LEFT_SPRITE : GHOST_NORMAL_LEFT_SPRITE;
-        if ( gastGhost[1].iMovementDirection == RIGHT_MOVENT ){
-          iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_RIGHT_SPRITE : GHOST_NORMAL_RIGHT_SPRITE;
-        }
-        SDL_RenderCopy(gpstRenderer, gastGhost[1].pstSpriteSheet->pstTextures, &gastGhost[1].pstSpriteSheet->pstRects[iSpriteIndex], &stRect);
-      }
-      else if ( gszMap[iRow][iCol] == 'B' ) {
-        int iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_LEFT_SPRITE : GHOST_NORMAL_LEFT_SPRITE;
-        if ( gastGhost[2].iMovementDirection == RIGHT_MOVENT ){
-          iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_RIGHT_SPRITE : GHOST_NORMAL_RIGHT_SPRITE;
-        }
-        SDL_RenderCopy(gpstRenderer, gastGhost[2].pstSpriteSheet->pstTextures, &gastGhost[2].pstSpriteSheet->pstRects[iSpriteIndex], &stRect);
+  int ii = 0;
+  Uint32 uiAnimMs = 0;
+  float fAlpha = fGetTickAlpha(pstSnapshot);
+  float fHeroCol = 0.0f;
+  float fHeroRow = 0.0f;
+  SDL_Texture* pstDotTexture = NULL;
+  SDL_Texture* pstPowerTexture = NULL;
+  Uint64 ullAnimClock = ullGameClock() / 1000;
+  uiAnimMs = (Uint32) ullAnimClock;
+
+  vGetEntityPosition(&pstSnapshot->astEntity[0], fAlpha, &fHeroCol, &fHeroRow);
+  vUpdateCamera(fHeroCol, fHeroRow);
+  pstDotTexture = pstGetDotTexture();
+  pstPowerTexture = pstGetPowerTexture();
+
+  iGfxSetRenderDrawColor(gpstRenderer, 0, 0, 0, 0);
+  iGfxRenderClear(gpstRenderer);
+
+  /* Walls: only the chunks under the camera */
+  for ( iRow = gstCamera.iFirstRow / WALL_CHUNK_CELLS; iRow <= gstCamera.iLastRow / WALL_CHUNK_CELLS; iRow++ ) {
+    for ( iCol = gstCamera.iFirstCol / WALL_CHUNK_CELLS; iCol <= gstCamera.iLastCol / WALL_CHUNK_CELLS; iCol++ ) {
+      SDL_Texture* pstChunk = pstGetWallChunk(pstSnapshot->aszMap, iRow, iCol);
+      int iCtRows = MAP_ROW - iRow * WALL_CHUNK_CELLS < WALL_CHUNK_CELLS ? MAP_ROW - iRow * WALL_CHUNK_CELLS : WALL_CHUNK_CELLS;
+      int iCtCols = MAP_COL - iCol * WALL_CHUNK_CELLS < WALL_CHUNK_CELLS ? MAP_COL - iCol * WALL_CHUNK_CELLS : WALL_CHUNK_CELLS;
+      SDL_FRect stChunkRect;
+      if ( !pstChunk ) continue;
+      stChunkRect.x = fCameraX((float) (iCol * WALL_CHUNK_CELLS));
+      stChunkRect.y = fCameraY((float) (iRow * WALL_CHUNK_CELLS));
+      stChunkRect.w = (float) iCtCols * gstCamera.fCellWidth;
+      stChunkRect.h = (float) iCtRows * gstCamera.fCellHeight;
+      iGfxRenderCopyF(gpstRenderer, pstChunk, NULL, &stChunkRect);
+    }
+  }
+
+  /* Dots and powers of the visible cells */
+  for ( iRow = gstCamera.iFirstRow; iRow <= gstCamera.iLastRow; iRow++ ) {
+    for ( iCol = gstCamera.iFirstCol; iCol <= gstCamera.iLastCol; iCol++ ) {
+      SDL_Texture* pstItem = NULL;
+      SDL_FRect stRect;
+
+      if ( pstSnapshot->aszMap[iRow][iCol] == '.' ) {
+        pstItem = pstDotTexture;
       }
-      else if ( gszMap[iRow][iCol] == 'A' ) {
-        int iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_LEFT_SPRITE : GHOST_NORMAL_LEFT_SPRITE;
-        if ( gastGhost[3].iMovementDirection == RIGHT_MOVENT ){
-          iSpriteIndex = giPowersCollected > 0 ? GHOST_SCARED_RIGHT_SPRITE : GHOST_NORMAL_RIGHT_SPRITE;
-        }
-        SDL_RenderCopy(gpstRenderer, gastGhost[3].pstSpriteSheet->pstTextures, &gastGhost[3].pstSpriteSheet->pstRects[iSpriteIndex], &stRect);
+      else if ( pstSnapshot->aszMap[iRow][iCol] == 'O' ) {
+        pstItem = pstPowerTexture;
       }
       else {
+        /* Walls are in the chunks, entities are drawn below */
         continue;
       }
+      stRect.x = fCameraX((float) iCol);
+      stRect.y = fCameraY((float) iRow);
+      stRect.w = gstCamera.fCellWidth;
+      stRect.h = gstCamera.fCellHeight;
+      iGfxRenderCopyF(gpstRenderer, pstItem, NULL, &stRect);
     }
   }
+
+  /* The item a ghost is over shows up while it slides away */
+  for ( ii = 1; ii < SNAPSHOT_ENTITIES; ii++ ) {
+    PSTRUCT_ENTITY pstGhost = &pstSnapshot->astEntity[ii];
+    SDL_FRect stRect;
+    if ( pstGhost->iX < gstCamera.iFirstCol || pstGhost->iX > gstCamera.iLastCol ) continue;
+    if ( pstGhost->iY < gstCamera.iFirstRow || pstGhost->iY > gstCamera.iLastRow ) continue;
+    stRect.x = fCameraX((float) pstGhost->iX);
+    stRect.y = fCameraY((float) pstGhost->iY);
+    stRect.w = gstCamera.fCellWidth;
+    stRect.h = gstCamera.fCellHeight;
+    if ( pstGhost->chOldXY == '.' ) {
+      iGfxRenderCopyF(gpstRenderer, pstDotTexture, NULL, &stRect);
+    }
+    else if ( pstGhost->chOldXY == 'O' ) {
+      iGfxRenderCopyF(gpstRenderer, pstPowerTexture, NULL, &stRect);
+    }
+  }
+
+  for ( ii = 0; ii < SNAPSHOT_ENTITIES; ii++ ) {
+    PSTRUCT_ENTITY pstEntity = &pstSnapshot->astEntity[ii];
+    ENUM_ANIM_STATE eState = ANIM_WALK;
+    /* One cell of margin for the slide and the tunnel */
+    if ( pstEntity->iX < gstCamera.iFirstCol - 1 || pstEntity->iX > gstCamera.iLastCol + 1 ) continue;
+    if ( pstEntity->iY < gstCamera.iFirstRow - 1 || pstEntity->iY > gstCamera.iLastRow + 1 ) continue;
+    /* Facing a wall the entity stands still */
+    if ( pstEntity->iX == pstEntity->iPrevX && pstEntity->iY == pstEntity->iPrevY ) eState = ANIM_IDLE;
+    if ( pstEntity->eType == ENTITY_GHOST && pstSnapshot->iPowersCollected > 0 ) eState = ANIM_SCARED;
+    vDrawEntity(pstEntity, iGetAnimationSprite(pstEntity, eState, uiAnimMs), fAlpha);
+  }
+
+  if ( gstCamera.bMinimap ) vDrawMinimap(pstSnapshot);
 }
 
-void vDrawGameInfo(void) {
+static void vDrawMinimap(PSTRUCT_SNAPSHOT pstSnapshot) {
+  SDL_Texture* pstMinimap = pstGetMinimap(pstSnapshot->aszMap);
+  SDL_FRect stRect;
+  SDL_FRect stView;
+  float fTexelW = (float) MINIMAP_SIZE / (float) MAP_COL;
+  float fTexelH = (float) MINIMAP_SIZE / (float) MAP_ROW;
+  int ii = 0;
+
+  stRect.w = (float) MINIMAP_SIZE;
+  stRect.h = (float) MINIMAP_SIZE;
+  stRect.x = (float) (LOGICAL_WIDTH - MINIMAP_SIZE - 10);
+  stRect.y = (float) MINIMAP_TOP;
+  if ( pstMinimap ) iGfxRenderCopyF(gpstRenderer, pstMinimap, NULL, &stRect);
+
+  for ( ii = 0; ii < SNAPSHOT_ENTITIES; ii++ ) {
+    PSTRUCT_ENTITY pstEntity = &pstSnapshot->astEntity[ii];
+    SDL_FRect stDot;
+    if ( pstEntity->iX < 0 || pstEntity->iY < 0 ) continue;
+    stDot.x = stRect.x + (float) pstEntity->iX * fTexelW;
+    stDot.y = stRect.y + (float) pstEntity->iY * fTexelH;
+    stDot.w = fTexelW < 2.0f ? 2.0f : fTexelW;
+    stDot.h = fTexelH < 2.0f ? 2.0f : fTexelH;
+    if ( pstEntity->eType == ENTITY_HERO ) {
+      iGfxSetRenderDrawColor(gpstRenderer, 255, 255, 0, 255);
+    }
+    else {
+      iGfxSetRenderDrawColor(gpstRenderer, 255, 0, 0, 255);
+    }
+    iGfxRenderFillRectF(gpstRenderer, &stDot);
+  }
+
+  /* Part of the map on the screen */
+  stView.x = stRect.x + (float) gstCamera.iFirstCol * fTexelW;
+  stView.y = stRect.y + (float) gstCamera.iFirstRow * fTexelH;
+  stView.w = (float) (gstCamera.iLastCol - gstCamera.iFirstCol + 1) * fTexelW;
+  stView.h = (float) (gstCamera.iLastRow - gstCamera.iFirstRow + 1) * fTexelH;
+  iGfxSetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
+  iGfxRenderDrawRectF(gpstRenderer, &stView);
+}
+
+void vDrawGameInfo(PSTRUCT_SNAPSHOT pstSnapshot) {
   STRUCT_HUD stGameInfoHUD;
   STRUCT_HUD stLiveHUD;
   STRUCT_HUD stClockHUD;
-  TTF_Font* pstFont = NULL;
 
   memset(&stGameInfoHUD, 0x00, sizeof(stGameInfoHUD));
   memset(&stLiveHUD    , 0x00, sizeof(stLiveHUD    ));
   memset(&stClockHUD    , 0x00, sizeof(stClockHUD    ));
 
-  stGameInfoHUD.iFontSize = 20;
+  if ( (stGameInfoHUD.pstAtlas = pstGetGlyphAtlas(HUD_FONT_SIZE)) == NULL ) {
+    return;
+  }
   stGameInfoHUD.stTextColor.r = 255;
   stGameInfoHUD.stTextColor.g = 255;
   stGameInfoHUD.stTextColor.b = 255;
   stGameInfoHUD.stTextColor.a = 255;
 
-  sprintf(stGameInfoHUD.szFont, "%s%c%s", gstCmdLine.szFontDir, DIR_SEPARATOR, FONT_NAME);
-  if ( (pstFont = TTF_OpenFont(stGameInfoHUD.szFont, stGameInfoHUD.iFontSize)) == NULL ) {
-    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", stGameInfoHUD.szFont, TTF_GetError());
-    return;
-  }
-
   sprintf(
     stGameInfoHUD.szText,
     "Level: %d/%d | Level Score: %d | Total Game Score: %d | Power: %d",
-    giLevel, MAX_LEVEL, giCurrentLevelScore, giTotalGameScore, giPowersCollected
+    pstSnapshot->iLevel, MAX_LEVEL, pstSnapshot->iCurrentLevelScore, pstSnapshot->iTotalGameScore, pstSnapshot->iPowersCollected
   );
 
-  stGameInfoHUD.pstSurface = TTF_RenderText_Blended(pstFont, stGameInfoHUD.szText, stGameInfoHUD.stTextColor);
-  stGameInfoHUD.pstTexture = SDL_CreateTextureFromSurface(gpstRenderer, stGameInfoHUD.pstSurface);
-  stGameInfoHUD.stRect.h = stGameInfoHUD.pstSurface->h;
-  stGameInfoHUD.stRect.w = stGameInfoHUD.pstSurface->w;
+  stGameInfoHUD.stRect.h = stGameInfoHUD.pstAtlas->iHeight;
+  stGameInfoHUD.stRect.w = iGlyphTextWidth(stGameInfoHUD.pstAtlas, stGameInfoHUD.szText);
   stGameInfoHUD.stRect.x = 0;
-  stGameInfoHUD.stRect.y = giWindowHeight - stGameInfoHUD.stRect.h - 10;
-  SDL_RenderDrawRect(gpstRenderer, &stGameInfoHUD.stRect);
-  SDL_RenderCopy(gpstRenderer, stGameInfoHUD.pstTexture, NULL, &stGameInfoHUD.stRect);
-
-  SDL_FreeSurface(stGameInfoHUD.pstSurface);
-  SDL_DestroyTexture(stGameInfoHUD.pstTexture);
+  stGameInfoHUD.stRect.y = LOGICAL_HEIGHT - stGameInfoHUD.stRect.h - 10;
+  iGfxRenderDrawRect(gpstRenderer, &stGameInfoHUD.stRect);
+  iDrawGlyphText(gpstRenderer, stGameInfoHUD.pstAtlas, stGameInfoHUD.stRect.x, stGameInfoHUD.stRect.y, stGameInfoHUD.szText, stGameInfoHUD.stTextColor);
 
   /* Show lives */
-  if ( gpstHeartSpriteSheet->pstTextures ) {
+  if ( gpstHeartSpriteSheet && gpstHeartSpriteSheet->pstTextures ) {
     static const int kiPadding = 5;
     int ii = 0;
 
-    sprintf(stLiveHUD.szFont, "%s", stGameInfoHUD.szFont);
-    stLiveHUD.iFontSize = stGameInfoHUD.iFontSize;
+    stLiveHUD.pstAtlas = stGameInfoHUD.pstAtlas;
     stLiveHUD.stTextColor = stGameInfoHUD.stTextColor;
 
     sprintf(stLiveHUD.szText, "Lives:");
 
-    stLiveHUD.pstSurface = TTF_RenderText_Blended(pstFont, stLiveHUD.szText, stLiveHUD.stTextColor);
-    stLiveHUD.pstTexture = SDL_CreateTextureFromSurface(gpstRenderer, stLiveHUD.pstSurface);
-
-    stLiveHUD.stTextRect.h = stLiveHUD.pstSurface->h;
-    stLiveHUD.stTextRect.w = stLiveHUD.pstSurface->w;
+    stLiveHUD.stTextRect.h = stLiveHUD.pstAtlas->iHeight;
+    stLiveHUD.stTextRect.w = iGlyphTextWidth(stLiveHUD.pstAtlas, stLiveHUD.szText);
     stLiveHUD.stTextRect.x = 0;
     stLiveHUD.stTextRect.y = 0;
 
-    SDL_RenderDrawRect(gpstRenderer, &stLiveHUD.stTextRect);
-    SDL_RenderCopy(gpstRenderer, stLiveHUD.pstTexture, NULL, &stLiveHUD.stTextRect);
+    iGfxRenderDrawRect(gpstRenderer, &stLiveHUD.stTextRect);
+    iDrawGlyphText(gpstRenderer, stLiveHUD.pstAtlas, stLiveHUD.stTextRect.x, stLiveHUD.stTextRect.y, stLiveHUD.szText, stLiveHUD.stTextColor);
 
     stLiveHUD.stRect.w = 24;
     stLiveHUD.stRect.h = 24;
     stLiveHUD.stRect.y = 0;
-    for ( ii = 0; ii < gstPlayer.iLives; ii++ ) {
-      stLiveHUD.stRect.x = (stLiveHUD.stTextRect.w-30) + ((stLiveHUD.stRect.w + kiPadding) * (gstPlayer.iLives - ii));
-      SDL_RenderCopy(gpstRenderer, gpstHeartSpriteSheet->pstTextures, NULL, &stLiveHUD.stRect);
+    for ( ii = 0; ii < pstSnapshot->astEntity[0].iLives; ii++ ) {
+      stLiveHUD.stRect.x = (stLiveHUD.stTextRect.w-30) + ((stLiveHUD.stRect.w + kiPadding) * (pstSnapshot->astEntity[0].iLives - ii));
+      iGfxRenderCopy(gpstRenderer, gpstHeartSpriteSheet->pstTextures, NULL, &stLiveHUD.stRect);
     }
-    SDL_FreeSurface(stLiveHUD.pstSurface);
-    SDL_DestroyTexture(stLiveHUD.pstTexture);
   }
 
   /* Draw clock */
   {
-    int iMinutes = giCurrentLevelTime / 60;
-    int iSeconds = giCurrentLevelTime % 60;
+    int iMinutes = pstSnapshot->iCurrentLevelTime / 60;
+    int iSeconds = pstSnapshot->iCurrentLevelTime % 60;
     int iTextW = 0;
     int iTextH = 0;
     static const int kiPadding = 6;
 
-    sprintf(stClockHUD.szFont, "%s", stGameInfoHUD.szFont);
-    stClockHUD.iFontSize = stGameInfoHUD.iFontSize;
+    stClockHUD.pstAtlas = stGameInfoHUD.pstAtlas;
 
     sprintf(stClockHUD.szText, "%02d:%02d", iMinutes, iSeconds);
 
     stClockHUD.stTextColor.a = 255;
 
-    stClockHUD.pstSurface = TTF_RenderText_Blended(pstFont, stClockHUD.szText, stClockHUD.stTextColor);
-    stClockHUD.pstTexture = SDL_CreateTextureFromSurface(gpstRenderer, stClockHUD.pstSurface);
-
-    iTextW = stClockHUD.pstSurface->w;
-    iTextH = stClockHUD.pstSurface->h;
+    iTextW = iGlyphTextWidth(stClockHUD.pstAtlas, stClockHUD.szText);
+    iTextH = stClockHUD.pstAtlas->iHeight;
 
     stClockHUD.stRect.w = iTextW + kiPadding * 2;
     stClockHUD.stRect.h = iTextH + kiPadding * 2;
-    stClockHUD.stRect.x = giWindowWidth - stClockHUD.stRect.w - 10;
+    stClockHUD.stRect.x = LOGICAL_WIDTH - stClockHUD.stRect.w - 10;
     stClockHUD.stRect.y = 0;
     stClockHUD.stTextRect.w = iTextW;
     stClockHUD.stTextRect.h = iTextH;
     stClockHUD.stTextRect.x = stClockHUD.stRect.x + kiPadding;
     stClockHUD.stTextRect.y = stClockHUD.stRect.y + kiPadding;
-    SDL_SetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
-    SDL_RenderFillRect(gpstRenderer, &stClockHUD.stTextRect);
+    iGfxSetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
+    iGfxRenderFillRect(gpstRenderer, &stClockHUD.stTextRect);
 
-    SDL_SetRenderDrawColor(gpstRenderer, stClockHUD.stTextColor.r, stClockHUD.stTextColor.g, stClockHUD.stTextColor.b, stClockHUD.stTextColor.a);
-    SDL_RenderDrawRect(gpstRenderer, &stClockHUD.stTextRect);
+    iGfxSetRenderDrawColor(gpstRenderer, stClockHUD.stTextColor.r, stClockHUD.stTextColor.g, stClockHUD.stTextColor.b, stClockHUD.stTextColor.a);
+    iGfxRenderDrawRect(gpstRenderer, &stClockHUD.stTextRect);
 
-    SDL_RenderCopy(gpstRenderer, stClockHUD.pstTexture, NULL, &stClockHUD.stTextRect);
-
-    SDL_FreeSurface(stClockHUD.pstSurface);
-    SDL_DestroyTexture(stClockHUD.pstTexture);
+    iDrawGlyphText(gpstRenderer, stClockHUD.pstAtlas, stClockHUD.stTextRect.x, stClockHUD.stTextRect.y, stClockHUD.szText, stClockHUD.stTextColor);
   }
-
-  SDL_RenderPresent(gpstRenderer);
-  TTF_CloseFont(pstFont);
 }
 
 void vResetLevel(void) {
@@ -518,7 +705,6 @@ void vResetLevel(void) {
   geStatus = STATUS_IDLE;
   giCurrentLevelTime = gkaiLevelsTime[giLevel-1];
   giPowersCollected = 0;
-  vDestroySprites();
   gbTimeOut = FALSE;
 }
 
@@ -530,7 +716,6 @@ void vResetGame(void) {
   giPowersCollected = 0;
   geStatus = STATUS_IDLE;
   giCurrentLevelTime = gkaiLevelsTime[0];
-  vDestroySprites();
   gbGameOver = FALSE;
   gbTimeOut = FALSE;
   memset(gszMap    , 0x00, sizeof(gszMap    ));
@@ -543,9 +728,12 @@ void vLevelUp(void) {
   memset(szFooterMsg, 0x00, sizeof(szFooterMsg));
   giLevel++;
   sprintf(szFooterMsg, "Press any key to start level %d", giLevel);
-  Mix_PauseMusic();
-  Mix_PlayChannel(-1, gpstLevelUpSound, 0);
-  vMessageBox("Level UP!", szFooterMsg);
+  vPauseMusic();
+  vQueueSound(SOUND_LEVEL_UP);
+  vShowOverlay("Level UP!", szFooterMsg, vStartNextLevel);
+}
+
+static void vStartNextLevel(void) {
   if ( DEBUG_DETAILS ) {
     vTrace("Score achieved at level [%d]: [%d]", giLevel, giCurrentLevelScore);
     vTrace("Total Game Score: [%d]", giTotalGameScore);
@@ -555,15 +743,12 @@ void vLevelUp(void) {
   giPowersCollected = 0;
   geStatus = STATUS_IDLE;
   giCurrentLevelTime = gkaiLevelsTime[giLevel-1];
-  vDestroySprites();
 }
 
 void vGameOver(void) {
-  vDrawGameInfo();
-  Mix_HaltMusic();
-  Mix_PlayChannel(-1, gpstGameOverSound, 0);
-  vMessageBox("GAME OVER", "Press any key to restart.");
-  vResetGame();
+  vHaltMusic();
+  vQueueSound(SOUND_GAME_OVER);
+  vShowOverlay("GAME OVER", "Press any key to restart.", vResetGame);
 }
 
 void vTimeOut(void) {
@@ -572,23 +757,25 @@ void vTimeOut(void) {
     vGameOver();
   }
   else {
-    vDrawGameInfo();
-    Mix_HaltMusic();
-    Mix_PlayChannel(-1, gpstGameOverSound, 0);
-    vMessageBox("TIME OUT!", "Press any key to restart the level.");
-    vResetLevel();
+    vHaltMusic();
+    vQueueSound(SOUND_GAME_OVER);
+    vShowOverlay("TIME OUT!", "Press any key to restart the level.", vResetLevel);
   }
 }
 
 void vYouWin(void) {
-  Mix_PauseMusic();
-  Mix_PlayChannel(-1, gpstGameWinSound, 0);
-  vMessageBox("You Win =)", "Press any key to restart.");
+  vPauseMusic();
+  vQueueSound(SOUND_GAME_WIN);
   if ( DEBUG_DETAILS ) {
     vTrace("Score achieved at level [%d]: [%d]", giLevel, giCurrentLevelScore);
     vTrace("Total Game Score: [%d]", giTotalGameScore);
   }
-  vResetGame();
+  vShowOverlay("You Win =)", "Press any key to restart.", vResetGame);
+}
+
+static void vResumeGame(void) {
+  vPlayMusic(gpstMusic);
+  geStatus = STATUS_RUN;
 }
 
 boolean bLevelComplete(void) {
@@ -599,129 +786,208 @@ boolean bWinGame(void) {
   return giLevel == MAX_LEVEL;
 }
 
-void vUp(void) {
-  gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-  vSetCoordinates(gstPlayer.iX, gstPlayer.iY-1);
-  vUpdateMap();
+boolean bGameFinished(void) {
+  /* The time out of the last life shows the game over without gbGameOver */
+  return bOverlayActive() && (gbGameOver || (gbTimeOut && gstPlayer.iLives == 0) || (bLevelComplete() && bWinGame()));
 }
 
-void vLeft(void) {
-  gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-  vSetCoordinates(gstPlayer.iX-1, gstPlayer.iY);
-  vUpdateMap();
+static void vGetGameView(PSTRUCT_RULE_VIEW pstView) {
+  pstView->paszMap = gszMap;
+  pstView->pstHero = &gstPlayer;
+  pstView->pastGhost = gastGhost;
+  pstView->iCurrentLevelScore = giCurrentLevelScore;
+  pstView->iTotalCurrentLevelScore = giTotalCurrentLevelScore;
+  pstView->iTotalGameScore = giTotalGameScore;
+  pstView->iCurrentLevelTime = giCurrentLevelTime;
+  pstView->iPowersCollected = giPowersCollected;
+  pstView->bGameOver = gbGameOver;
+  pstView->bTimeOut = gbTimeOut;
+  pstView->bHeroEndMap = gbHeroEndMap;
+  pstView->bGhostEndMap = gbGhostEndMap;
+  pstView->bShowPowerMessage = gbShowPowerMessage;
+  pstView->uiRandomState = uiGetRandomState();
 }
 
-void vDown(void) {
-  gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-  vSetCoordinates(gstPlayer.iX, gstPlayer.iY+1);
-  vUpdateMap();
+static void vPutGameView(const STRUCT_RULE_VIEW* kpstView) {
+  giCurrentLevelScore = kpstView->iCurrentLevelScore;
+  giTotalCurrentLevelScore = kpstView->iTotalCurrentLevelScore;
+  giTotalGameScore = kpstView->iTotalGameScore;
+  giCurrentLevelTime = kpstView->iCurrentLevelTime;
+  giPowersCollected = kpstView->iPowersCollected;
+  gbGameOver = kpstView->bGameOver;
+  gbTimeOut = kpstView->bTimeOut;
+  gbHeroEndMap = kpstView->bHeroEndMap;
+  gbGhostEndMap = kpstView->bGhostEndMap;
+  gbShowPowerMessage = kpstView->bShowPowerMessage;
+  vSetRandomState(kpstView->uiRandomState);
 }
 
-void vRight(void) {
-  gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-  vSetCoordinates(gstPlayer.iX+1, gstPlayer.iY);
-  vUpdateMap();
+void vMove(void) {
+  STRUCT_RULE_EVENTS stEvents;
+  STRUCT_RULE_VIEW stView;
+  int ii = 0;
+
+  memset(&stEvents, 0x00, sizeof(stEvents));
+  /* The rules change the map and the entities of the game in place */
+  vGetGameView(&stView);
+  vProfileBegin(PROFILE_HERO_MOVE);
+  vRuleHeroMove(&stView, &stEvents);
+  vProfileEnd(PROFILE_HERO_MOVE);
+  if ( stView.iCurrentLevelScore != stView.iTotalCurrentLevelScore ) {
+    vProfileBegin(PROFILE_GHOST_MOVE);
+    vRuleGhostsMove(&stView, &stEvents);
+    vProfileEnd(PROFILE_GHOST_MOVE);
+  }
+  vPutGameView(&stView);
+
+  for ( ii = 0; ii < stEvents.iGhostDeaths; ii++ ) vQueueSound(SOUND_GHOST_DEATH);
+  for ( ii = 0; ii < stEvents.iHeroDeaths; ii++ ) vQueueSound(SOUND_HERO_DEATH);
+  for ( ii = 0; ii < stEvents.iPowersUp; ii++ ) vQueueSound(SOUND_POWER_UP);
+  if ( stEvents.bPowerMessage ) vShowOverlay("Wow, would you like to kill a ghost?", "Press any key to continue.", NULL);
 }
 
-static void vHeroMove(void) {
-  if ( gstPlayer.iMovementDirection != NONE_MOVEMENT ) {
-    gpaMovements[gstPlayer.iMovementDirection]();
+static Uint64 ullGameClock(void) {
+  if ( giOffscreenFrames > 0 ) return gullCtFrames * (1000000UL / RENDER_FPS);
+  return ullGetMicroseconds();
+}
+
+static boolean bTickDue(void) {
+  Uint64 ullNow = ullGameClock();
+  boolean bDue = FALSE;
+
+  if ( gullNextTick == 0 ) {
+    gullNextTick = ullNow + TICK_PERIOD_US;
   }
+  else if ( ullNow >= gullNextTick ) {
+    bDue = TRUE;
+    gullNextTick += TICK_PERIOD_US;
+    /* Too far behind (the game was stopped), don't run the lost ticks */
+    if ( gullNextTick <= ullNow ) gullNextTick = ullNow + TICK_PERIOD_US;
+  }
+  return bDue;
 }
 
-static void vGhostsMove(void) {
+Uint32 uiGetTickWaitMs(void) {
+  Uint64 ullNow = ullGameClock();
+  Uint64 ullWaitMs = 0;
+  if ( gullNextTick == 0 ) return 1;
+  if ( ullNow >= gullNextTick ) return 0;
+  ullWaitMs = (gullNextTick - ullNow + 999) / 1000;
+  return (Uint32) ullWaitMs;
+}
+
+static float fGetTickAlpha(PSTRUCT_SNAPSHOT pstSnapshot) {
+  Uint64 ullNow = ullGameClock();
+  float fAlpha = 1.0f;
+  if ( pstSnapshot->ullNextTick == 0 ) return fAlpha;
+  if ( ullNow >= pstSnapshot->ullNextTick ) return fAlpha;
+  fAlpha = 1.0f - (float) (pstSnapshot->ullNextTick - ullNow) / (float) TICK_PERIOD_US;
+  return fAlpha < 0.0f ? 0.0f : fAlpha;
+}
+
+static void vPublishGameSnapshot(void) {
+  PSTRUCT_SNAPSHOT pstSnapshot = pstBeginSnapshot();
   int ii = 0;
-  if ( gstPlayer.iMovementDirection == NONE_MOVEMENT && giCurrentLevelScore == 0 ) return;
+
+  memcpy(pstSnapshot->aszMap, gszMap, sizeof(pstSnapshot->aszMap));
+  pstSnapshot->astEntity[0] = gstPlayer;
   for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
-    int iX = 0;
-    int iY = 0;
-    int direction = 0;
-    if ( gastGhost[ii].iX == -1 || gastGhost[ii].iY == -1 ) continue;
-    do {
-      int iStep = 1;
-      direction = rand() % 4;
-      iX = gastGhost[ii].iX;
-      iY = gastGhost[ii].iY;
-
-      switch ( direction ) {
-        case UP_MOVEMENT  : iY -= iStep; break;
-        case LEFT_MOVEMENT: iX -= iStep; break;
-        case DOWN_MOVEMENT: iY += iStep; break;
-        case RIGHT_MOVENT : iX += iStep; break;
-        default           : break;
-      }
-      if ( gbGhostEndMap ) {
-        iX = ( iX > MAP_ROW-1 ? 0 : MAP_ROW-1 );
-        gbGhostEndMap = FALSE;
-      }
-      else if ( gszMap[iY][iX] == ' ' && (iX+1 == MAP_ROW || iX == 0) ) gbGhostEndMap = TRUE;
-      else if ( iX < 0 || iX > MAP_ROW-1 || iY < 0 || iY > MAP_COL-1 ) {
-        gbGhostEndMap = FALSE;
-        continue;
-      }
-      break;
-    } while ( TRUE );
-    if ( gszMap[iY][iX] == 'R' || gszMap[iY][iX] == 'G' || gszMap[iY][iX] == 'B' || gszMap[iY][iX] == 'A' || gszMap[iY][iX] == '#' ) continue;
-    if ( gszMap[iY][iX] == 'H' ) {
-      if ( giPowersCollected == 0 ) {
-        gstPlayer.iLives--;
-        Mix_PlayChannel(-1, gpstHeroDeathSound, 0);
-        if ( gstPlayer.iLives == 0 ) {
-          gbGameOver = TRUE;
-        }
-        else {
-          gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-          gstPlayer.iX = gstPlayer.iInitialX;
-          gstPlayer.iY = gstPlayer.iInitialY;
-          gstPlayer.iMovementDirection = NONE_MOVEMENT;
-          gszMap[gstPlayer.iY][gstPlayer.iX] = 'H';
-        }
-      }
-      else {
-        gszMap[gastGhost[ii].iY][gastGhost[ii].iX] = gastGhost[ii].chOldXY;
-        gastGhost[ii].iX = -1;
-        gastGhost[ii].iY = -1;
-        if ( giPowersCollected > 0 ) giPowersCollected--;
-        Mix_PlayChannel(-1, gpstGhostDeathSound, 0);
-        continue;
-      }
-    }
-    gastGhost[ii].iMovementDirection = direction;
-    gszMap[gastGhost[ii].iY][gastGhost[ii].iX] = gastGhost[ii].chOldXY;
-    gastGhost[ii].chOldXY = gszMap[iY][iX];
-    gszMap[iY][iX] = gastGhost[ii].chLetter;
-    gastGhost[ii].iY = iY;
-    gastGhost[ii].iX = iX;
+    pstSnapshot->astEntity[ii+1] = gastGhost[ii];
   }
+  pstSnapshot->iLevel = giLevel;
+  pstSnapshot->iCurrentLevelScore = giCurrentLevelScore;
+  pstSnapshot->iTotalGameScore = giTotalGameScore;
+  pstSnapshot->iCurrentLevelTime = giCurrentLevelTime;
+  pstSnapshot->iPowersCollected = giPowersCollected;
+  pstSnapshot->uiLevelSerial = guiLevelSerial;
+  pstSnapshot->ullNextTick = gullNextTick;
+  vPublishSnapshot();
 }
 
-void vMove(void) {
-  vHeroMove();
-  if ( giCurrentLevelScore != giTotalCurrentLevelScore ) {
-    vGhostsMove();
+static void vRestoreLevelStart(void) {
+  int iLives = gstPlayer.iLives > 0 ? gstPlayer.iLives : HERO_LIVES;
+  int ii = 0;
+
+  /* Only the level, the scores and the lives carried over are kept */
+  memcpy(gszMap, gstLevelStart.aszMap, sizeof(gszMap));
+  gstPlayer = gstLevelStart.astEntity[0];
+  gstPlayer.iLives = iLives;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    gastGhost[ii] = gstLevelStart.astEntity[ii+1];
   }
+  giTotalCurrentLevelScore = gstLevelStart.iTotalCurrentLevelScore;
+  guiLevelSerial++;
 }
 
-void vUpdateScreen(void) {
-  if ( giCurrentLevelTime == 0 ) gbTimeOut = TRUE;
-  switch ( geStatus ) {
-    case STATUS_IDLE: vMainMenu(); break;
-    case STATUS_PAUSE: {
-      Mix_PauseMusic();
-      vMessageBox("PAUSE", "Press any key to continue.");
-      Mix_PlayMusic(gpstMusic, -1);
-      geStatus = STATUS_RUN;
-      break;
-    }
-    case STATUS_RUN:
-    default: {
-      if ( !gbTimeOut ) {
-        vMove();
-        vDrawMap();
-      }
-      break;
-    }
+void vRefreshGameState(boolean bLevelChanged) {
+  if ( bLevelChanged ) guiLevelSerial++;
+  vPublishGameSnapshot();
+}
+
+static void vSavePreviousPositions(void) {
+  int ii = 0;
+  gstPlayer.iPrevX = gstPlayer.iX;
+  gstPlayer.iPrevY = gstPlayer.iY;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    gastGhost[ii].iPrevX = gastGhost[ii].iX;
+    gastGhost[ii].iPrevY = gastGhost[ii].iY;
   }
+}
+
+static void vCopyToCell(SDL_Texture* pstTexture, const SDL_Rect* pstSrcRect, float fCol, float fRow) {
+  SDL_FRect stRect;
+  stRect.x = fCameraX(fCol);
+  stRect.y = fCameraY(fRow);
+  stRect.w = gstCamera.fCellWidth;
+  stRect.h = gstCamera.fCellHeight;
+  iGfxRenderCopyF(gpstRenderer, pstTexture, pstSrcRect, &stRect);
+}
+
+static void vGetEntityPosition(PSTRUCT_ENTITY pstEntity, float fAlpha, float* pfCol, float* pfRow) {
+  int iDX = pstEntity->iX - pstEntity->iPrevX;
+  int iDY = pstEntity->iY - pstEntity->iPrevY;
+
+  *pfCol = (float) pstEntity->iX;
+  *pfRow = (float) pstEntity->iY;
+  if ( iDY == 0 && (iDX == MAP_COL - 1 || iDX == 1 - MAP_COL) ) {
+    /* Tunnel: the side the entity comes in */
+    int iStep = iDX > 0 ? -1 : 1;
+    *pfCol = (float) (pstEntity->iX - iStep) + (float) iStep * fAlpha;
+    return;
+  }
+  if ( pstEntity->iPrevX < 0 || pstEntity->iPrevY < 0 || iDX * iDX + iDY * iDY > 1 ) return;
+  *pfCol = (float) pstEntity->iPrevX + (float) iDX * fAlpha;
+  *pfRow = (float) pstEntity->iPrevY + (float) iDY * fAlpha;
+}
+
+static void vDrawEntity(PSTRUCT_ENTITY pstEntity, int iSpriteIndex, float fAlpha) {
+  SDL_Texture* pstTexture = NULL;
+  const SDL_Rect* pstSrcRect = NULL;
+  float fCol = 0.0f;
+  float fRow = 0.0f;
+  int iDX = pstEntity->iX - pstEntity->iPrevX;
+  int iDY = pstEntity->iY - pstEntity->iPrevY;
+
+  PSTRUCT_SPRITE_SHEET pstSpriteSheet = gapstSpriteSheet[pstEntity->eType];
+
+  if ( !pstSpriteSheet || pstEntity->iX < 0 || pstEntity->iY < 0 ) return;
+  pstTexture = pstSpriteSheet->pstTextures;
+  pstSrcRect = &pstSpriteSheet->pstRects[iSpriteIndex];
+
+  if ( iDY == 0 && (iDX == MAP_COL - 1 || iDX == 1 - MAP_COL) ) {
+    /* Tunnel: leave through one side while coming in through the other */
+    int iStep = iDX > 0 ? -1 : 1;
+    vCopyToCell(pstTexture, pstSrcRect, (float) pstEntity->iPrevX + (float) iStep * fAlpha, (float) pstEntity->iY);
+  }
+  /* Respawns and the first tick have no path to slide, they snap */
+  vGetEntityPosition(pstEntity, fAlpha, &fCol, &fRow);
+  vCopyToCell(pstTexture, pstSrcRect, fCol, fRow);
+}
+
+static void vUpdateGame(void) {
+  vSavePreviousPositions();
+  if ( giCurrentLevelTime == 0 ) gbTimeOut = TRUE;
+  if ( !gbTimeOut ) vMove();
 
   if ( !gbGameOver ) {
     if ( giCurrentLevelScore == giTotalCurrentLevelScore ) {
@@ -729,8 +995,6 @@ void vUpdateScreen(void) {
     }
   }
 
-  vDrawGameInfo();
-
   if ( gbTimeOut ) {
     vTimeOut();
   }
@@ -747,4 +1011,141 @@ void vUpdateScreen(void) {
       }
     }
   }
+
+  /* The level time is counted in ticks */
+  if ( !bOverlayActive() && giCurrentLevelScore > 0 && giCurrentLevelTime > 0 ) giCurrentLevelTime--;
+}
+
+void vSimStep(void) {
+  STRUCT_REPLAY_STEP stStep;
+  ENUM_REPLAY_MODE eReplay = eGetReplayMode();
+  boolean bReplayTick = FALSE;
+  boolean bChanged = FALSE;
+
+  memset(&stStep, 0x00, sizeof(stStep));
+  if ( eReplay == REPLAY_PLAY ) {
+    if ( !bPeekReplayStep(&stStep) ) {
+      gbRun = FALSE;
+      return;
+    }
+    /* Unless at max speed the ticks of the replay wait the game clock */
+    if ( stStep.bTick && !bReplayMaxSpeed() && !bTickDue() ) return;
+    vNextReplayStep();
+    vDismissOverlays(stStep.iDismissed);
+    bReplayTick = stStep.bTick;
+    stStep.bTick = FALSE;
+  }
+
+  /* An agent presses a key on the messages of the game, the pause is the user's */
+  if ( eReplay != REPLAY_PLAY && bAgentActive() && bOverlayActive() && geStatus != STATUS_PAUSE ) vDismissOverlays(1);
+
+  /* Dismissals, close functions and inputs are the whole input of a step */
+  if ( (stStep.iDismissed = iTakeOverlayDismissals()) > 0 ) bChanged = TRUE;
+  if ( bRunOverlayCallbacks() ) bChanged = TRUE;
+  if ( bApplyInput(&stStep) ) bChanged = TRUE;
+  if ( bApplyQuickState() ) bChanged = TRUE;
+  if ( !bOverlayActive() ) {
+    switch ( geStatus ) {
+      case STATUS_IDLE: {
+        vMainMenu();
+        if ( eReplay != REPLAY_PLAY ) vRunAgent();
+        bChanged = TRUE;
+        break;
+      }
+      case STATUS_PAUSE: {
+        vPauseMusic();
+        vShowOverlay("PAUSE", "Press any key to continue.", vResumeGame);
+        break;
+      }
+      case STATUS_RUN:
+      default: {
+        if ( eReplay == REPLAY_OFF && bRewindHeld() ) {
+          /* One tick back on each tick, the time runs backwards */
+          if ( bTickDue() && bRewindTick() ) bChanged = TRUE;
+        }
+        else if ( eReplay == REPLAY_PLAY ? bReplayTick : ((bAgentActive() && bReplayMaxSpeed()) || bTickDue()) ) {
+          stStep.bTick = TRUE;
+          vTimelineBegin("tick");
+          vUpdateGame();
+          vPushRewindTick();
+          vTimelineEnd("tick");
+          if ( eReplay != REPLAY_PLAY ) vRunAgent();
+          bChanged = TRUE;
+        }
+        break;
+      }
+    }
+  }
+  if ( bReplayTick && !stStep.bTick && DEBUG_WARNING ) vTrace("W: Replay out of sync, a tick was not run");
+  /* Steps that changed nothing can be dropped, the game is the same */
+  if ( bChanged && eReplay == REPLAY_RECORD ) vRecordStep(&stStep);
+  /* The copy costs as much as the map, skip it when nothing moved */
+  if ( bChanged ) vPublishGameSnapshot();
+}
+
+Uint32 uiGameStateHash(void) {
+  Uint64 ullHash = HASH_SEED;
+  int aiState[4 + 3 * (MAX_GHOSTS + 1)];
+  Uint8 aucValue[4];
+  int iCt = 0;
+  int ii = 0;
+
+  aiState[iCt++] = giLevel;
+  aiState[iCt++] = giTotalGameScore;
+  aiState[iCt++] = giCurrentLevelScore;
+  aiState[iCt++] = giCurrentLevelTime;
+  aiState[iCt++] = gstPlayer.iX;
+  aiState[iCt++] = gstPlayer.iY;
+  aiState[iCt++] = gstPlayer.iLives;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    aiState[iCt++] = gastGhost[ii].iX;
+    aiState[iCt++] = gastGhost[ii].iY;
+    aiState[iCt++] = gastGhost[ii].iLives;
+  }
+  /* Fields one by one, the padding of the structs is not part of the game */
+  ullHash = ullHashBytes(gszMap, sizeof(gszMap), ullHash);
+  /* In little endian so every platform gets the same hash */
+  for ( ii = 0; ii < iCt; ii++ ) {
+    aucValue[0] = (Uint8) ((Uint32) aiState[ii] & 0xFF);
+    aucValue[1] = (Uint8) (((Uint32) aiState[ii] >> 8) & 0xFF);
+    aucValue[2] = (Uint8) (((Uint32) aiState[ii] >> 16) & 0xFF);
+    aucValue[3] = (Uint8) (((Uint32) aiState[ii] >> 24) & 0xFF);
+    ullHash = ullHashBytes(aucValue, sizeof(aucValue), ullHash);
+  }
+  return HASH_FOLD32(ullHash);
+}
+
+void vPrintGameResult(FILE* fpOut) {
+  fprintf(
+    fpOut, "Level %d, level score %d, game score %d, lives %d, state %08lx\n",
+    giLevel, giCurrentLevelScore, giTotalGameScore, gstPlayer.iLives, (unsigned long) uiGameStateHash()
+  );
+}
+
+void vUpdateScreen(void) {
+  PSTRUCT_SNAPSHOT pstSnapshot = pstAcquireSnapshot();
+
+  gullCtFrames++;
+  if ( pstSnapshot->uiLevelSerial != guiDrawnLevelSerial ) {
+    vInvalidateRenderCache();
+    guiDrawnLevelSerial = pstSnapshot->uiLevelSerial;
+  }
+  if ( bOverlayActive() ) {
+    if ( bOverlayDirty() ) {
+      vDrawMap(pstSnapshot);
+      vDrawGameInfo(pstSnapshot);
+      vDrawOverlay();
+      vPresentFrame();
+    }
+    return;
+  }
+
+  vProfileBegin(PROFILE_DRAW_MAP);
+  vDrawMap(pstSnapshot);
+  vProfileEnd(PROFILE_DRAW_MAP);
+  vProfileBegin(PROFILE_DRAW_INFO);
+  vDrawGameInfo(pstSnapshot);
+  vProfileEnd(PROFILE_DRAW_INFO);
+  vDrawProfileOverlay();
+  vPresentFrame();
 }
@@ -0,0 +1,224 @@
+/**
+ * @file gfxstat.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gfxstat.h"
+
+/**
+ * @struct STRUCT_GFX_COUNTERS
+ * @brief Counts of the current frame and statistics of the recorded ones
+ */
+typedef struct STRUCT_GFX_COUNTERS {
+  SDL_atomic_t astFrame[GFX_COUNTER_COUNT];   /**< Current frame, the asset workers count too */
+  Uint64 aullTotal[GFX_COUNTER_COUNT];        /**< Counts since the start                     */
+  Uint64 aullRecorded[GFX_COUNTER_COUNT];     /**< Counts of the recorded frames              */
+  Uint32 auiLast[GFX_COUNTER_COUNT];          /**< Counts of the last recorded frame          */
+  Uint32 auiMax[GFX_COUNTER_COUNT];           /**< Maximum count in a recorded frame          */
+  Uint32 uiCtFrames;                          /**< Recorded frames                            */
+} STRUCT_GFX_COUNTERS, *PSTRUCT_GFX_COUNTERS;
+
+/**
+ * @var gstGfxCounters
+ * @brief The renderer and resource counters
+ */
+static STRUCT_GFX_COUNTERS gstGfxCounters;
+
+/**
+ * @var gkapszGfxCounter
+ * @brief Names of the counters, indexed by ENUM_GFX_COUNTER
+ */
+static const char* gkapszGfxCounter[GFX_COUNTER_COUNT] = {
+  "draw_calls",
+  "color_changes",
+  "textures_created",
+  "textures_destroyed",
+  "surfaces_created",
+  "fonts_opened",
+  "bytes_uploaded"
+};
+
+/**
+ * @brief Add to a counter of the current frame
+ *
+ * @param eCounter Counter
+ * @param iCount Quantity
+ */
+static void vCountGfx(ENUM_GFX_COUNTER eCounter, int iCount);
+
+/**
+ * @brief Close the current frame
+ *
+ * @param bRecord Frame goes to the per frame statistics
+ */
+static void vCloseGfxFrame(boolean bRecord);
+
+static void vCountGfx(ENUM_GFX_COUNTER eCounter, int iCount) {
+  SDL_AtomicAdd(&gstGfxCounters.astFrame[eCounter], iCount);
+}
+
+static void vCloseGfxFrame(boolean bRecord) {
+  int ii = 0;
+  for ( ii = 0; ii < GFX_COUNTER_COUNT; ii++ ) {
+    Uint32 uiCount = (Uint32) SDL_AtomicSet(&gstGfxCounters.astFrame[ii], 0);
+    gstGfxCounters.aullTotal[ii] += uiCount;
+    if ( !bRecord ) continue;
+    gstGfxCounters.aullRecorded[ii] += uiCount;
+    gstGfxCounters.auiLast[ii] = uiCount;
+    if ( uiCount > gstGfxCounters.auiMax[ii] ) gstGfxCounters.auiMax[ii] = uiCount;
+  }
+  if ( bRecord ) gstGfxCounters.uiCtFrames++;
+}
+
+void vEndGfxFrame(void) {
+  vCloseGfxFrame(TRUE);
+}
+
+void vSkipGfxFrame(void) {
+  vCloseGfxFrame(FALSE);
+}
+
+void vGetGfxStats(ENUM_GFX_COUNTER eCounter, PSTRUCT_GFX_STATS pstStats) {
+  memset(pstStats, 0x00, sizeof(STRUCT_GFX_STATS));
+  pstStats->ullTotal = gstGfxCounters.aullTotal[eCounter];
+  if ( gstGfxCounters.uiCtFrames == 0 ) return;
+  pstStats->uiLast = gstGfxCounters.auiLast[eCounter];
+  pstStats->uiMax = gstGfxCounters.auiMax[eCounter];
+  pstStats->uiAvg = (Uint32) (gstGfxCounters.aullRecorded[eCounter] / gstGfxCounters.uiCtFrames);
+}
+
+const char* kpszGfxCounterName(ENUM_GFX_COUNTER eCounter) {
+  return gkapszGfxCounter[eCounter];
+}
+
+void vPrintGfxStats(FILE* fpOut) {
+  STRUCT_GFX_STATS stStats;
+  int ii = 0;
+
+  fprintf(fpOut, "Render counters (%u frames)\n", (unsigned int) gstGfxCounters.uiCtFrames);
+  fprintf(fpOut, "  %-20s %12s %10s %10s\n", "counter", "total", "avg/frame", "max/frame");
+  for ( ii = 0; ii < GFX_COUNTER_COUNT; ii++ ) {
+    vGetGfxStats((ENUM_GFX_COUNTER) ii, &stStats);
+    fprintf(
+      fpOut, "  %-20s %12lu %10u %10u\n", gkapszGfxCounter[ii],
+      (unsigned long) stStats.ullTotal, (unsigned int) stStats.uiAvg, (unsigned int) stStats.uiMax
+    );
+  }
+}
+
+int iGfxRenderClear(SDL_Renderer* pstRenderer) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderClear(pstRenderer);
+}
+
+int iGfxRenderCopy(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Rect* pstSrc, const SDL_Rect* pstDst) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderCopy(pstRenderer, pstTexture, pstSrc, pstDst);
+}
+
+int iGfxRenderCopyF(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Rect* pstSrc, const SDL_FRect* pstDst) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderCopyF(pstRenderer, pstTexture, pstSrc, pstDst);
+}
+
+int iGfxRenderDrawRect(SDL_Renderer* pstRenderer, const SDL_Rect* pstRect) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderDrawRect(pstRenderer, pstRect);
+}
+
+int iGfxRenderDrawRectF(SDL_Renderer* pstRenderer, const SDL_FRect* pstRect) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderDrawRectF(pstRenderer, pstRect);
+}
+
+int iGfxRenderFillRect(SDL_Renderer* pstRenderer, const SDL_Rect* pstRect) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderFillRect(pstRenderer, pstRect);
+}
+
+int iGfxRenderFillRectF(SDL_Renderer* pstRenderer, const SDL_FRect* pstRect) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderFillRectF(pstRenderer, pstRect);
+}
+
+int iGfxRenderGeometry(SDL_Renderer* pstRenderer, SDL_Texture* pstTexture, const SDL_Vertex* pstVertices, int iCtVertices, const int* kpiIndices, int iCtIndices) {
+  vCountGfx(GFX_DRAW_CALLS, 1);
+  return SDL_RenderGeometry(pstRenderer, pstTexture, pstVertices, iCtVertices, kpiIndices, iCtIndices);
+}
+
+int iGfxSetRenderDrawColor(SDL_Renderer* pstRenderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+  vCountGfx(GFX_COLOR_CHANGES, 1);
+  return SDL_SetRenderDrawColor(pstRenderer, r, g, b, a);
+}
+
+SDL_Texture* pstGfxCreateTextureFromSurface(SDL_Renderer* pstRenderer, SDL_Surface* pstSurface) {
+  SDL_Texture* pstTexture = SDL_CreateTextureFromSurface(pstRenderer, pstSurface);
+  if ( pstTexture ) {
+    vCountGfx(GFX_TEXTURES_CREATED, 1);
+    vCountGfx(GFX_BYTES_UPLOADED, pstSurface->pitch * pstSurface->h);
+  }
+  return pstTexture;
+}
+
+void vGfxDestroyTexture(SDL_Texture* pstTexture) {
+  if ( pstTexture ) vCountGfx(GFX_TEXTURES_DESTROYED, 1);
+  SDL_DestroyTexture(pstTexture);
+}
+
+SDL_Surface* pstGfxCreateRGBSurfaceWithFormat(Uint32 uiFlags, int iWidth, int iHeight, int iDepth, Uint32 uiFormat) {
+  SDL_Surface* pstSurface = SDL_CreateRGBSurfaceWithFormat(uiFlags, iWidth, iHeight, iDepth, uiFormat);
+  if ( pstSurface ) vCountGfx(GFX_SURFACES_CREATED, 1);
+  return pstSurface;
+}
+
+SDL_Surface* pstGfxLoadImage(const char* kpszFile) {
+  SDL_Surface* pstSurface = IMG_Load(kpszFile);
+  if ( pstSurface ) vCountGfx(GFX_SURFACES_CREATED, 1);
+  return pstSurface;
+}
+
+SDL_Texture* pstGfxLoadTexture(SDL_Renderer* pstRenderer, const char* kpszFile) {
+  SDL_Texture* pstTexture = IMG_LoadTexture(pstRenderer, kpszFile);
+  int iWidth = 0;
+  int iHeight = 0;
+  if ( pstTexture ) {
+    vCountGfx(GFX_TEXTURES_CREATED, 1);
+    /* The decoded surface is gone, count the texture as 32 bits per pixel */
+    if ( SDL_QueryTexture(pstTexture, NULL, NULL, &iWidth, &iHeight) == 0 ) vCountGfx(GFX_BYTES_UPLOADED, iWidth * iHeight * 4);
+  }
+  return pstTexture;
+}
+
+TTF_Font* pstGfxOpenFont(const char* kpszFile, int iSize) {
+  vCountGfx(GFX_FONTS_OPENED, 1);
+  return TTF_OpenFont(kpszFile, iSize);
+}
+
+SDL_Surface* pstGfxRenderTextBlended(TTF_Font* pstFont, const char* kpszText, SDL_Color stColor) {
+  SDL_Surface* pstSurface = TTF_RenderText_Blended(pstFont, kpszText, stColor);
+  if ( pstSurface ) vCountGfx(GFX_SURFACES_CREATED, 1);
+  return pstSurface;
+}
+
+SDL_Surface* pstGfxRenderGlyphBlended(TTF_Font* pstFont, Uint16 usGlyph, SDL_Color stColor) {
+  SDL_Surface* pstSurface = TTF_RenderGlyph_Blended(pstFont, usGlyph, stColor);
+  if ( pstSurface ) vCountGfx(GFX_SURFACES_CREATED, 1);
+  return pstSurface;
+}
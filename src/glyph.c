@@ -0,0 +1,257 @@
+/**
+ * @file glyph.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gui.h"
+#include "glyph.h"
+
+/**
+ * @var gapstGlyphAtlas
+ * @brief Atlases already rasterized, one per font size
+ */
+static PSTRUCT_GLYPH_ATLAS gapstGlyphAtlas[MAX_GLYPH_ATLAS];
+
+/**
+ * @var gastGlyphVertex
+ * @brief Vertex batch reused by every iDrawGlyphText call
+ */
+static SDL_Vertex gastGlyphVertex[GLYPH_MAX_BATCH * 4];
+
+/**
+ * @var gaiGlyphIndex
+ * @brief Index batch (two triangles per quad), filled once
+ */
+static int gaiGlyphIndex[GLYPH_MAX_BATCH * 6];
+
+/**
+ * @var gbGlyphIndexReady
+ * @brief Defines whether gaiGlyphIndex was filled
+ */
+static boolean gbGlyphIndexReady = FALSE;
+
+/**
+ * @brief Rasterize all printable glyphs of a font size into a new atlas
+ *
+ * @param iFontSize Font size
+ * @return Pointer to the atlas or NULL on error
+ */
+static PSTRUCT_GLYPH_ATLAS pstCreateGlyphAtlas(int iFontSize);
+
+static PSTRUCT_GLYPH_ATLAS pstCreateGlyphAtlas(int iFontSize) {
+  PSTRUCT_GLYPH_ATLAS pstAtlas = NULL;
+  SDL_Surface* apstGlyph[GLYPH_COUNT];
+  SDL_Surface* pstAtlasSurface = NULL;
+  TTF_Font* pstFont = NULL;
+  SDL_Color stWhite;
+  int iRasterSize = (int) ((float) iFontSize * gfRenderScale + 0.5f);
+  char szFont[_MAX_PATH + 32] = "";
+  int iPenX = 0;
+  int iPenY = 0;
+  int iRowHeight = 0;
+  int iLineHeight = 0;
+  int ii = 0;
+
+  memset(apstGlyph, 0x00, sizeof(apstGlyph));
+  memset(szFont, 0x00, sizeof(szFont));
+
+  sprintf(szFont, "%s%c%s", gszFontDir, DIR_SEPARATOR, FONT_NAME);
+  if ( (pstFont = pstGfxOpenFont(szFont, iRasterSize)) == NULL ) {
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", szFont, TTF_GetError());
+    return NULL;
+  }
+
+  if ( (pstAtlas = (PSTRUCT_GLYPH_ATLAS) calloc(1, sizeof(STRUCT_GLYPH_ATLAS))) == NULL ) {
+    if ( DEBUG_ERROR ) vTrace("Error allocating memory to glyph atlas");
+    TTF_CloseFont(pstFont);
+    return NULL;
+  }
+  pstAtlas->iFontSize = iFontSize;
+  pstAtlas->fScale = (float) iRasterSize / (float) iFontSize;
+  iLineHeight = TTF_FontHeight(pstFont);
+  pstAtlas->iHeight = (int) ((float) iLineHeight / pstAtlas->fScale + 0.5f);
+  pstAtlas->iAtlasWidth = GLYPH_ATLAS_WIDTH;
+
+  stWhite.r = 255;
+  stWhite.g = 255;
+  stWhite.b = 255;
+  stWhite.a = 255;
+
+  /* Rasterize every glyph once and lay them out in rows */
+  for ( ii = 0; ii < GLYPH_COUNT; ii++ ) {
+    apstGlyph[ii] = pstGfxRenderGlyphBlended(pstFont, (Uint16) (GLYPH_FIRST + ii), stWhite);
+    if ( !apstGlyph[ii] ) continue;
+    if ( iPenX + apstGlyph[ii]->w > GLYPH_ATLAS_WIDTH ) {
+      iPenX = 0;
+      iPenY += iRowHeight;
+      iRowHeight = 0;
+    }
+    pstAtlas->astGlyph[ii].x = iPenX;
+    pstAtlas->astGlyph[ii].y = iPenY;
+    pstAtlas->astGlyph[ii].w = apstGlyph[ii]->w;
+    pstAtlas->astGlyph[ii].h = apstGlyph[ii]->h;
+    iPenX += apstGlyph[ii]->w;
+    if ( apstGlyph[ii]->h > iRowHeight ) iRowHeight = apstGlyph[ii]->h;
+  }
+  pstAtlas->iAtlasHeight = iPenY + iRowHeight;
+  TTF_CloseFont(pstFont);
+
+  pstAtlasSurface = pstGfxCreateRGBSurfaceWithFormat(0, pstAtlas->iAtlasWidth, pstAtlas->iAtlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  if ( pstAtlasSurface ) {
+    for ( ii = 0; ii < GLYPH_COUNT; ii++ ) {
+      if ( !apstGlyph[ii] ) continue;
+      SDL_SetSurfaceBlendMode(apstGlyph[ii], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(apstGlyph[ii], NULL, pstAtlasSurface, &pstAtlas->astGlyph[ii]);
+    }
+    pstAtlas->pstTexture = pstGfxCreateTextureFromSurface(gpstRenderer, pstAtlasSurface);
+    SDL_FreeSurface(pstAtlasSurface);
+  }
+  for ( ii = 0; ii < GLYPH_COUNT; ii++ ) {
+    if ( apstGlyph[ii] ) SDL_FreeSurface(apstGlyph[ii]);
+  }
+
+  if ( !pstAtlas->pstTexture ) {
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to create the glyph atlas of size [%d]: [%s]", iFontSize, SDL_GetError());
+    free(pstAtlas);
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(pstAtlas->pstTexture, SDL_BLENDMODE_BLEND);
+
+  if ( DEBUG_DETAILS ) vTrace("Glyph atlas of size [%d]: [%dx%d]", iFontSize, pstAtlas->iAtlasWidth, pstAtlas->iAtlasHeight);
+
+  return pstAtlas;
+}
+
+PSTRUCT_GLYPH_ATLAS pstGetGlyphAtlas(int iFontSize) {
+  int ii = 0;
+  for ( ii = 0; ii < MAX_GLYPH_ATLAS; ii++ ) {
+    if ( gapstGlyphAtlas[ii] && gapstGlyphAtlas[ii]->iFontSize == iFontSize ) {
+      return gapstGlyphAtlas[ii];
+    }
+  }
+  for ( ii = 0; ii < MAX_GLYPH_ATLAS; ii++ ) {
+    if ( !gapstGlyphAtlas[ii] ) {
+      gapstGlyphAtlas[ii] = pstCreateGlyphAtlas(iFontSize);
+      return gapstGlyphAtlas[ii];
+    }
+  }
+  if ( DEBUG_WARNING ) vTrace("W: No free glyph atlas slot for the font size [%d]", iFontSize);
+  return NULL;
+}
+
+void vDestroyGlyphAtlases(void) {
+  int ii = 0;
+  for ( ii = 0; ii < MAX_GLYPH_ATLAS; ii++ ) {
+    if ( gapstGlyphAtlas[ii] ) {
+      vGfxDestroyTexture(gapstGlyphAtlas[ii]->pstTexture);
+      free(gapstGlyphAtlas[ii]);
+      gapstGlyphAtlas[ii] = NULL;
+    }
+  }
+}
+
+int iGlyphTextWidth(PSTRUCT_GLYPH_ATLAS pstAtlas, const char* kpszText) {
+  int iWidth = 0;
+  if ( !pstAtlas || !kpszText ) return 0;
+  for ( ; *kpszText; kpszText++ ) {
+    int iIndex = (unsigned char) *kpszText - GLYPH_FIRST;
+    if ( iIndex < 0 || iIndex >= GLYPH_COUNT ) continue;
+    iWidth += pstAtlas->astGlyph[iIndex].w;
+  }
+  return (int) ((float) iWidth / pstAtlas->fScale + 0.5f);
+}
+
+int iDrawGlyphText(
+  SDL_Renderer* pstRenderer,
+  PSTRUCT_GLYPH_ATLAS pstAtlas,
+  int iX,
+  int iY,
+  const char* kpszText,
+  SDL_Color stColor) {
+  float fInvW = 0.0f;
+  float fInvH = 0.0f;
+  float fPenX = (float) iX;
+  int iCtGlyphs = 0;
+  int ii = 0;
+
+  if ( !pstAtlas || !kpszText ) return 0;
+
+  if ( !gbGlyphIndexReady ) {
+    for ( ii = 0; ii < GLYPH_MAX_BATCH; ii++ ) {
+      gaiGlyphIndex[ii * 6 + 0] = ii * 4 + 0;
+      gaiGlyphIndex[ii * 6 + 1] = ii * 4 + 1;
+      gaiGlyphIndex[ii * 6 + 2] = ii * 4 + 2;
+      gaiGlyphIndex[ii * 6 + 3] = ii * 4 + 2;
+      gaiGlyphIndex[ii * 6 + 4] = ii * 4 + 3;
+      gaiGlyphIndex[ii * 6 + 5] = ii * 4 + 0;
+    }
+    gbGlyphIndexReady = TRUE;
+  }
+
+  fInvW = 1.0f / (float) pstAtlas->iAtlasWidth;
+  fInvH = 1.0f / (float) pstAtlas->iAtlasHeight;
+
+  for ( ; *kpszText && iCtGlyphs < GLYPH_MAX_BATCH; kpszText++ ) {
+    int iIndex = (unsigned char) *kpszText - GLYPH_FIRST;
+    SDL_Vertex* pstV = NULL;
+    SDL_Rect* pstSrc = NULL;
+    float fX0 = 0.0f;
+    float fY0 = 0.0f;
+    float fX1 = 0.0f;
+    float fY1 = 0.0f;
+
+    if ( iIndex < 0 || iIndex >= GLYPH_COUNT ) continue;
+    pstSrc = &pstAtlas->astGlyph[iIndex];
+    if ( pstSrc->w == 0 ) continue;
+
+    fX0 = fPenX;
+    fY0 = (float) iY;
+    fX1 = fPenX + (float) pstSrc->w / pstAtlas->fScale;
+    fY1 = (float) iY + (float) pstSrc->h / pstAtlas->fScale;
+    fPenX = fX1;
+
+    /* Space has no ink, only advance the pen */
+    if ( *kpszText == ' ' ) continue;
+
+    pstV = &gastGlyphVertex[iCtGlyphs * 4];
+    pstV[0].position.x = fX0; pstV[0].position.y = fY0;
+    pstV[1].position.x = fX1; pstV[1].position.y = fY0;
+    pstV[2].position.x = fX1; pstV[2].position.y = fY1;
+    pstV[3].position.x = fX0; pstV[3].position.y = fY1;
+    pstV[0].tex_coord.x = (float) pstSrc->x * fInvW;
+    pstV[0].tex_coord.y = (float) pstSrc->y * fInvH;
+    pstV[1].tex_coord.x = (float) (pstSrc->x + pstSrc->w) * fInvW;
+    pstV[1].tex_coord.y = pstV[0].tex_coord.y;
+    pstV[2].tex_coord.x = pstV[1].tex_coord.x;
+    pstV[2].tex_coord.y = (float) (pstSrc->y + pstSrc->h) * fInvH;
+    pstV[3].tex_coord.x = pstV[0].tex_coord.x;
+    pstV[3].tex_coord.y = pstV[2].tex_coord.y;
+    for ( ii = 0; ii < 4; ii++ ) {
+      pstV[ii].color = stColor;
+    }
+    iCtGlyphs++;
+  }
+
+  if ( iCtGlyphs > 0 ) {
+    iGfxRenderGeometry(pstRenderer, pstAtlas->pstTexture, gastGlyphVertex, iCtGlyphs * 4, gaiGlyphIndex, iCtGlyphs * 6);
+  }
+
+  return (int) (fPenX - (float) iX + 0.5f);
+}
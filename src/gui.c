@@ -21,18 +21,116 @@
  */
 
 #include "gui.h"
+#include "profile.h"
 
-Uint32 giFrameStart = 0;
-Uint32 giFrameTime = 0;
 volatile boolean gbRun = TRUE;
 SDL_Window* gpstWindow = NULL;
 SDL_Renderer* gpstRenderer = NULL;
 SDL_Event gunEvent;
 int giWindowWidth = WINDOW_WIDTH;
 int giWindowHeight = WINDOW_HEIGHT;
+float gfRenderScale = 1.0f;
 char gszFontDir[_MAX_PATH];
+boolean gbVSync = FALSE;
+int giOffscreenFrames = 0;
+char gszFrameDumpDir[_MAX_PATH];
 
-boolean bInitSDL(void) {
+/**
+ * @var gpstOffscreenSurface
+ * @brief Surface where the software renderer draws in offscreen mode
+ */
+static SDL_Surface* gpstOffscreenSurface = NULL;
+
+/**
+ * @var giOffscreenFrame
+ * @brief Frames presented in offscreen mode
+ */
+static int giOffscreenFrame = 0;
+
+/**
+ * @var gullOffscreenStart
+ * @brief Performance counter when the offscreen renderer was created
+ */
+static Uint64 gullOffscreenStart = 0;
+
+/**
+ * @brief Create the software renderer that draws into gpstOffscreenSurface
+ *
+ * @return TRUE renderer created
+ * @return FALSE SDL error
+ */
+static boolean bInitOffscreenRenderer(void);
+
+/**
+ * @brief Hash the offscreen surface, print it and save the frame as PNG
+ */
+static void vCaptureOffscreenFrame(void);
+
+/**
+ * @brief Create the game window and its accelerated renderer
+ *
+ * @return TRUE window created
+ * @return FALSE SDL error
+ */
+static boolean bCreateWindow(void);
+
+static boolean bInitOffscreenRenderer(void) {
+  if ( SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) ) {
+    if ( DEBUG_FATAL ) vTrace("Error starting SDL module: [%s]", SDL_GetError());
+    return FALSE;
+  }
+  gpstOffscreenSurface = pstGfxCreateRGBSurfaceWithFormat(0, LOGICAL_WIDTH, LOGICAL_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+  if ( !gpstOffscreenSurface ) {
+    if ( DEBUG_FATAL ) vTrace("Error to creating offscreen surface: [%s]", SDL_GetError());
+    return FALSE;
+  }
+  gpstRenderer = SDL_CreateSoftwareRenderer(gpstOffscreenSurface);
+  if ( !gpstRenderer ) {
+    if ( DEBUG_FATAL ) vTrace("Error to creating software renderer: [%s]", SDL_GetError());
+    SDL_FreeSurface(gpstOffscreenSurface);
+    gpstOffscreenSurface = NULL;
+    return FALSE;
+  }
+  gullOffscreenStart = SDL_GetPerformanceCounter();
+  return TRUE;
+}
+
+static void vCaptureOffscreenFrame(void) {
+  Uint64 ullHash = HASH_SEED;
+  int iRow = 0;
+
+  SDL_LockSurface(gpstOffscreenSurface);
+  for ( iRow = 0; iRow < gpstOffscreenSurface->h; iRow++ ) {
+    ullHash = ullHashBytes(
+      (Uint8*) gpstOffscreenSurface->pixels + iRow * gpstOffscreenSurface->pitch,
+      (size_t) gpstOffscreenSurface->w * 4,
+      ullHash
+    );
+  }
+  SDL_UnlockSurface(gpstOffscreenSurface);
+
+  giOffscreenFrame++;
+  printf("frame %06d %08lx%08lx\n", giOffscreenFrame, (unsigned long) (ullHash >> 32), (unsigned long) (ullHash & 0xFFFFFFFFUL));
+
+  if ( !bStrIsEmpty(gszFrameDumpDir) ) {
+    char szPngPath[_MAX_PATH + 32] = "";
+    memset(szPngPath, 0x00, sizeof(szPngPath));
+    sprintf(szPngPath, "%s%cframe%06d.png", gszFrameDumpDir, DIR_SEPARATOR, giOffscreenFrame);
+    if ( IMG_SavePNG(gpstOffscreenSurface, szPngPath) != 0 ) {
+      if ( DEBUG_ERROR ) vTrace("E: Impossible to save the frame [%s]: [%s]", szPngPath, IMG_GetError());
+    }
+  }
+
+  if ( giOffscreenFrame >= giOffscreenFrames ) {
+    Uint64 ullElapsed = SDL_GetPerformanceCounter() - gullOffscreenStart;
+    Uint64 ullFrequency = SDL_GetPerformanceFrequency();
+    double dMs = (double) ullElapsed * 1000.0 / (double) ullFrequency;
+    printf("offscreen: %d frames in %.3f ms (%.3f ms/frame)\n", giOffscreenFrame, dMs, dMs / giOffscreenFrame);
+    gbRun = FALSE;
+  }
+}
+
+static boolean bCreateWindow(void) {
   if ( SDL_Init(SDL_INIT_EVERYTHING) ) {
     if ( DEBUG_FATAL ) vTrace("Error starting SDL module: [%s]", SDL_GetError());
     return FALSE;
@@ -52,18 +150,34 @@ boolean bInitSDL(void) {
   gpstRenderer = SDL_CreateRenderer(
     gpstWindow,
     -1,
-    SDL_RENDERER_ACCELERATED
+    SDL_RENDERER_ACCELERATED | (gbVSync ? SDL_RENDERER_PRESENTVSYNC : 0)
   );
   if ( !gpstRenderer ) {
     if ( DEBUG_FATAL ) vTrace("Error to creating renderer: [%s]", SDL_GetError());
     SDL_DestroyWindow(gpstWindow);
     return FALSE;
   }
+  return TRUE;
+}
+
+boolean bInitSDL(void) {
+  if ( giOffscreenFrames > 0 ) {
+    if ( !bInitOffscreenRenderer() ) return FALSE;
+  }
+  else if ( !bCreateWindow() ) {
+    return FALSE;
+  }
+  if ( SDL_RenderSetLogicalSize(gpstRenderer, LOGICAL_WIDTH, LOGICAL_HEIGHT) != 0 ) {
+    if ( DEBUG_WARNING ) vTrace("W: Failure to set the logical size: [%s]", SDL_GetError());
+  }
+  vUpdateRenderScale();
+
+  if ( !bInitOverlay() ) return FALSE;
 
   if ( !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) ) {
     if ( DEBUG_FATAL ) vTrace("Error starting IMG module: [%s]", IMG_GetError());
     SDL_DestroyRenderer(gpstRenderer);
-    SDL_DestroyWindow(gpstWindow);
+    if ( gpstWindow ) SDL_DestroyWindow(gpstWindow);
     return FALSE;
   }
 
@@ -72,128 +186,100 @@ boolean bInitSDL(void) {
     return FALSE;
   }
 
-  if ( Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, AUDIO_CHUNKSIZE) < 0 ) {
-    if ( DEBUG_WARNING ) vTrace("W: Failure to start Mixer module: [%s]!", Mix_GetError());
-  }
+  if ( bOpenAudio() ) vInitSounds();
 
   return TRUE;
 }
 
 void vDestroySDL(void) {
-  Mix_CloseAudio();
+  vDestroyOverlay();
+  vDestroyRenderCache();
+  vDestroyGlyphAtlases();
+  vCloseAudio();
   TTF_Quit();
   IMG_Quit();
   SDL_DestroyRenderer(gpstRenderer);
-  SDL_DestroyWindow(gpstWindow);
+  if ( gpstWindow ) SDL_DestroyWindow(gpstWindow);
+  if ( gpstOffscreenSurface ) SDL_FreeSurface(gpstOffscreenSurface);
   SDL_Quit();
 }
 
-void vMessageBox(const char *kpszMsg, const char *kpszFooterMsg) {
-  SDL_Surface* pstMsgBoxTextSurface = NULL;
-  SDL_Texture* pstMsgBoxTextTexture = NULL;
-  SDL_Rect stFooterTextRect = { 0 };
-  TTF_Font* pstFont = NULL;
-  TTF_Font* pstFooterFont = NULL;
-  SDL_Surface* pstFooterTextSurface = NULL;
-  SDL_Texture* pstFooterTextTexture = NULL;
-  boolean bShowMsgBox = TRUE;
-  boolean bRenderer = TRUE;
-  char szFont[512] = "";
-  int iFontSize = 15;
-  int iExitMsgFontSize = 10;
-  SDL_Color stBackgroundColor;
-  SDL_Color stBorderColor;
+void vPresentFrame(void) {
+  vProfileBegin(PROFILE_PRESENT);
+  SDL_RenderPresent(gpstRenderer);
+  vProfileEnd(PROFILE_PRESENT);
+  if ( gpstOffscreenSurface ) vCaptureOffscreenFrame();
+}
+
+void vDrawLoadingScreen(int iCtDone, int iCtTotal) {
+  PSTRUCT_GLYPH_ATLAS pstAtlas = NULL;
+  SDL_Rect stBar;
+  SDL_Rect stFill;
   SDL_Color stTextColor;
-  SDL_Rect stRect;
-  SDL_Rect stTextRect;
-
-  if ( bStrIsEmpty(kpszMsg) ) return;
-
-  sprintf(szFont, "%s%c%s", gszFontDir, DIR_SEPARATOR, FONT_NAME);
-  if ( (pstFont = TTF_OpenFont(szFont, iFontSize)) == NULL ) {
-    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", szFont, TTF_GetError());
-    return;
-  }
-
-  if ( (pstFooterFont = TTF_OpenFont(szFont, iExitMsgFontSize)) == NULL ) {
-    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", szFont, TTF_GetError());
-    TTF_CloseFont(pstFont);
-    return;
-  }
-
-  stBackgroundColor.r = 255;
-  stBackgroundColor.g = 255;
-  stBackgroundColor.b = 255;
-  stBackgroundColor.a = 255;
-
-  stBorderColor.r = 0;
-  stBorderColor.g = 0;
-  stBorderColor.b = 0;
-  stBorderColor.a = 255;
-
-  stTextColor.r = 0;
-  stTextColor.g = 0;
-  stTextColor.b = 0;
-  stTextColor.a = 255;
-
-  stRect.h = 100;
-  stRect.w = giWindowWidth / 2;
-  stRect.x = (giWindowWidth - stRect.w) / 2;
-  stRect.y = giWindowHeight / 4;
-
-  pstMsgBoxTextSurface = TTF_RenderText_Blended(pstFont, kpszMsg, stTextColor);
-  pstMsgBoxTextTexture = SDL_CreateTextureFromSurface(gpstRenderer, pstMsgBoxTextSurface);
-
-  stTextRect.w = pstMsgBoxTextSurface->w;
-  stTextRect.h = pstMsgBoxTextSurface->h;
-  stTextRect.x = stRect.x + (stRect.w - stTextRect.w) / 2;
-  stTextRect.y = stRect.y + (stRect.h - stTextRect.h) / 4;
-
-  pstFooterTextSurface = TTF_RenderText_Blended(pstFooterFont, kpszFooterMsg, stTextColor);
-  pstFooterTextTexture = SDL_CreateTextureFromSurface(gpstRenderer, pstFooterTextSurface);
-
-  stFooterTextRect.w = pstFooterTextSurface->w;
-  stFooterTextRect.h = pstFooterTextSurface->h;
-  stFooterTextRect.x = stRect.x + (stRect.w - stFooterTextRect.w) / 2;
-  stFooterTextRect.y = stRect.y + stRect.h - stFooterTextRect.h - 10;
-
-  bRenderer = TRUE;
-  while ( bShowMsgBox ) {
-    while ( SDL_PollEvent(&gunEvent) ) {
-      if ( gunEvent.type == SDL_KEYDOWN || gunEvent.type == SDL_QUIT ) {
-        bShowMsgBox = FALSE;
-        bRenderer = FALSE;
-        if ( gunEvent.type == SDL_QUIT ) gbRun = FALSE;
-        break;
-      }
-    }
 
-    if ( bRenderer ) {
-      SDL_SetRenderDrawColor(gpstRenderer, stBackgroundColor.r, stBackgroundColor.g, stBackgroundColor.b, stBackgroundColor.a);
-      SDL_RenderFillRect(gpstRenderer, &stRect);
-      SDL_SetRenderDrawColor(
-        gpstRenderer,
-        stBorderColor.r,
-        stBorderColor.g,
-        stBorderColor.b,
-        stBorderColor.a
-      );
-      SDL_RenderDrawRect(gpstRenderer, &stRect);
-      SDL_RenderCopy(gpstRenderer, pstMsgBoxTextTexture, NULL, &stTextRect);
-      SDL_RenderCopy(gpstRenderer, pstFooterTextTexture, NULL, &stFooterTextRect);
-      SDL_RenderPresent(gpstRenderer);
-      if ( DEBUG_INFO ) {
-        vTrace("vMessageBox - %s", kpszMsg);
-        vTrace("vMessageBox - %s", kpszFooterMsg);
-      }
-      bRenderer = FALSE;
+  /* Offscreen frames are hashed, the splash would change the numbering */
+  if ( gpstOffscreenSurface ) return;
+  SDL_PumpEvents();
+
+  stBar.w = LOGICAL_WIDTH / 2;
+  stBar.h = 20;
+  stBar.x = (LOGICAL_WIDTH - stBar.w) / 2;
+  stBar.y = (LOGICAL_HEIGHT - stBar.h) / 2;
+  stFill = stBar;
+  stFill.w = iCtTotal > 0 ? stBar.w * iCtDone / iCtTotal : stBar.w;
+
+  iGfxSetRenderDrawColor(gpstRenderer, 0, 0, 0, 255);
+  iGfxRenderClear(gpstRenderer);
+  iGfxSetRenderDrawColor(gpstRenderer, 0, 0, 255, 255);
+  iGfxRenderFillRect(gpstRenderer, &stFill);
+  iGfxSetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
+  iGfxRenderDrawRect(gpstRenderer, &stBar);
+
+  if ( (pstAtlas = pstGetGlyphAtlas(HUD_FONT_SIZE)) != NULL ) {
+    stTextColor.r = 255;
+    stTextColor.g = 255;
+    stTextColor.b = 255;
+    stTextColor.a = 255;
+    iDrawGlyphText(gpstRenderer, pstAtlas, (LOGICAL_WIDTH - iGlyphTextWidth(pstAtlas, "Loading...")) / 2, stBar.y - pstAtlas->iHeight - 10, "Loading...", stTextColor);
+  }
+  SDL_RenderPresent(gpstRenderer);
+}
+
+void vHandleWindowEvent(void) {
+  if ( gunEvent.window.event == SDL_WINDOWEVENT_RESIZED ) {
+    int iNewWidth = gunEvent.window.data1;
+    int iNewHeight = gunEvent.window.data2;
+
+    if ( iNewWidth < WINDOW_WIDTH || iNewHeight < WINDOW_HEIGHT ) {
+      SDL_SetWindowSize(gpstWindow, giWindowWidth, giWindowHeight);
+    }
+    else {
+      giWindowWidth = iNewWidth;
+      giWindowHeight = iNewHeight;
     }
   }
+  else if ( gunEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ) {
+    vUpdateRenderScale();
+  }
+}
+
+void vUpdateRenderScale(void) {
+  int iOutputWidth = 0;
+  int iOutputHeight = 0;
+  float fScaleX = 0.0f;
+  float fScaleY = 0.0f;
+  float fScale = 0.0f;
+
+  if ( SDL_GetRendererOutputSize(gpstRenderer, &iOutputWidth, &iOutputHeight) != 0 ) return;
+  fScaleX = (float) iOutputWidth / (float) LOGICAL_WIDTH;
+  fScaleY = (float) iOutputHeight / (float) LOGICAL_HEIGHT;
+  fScale = fScaleX < fScaleY ? fScaleX : fScaleY;
+  if ( fScale < 1.0f ) fScale = 1.0f;
 
-  SDL_FreeSurface(pstMsgBoxTextSurface);
-  SDL_DestroyTexture(pstMsgBoxTextTexture);
-  SDL_FreeSurface(pstFooterTextSurface);
-  SDL_DestroyTexture(pstFooterTextTexture);
-  TTF_CloseFont(pstFooterFont);
-  TTF_CloseFont(pstFont);
+  /* Only a real change of scale invalidates the prescaled textures */
+  if ( fScale > gfRenderScale - 0.001f && fScale < gfRenderScale + 0.001f ) return;
+  gfRenderScale = fScale;
+  vDestroyGlyphAtlases();
+  vInvalidateRenderCache();
+  if ( DEBUG_DETAILS ) vTrace("Render scale: [%d/1000] output [%dx%d]", (int) (gfRenderScale * 1000.0f), iOutputWidth, iOutputHeight);
 }
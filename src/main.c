@@ -50,6 +50,30 @@ const struct option astCmdOpt[] = {
   { "level-dir"  , required_argument, 0, 'l' },
   { "font-dir"   , required_argument, 0, 'f' },
   { "audio-dir"  , required_argument, 0, 'a' },
+  { "offscreen"  , required_argument, 0, 'o' },
+  { "frame-dump" , required_argument, 0, 'D' },
+  { "frame-pacing", required_argument, 0, 'P' },
+  { "frame-stats", no_argument      , 0, 'S' },
+  { "threaded"   , no_argument      , 0, 'T' },
+  { "no-audio"   , no_argument      , 0, 'N' },
+  { "audio-rate" , required_argument, 0, 'R' },
+  { "audio-buffer", required_argument, 0, 'B' },
+  { "audio-channels", required_argument, 0, 'C' },
+  { "audio-latency-test", no_argument, 0, 'L' },
+  { "trace-max-size", required_argument, 0, 'X' },
+  { "trace-format", required_argument, 0, 'F' },
+  { "profile-out", required_argument, 0, 'O' },
+  { "trace-events", required_argument, 0, 'E' },
+  { "record"     , required_argument, 0, 'r' },
+  { "replay"     , required_argument, 0, 'p' },
+  { "speed"      , required_argument, 0, 's' },
+  { "headless"   , no_argument      , 0, 'H' },
+  { "state-file" , required_argument, 0, 'K' },
+  { "agent"      , required_argument, 0, 'A' },
+  { "mcts-budget", required_argument, 0, 'Q' },
+  { "mcts-threads", required_argument, 0, 'J' },
+  { "vecenv"     , required_argument, 0, 'V' },
+  { "vecenv-count", required_argument, 0, 'W' },
   { NULL         , 0                , 0, 0   }
 };
 
@@ -62,6 +86,31 @@ const char* gkpaszCmdLineExampleArguments[] = {
   "<path>",
   "<path>",
   "<path>",
+  "<frames>",
+  "<path>",
+  "<mode>",
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  "<hz>",
+  "<frames>",
+  "<number>",
+  NULL,
+  "<bytes>",
+  "<format>",
+  "<path>",
+  "<path>",
+  "<path>",
+  "<path>",
+  "<speed>",
+  NULL,
+  "<path>",
+  "<agent>",
+  "<ms>",
+  "<number>",
+  "<name>",
+  "<number>",
   NULL
 };
 
@@ -81,6 +130,30 @@ const char* gkpaszHelpCmdLineMessages[] = {
   "<path> is the ttf fonts directory path (default ./assets/font).",
   "<path> is the audio directory path (default ./assets/audio).",
 #endif
+  "<frames> renders the frames without window and prints the hash of each one.",
+  "<path> is the directory where the offscreen frames are saved as PNG.",
+  "<mode> is the frame pacing: hybrid, vsync or unlimited (default hybrid).",
+  "Print the frame time statistics and render counters on exit (F2 prints them while playing).",
+  "Run the simulation in its own thread (ignored offscreen).",
+  "Do not open the sound device nor load the sounds (always offscreen).",
+  "<hz> is the audio sample rate (default 44100).",
+  "<frames> is the audio buffer, a power of two; lower is less lag (default 2048).",
+  "<number> is the audio output channels (default 2).",
+  "Print the time from a game event to the audio callback on exit.",
+  "<bytes> rotates the trace file to <path>.1 when it grows past it (default never).",
+  "<format> is the trace format: text or binary, read by bin/tracedec (default text).",
+  "<path> receives the time of each frame phase as CSV (F3 shows them while playing).",
+  "<path> receives the frames, ticks, loads and messages as trace events for Perfetto.",
+  "<path> records the inputs and the seed of the game to replay it.",
+  "<path> plays a game recorded with --record instead of reading the keys.",
+  "<speed> of the replay or the agent: normal or max (default normal).",
+  "Play the replay or the agent without window nor rendering, at max speed, and print the result.",
+  "<path> keeps the quick save (F5 saves, F9 loads) across runs.",
+  "<agent> drives the hero: random, greedy, mcts or the path of a library exporting iAgentAct.",
+  "<ms> is the search time of each mcts decision (default 40).",
+  "<number> is the searches run in parallel by mcts (default one per CPU).",
+  "<name> of the shared memory (\"/name\") serving environments to a trainer until it closes them.",
+  "<number> is the environments served by --vecenv (default 16).",
   NULL
 };
 
@@ -114,6 +187,24 @@ static void vShowUsage(void);
  */
 static boolean bParseCommandLine(int argc, char** argv);
 
+/**
+ * @brief Play the loaded replay or the agent without window nor rendering
+ *
+ * @return 0 success
+ * @return -1 initialization error
+ */
+static int iRunHeadless(void);
+
+/**
+ * @brief Serve environments of the first level to a trainer through shared
+ * memory until it closes them
+ *
+ * @param uiSeed Seed of the ghosts of the episodes
+ * @return 0 closed by the trainer
+ * @return -1 level or shared memory error
+ */
+static int iRunVecEnvServer(Uint32 uiSeed);
+
 static void vShowVersion(void) {
   printf("%s %s [%s %s]\n", gkpszProgramName, VERSION, __DATE__, __TIME__);
 }
@@ -132,6 +223,46 @@ static void vShowUsage(void) {
   }
 }
 
+static int iRunHeadless(void) {
+  Uint64 ullStart = 0;
+  Uint64 ullElapsed = 0;
+
+  /* The simulation only needs the overlay queue, nothing is drawn */
+  if ( !bInitOverlay() ) return -1;
+  vSetReplayMaxSpeed(TRUE);
+  ullStart = ullGetMicroseconds();
+  while ( gbRun ) {
+    /* An agent plays one game, the replay stops at its last step */
+    if ( bAgentActive() && (bGameFinished() || ulGetAgentDecisions() >= AGENT_HEADLESS_MAX_TICKS) ) break;
+    vSimStep();
+  }
+  ullElapsed = ullGetMicroseconds() - ullStart;
+  vPrintReplayStats(stdout, ullElapsed);
+  vPrintAgentStats(stdout, ullElapsed);
+  vPrintMctsStats(stdout);
+  vPrintGameResult(stdout);
+  vCloseReplay();
+  vCloseAgent();
+  return 0;
+}
+
+static int iRunVecEnvServer(Uint32 uiSeed) {
+  STRUCT_GAME_STATE stStart;
+  PSTRUCT_VECENV pstEnv = NULL;
+  boolean bServed = FALSE;
+
+  /* Each episode starts as the game starts the level */
+  vMainMenu();
+  if ( geStatus != STATUS_RUN ) return -1;
+  vSaveGameState(&stStart);
+  pstEnv = pstCreateVecEnv(gstCmdLine.iVecEnvCount > 0 ? gstCmdLine.iVecEnvCount : VECENV_DEFAULT_COUNT, &stStart, uiSeed);
+  if ( !pstEnv ) return -1;
+  bServed = bServeVecEnv(pstEnv, gstCmdLine.szVecEnv);
+  vPrintVecEnvStats(stdout, pstEnv);
+  vDestroyVecEnv(pstEnv);
+  return bServed ? 0 : -1;
+}
+
 static boolean bParseCommandLine(int argc, char **argv) {
   int iOpt = 0;
   int iLongInd = 0;
@@ -157,6 +288,102 @@ static boolean bParseCommandLine(int argc, char **argv) {
         sprintf(gstCmdLine.szMap, "%s", optarg);
         break;
       }
+      case 'o': {
+        gstCmdLine.iOffscreenFrames = atoi(optarg);
+        break;
+      }
+      case 'D': {
+        sprintf(gstCmdLine.szFrameDumpDir, "%s", optarg);
+        break;
+      }
+      case 'P': {
+        sprintf(gstCmdLine.szFramePacing, "%.*s", (int) sizeof(gstCmdLine.szFramePacing) - 1, optarg);
+        break;
+      }
+      case 'S': {
+        gstCmdLine.bFrameStats = TRUE;
+        break;
+      }
+      case 'T': {
+        gstCmdLine.bThreaded = TRUE;
+        break;
+      }
+      case 'N': {
+        gstCmdLine.bNoAudio = TRUE;
+        break;
+      }
+      case 'R': {
+        gstCmdLine.iAudioRate = atoi(optarg);
+        break;
+      }
+      case 'B': {
+        gstCmdLine.iAudioBuffer = atoi(optarg);
+        break;
+      }
+      case 'C': {
+        gstCmdLine.iAudioChannels = atoi(optarg);
+        break;
+      }
+      case 'L': {
+        gstCmdLine.bAudioLatencyTest = TRUE;
+        break;
+      }
+      case 'X': {
+        gstCmdLine.lTraceMaxSize = atol(optarg);
+        break;
+      }
+      case 'F': {
+        sprintf(gstCmdLine.szTraceFormat, "%.*s", (int) sizeof(gstCmdLine.szTraceFormat) - 1, optarg);
+        break;
+      }
+      case 'O': {
+        sprintf(gstCmdLine.szProfileOut, "%s", optarg);
+        break;
+      }
+      case 'E': {
+        sprintf(gstCmdLine.szTraceEvents, "%s", optarg);
+        break;
+      }
+      case 'r': {
+        sprintf(gstCmdLine.szRecord, "%s", optarg);
+        break;
+      }
+      case 'p': {
+        sprintf(gstCmdLine.szReplay, "%s", optarg);
+        break;
+      }
+      case 's': {
+        sprintf(gstCmdLine.szReplaySpeed, "%.*s", (int) sizeof(gstCmdLine.szReplaySpeed) - 1, optarg);
+        break;
+      }
+      case 'H': {
+        gstCmdLine.bHeadless = TRUE;
+        break;
+      }
+      case 'K': {
+        sprintf(gstCmdLine.szStateFile, "%s", optarg);
+        break;
+      }
+      case 'A': {
+        sprintf(gstCmdLine.szAgent, "%s", optarg);
+        break;
+      }
+      case 'Q': {
+        gstCmdLine.iMctsBudget = atoi(optarg);
+        break;
+      }
+      case 'J': {
+        gstCmdLine.iMctsThreads = atoi(optarg);
+        break;
+      }
+      case 'V': {
+        sprintf(gstCmdLine.szVecEnv, "%.*s", (int) sizeof(gstCmdLine.szVecEnv) - 1, optarg);
+        break;
+      }
+      case 'W': {
+        gstCmdLine.iVecEnvCount = atoi(optarg);
+        break;
+      }
       case '?':
       default: return FALSE;
     }
@@ -170,6 +397,10 @@ static boolean bParseCommandLine(int argc, char **argv) {
  *                                                                            *
  ******************************************************************************/
 int main(int argc, char **argv) {
+  ENUM_PACING ePacing = PACING_HYBRID;
+  STRUCT_REPLAY_HEADER stReplayHeader;
+  boolean bMaxSpeed = FALSE;
+  Uint64 ullLoopStart = 0;
   opterr = 0;
   gkpszProgramName = basename(argv[0]);
 
@@ -178,6 +409,7 @@ int main(int argc, char **argv) {
   memset(gastGhost   , 0x00, sizeof(gastGhost  ));
   memset(&gstTracePrm, 0x00, sizeof(gstTracePrm));
   memset(&gstCmdLine , 0x00, sizeof(gstCmdLine ));
+  memset(&stReplayHeader, 0x00, sizeof(stReplayHeader));
 
   if ( !bParseCommandLine(argc, argv) ) {
     vShowUsage();
@@ -195,6 +427,11 @@ int main(int argc, char **argv) {
   }
 
   if ( !bStrIsEmpty(gstCmdLine.szTrace) && !bStrIsEmpty(gstCmdLine.szDebugLevel) ) {
+    vSetTraceMaxSize(gstCmdLine.lTraceMaxSize);
+    if ( !bStrIsEmpty(gstCmdLine.szTraceFormat) && !bSetTraceFormat(gstCmdLine.szTraceFormat) ) {
+      vShowUsage();
+      return -1;
+    }
     vInitTrace(gstCmdLine.szTrace, gstCmdLine.szDebugLevel);
   }
 
@@ -203,6 +440,37 @@ int main(int argc, char **argv) {
     vTraceCmdLine(argc, argv);
   }
 
+  if ( !bStrIsEmpty(gstCmdLine.szReplay) ) {
+    if ( !bStrIsEmpty(gstCmdLine.szRecord) ) {
+      vShowUsage();
+      return -1;
+    }
+    if ( !bLoadReplay(gstCmdLine.szReplay, &stReplayHeader) ) return -1;
+    /* The levels of the recording, unless other ones are given */
+    if ( bStrIsEmpty(gstCmdLine.szLevelDir) ) {
+      sprintf(gstCmdLine.szLevelDir, "%s", stReplayHeader.szLevelDir);
+    }
+  }
+  else {
+    if ( gstCmdLine.bHeadless && bStrIsEmpty(gstCmdLine.szAgent) ) {
+      vShowUsage();
+      return -1;
+    }
+    stReplayHeader.uiSeed = uiNewRandomSeed();
+  }
+  vSeedRandom(stReplayHeader.uiSeed);
+  /* The replay has the moves, the agent would only be a spectator */
+  /* The trainer drives the environments, nothing else plays the game */
+  if ( !bStrIsEmpty(gstCmdLine.szVecEnv) &&
+       (!bStrIsEmpty(gstCmdLine.szAgent) || !bStrIsEmpty(gstCmdLine.szReplay) || !bStrIsEmpty(gstCmdLine.szRecord)) ) {
+    vShowUsage();
+    return -1;
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szAgent) && eGetReplayMode() != REPLAY_PLAY ) {
+    vSetMctsParams(gstCmdLine.iMctsBudget, gstCmdLine.iMctsThreads);
+    if ( !bInitAgent(gstCmdLine.szAgent, stReplayHeader.uiSeed) ) return -1;
+  }
+
   if ( bStrIsEmpty(gstCmdLine.szImgDir) ) {
     sprintf(gstCmdLine.szImgDir, "./assets%cimg", DIR_SEPARATOR);
   }
@@ -215,7 +483,48 @@ int main(int argc, char **argv) {
   if ( bStrIsEmpty(gstCmdLine.szAudioDir) ) {
     sprintf(gstCmdLine.szAudioDir, "./assets%caudio", DIR_SEPARATOR);
   }
+  if ( eGetReplayMode() == REPLAY_PLAY && uiHashLevelSet(gstCmdLine.szLevelDir) != stReplayHeader.uiLevelHash ) {
+    fprintf(stderr, "W: The levels in [%s] are not the ones of the replay\n", gstCmdLine.szLevelDir);
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szRecord) ) {
+    sprintf(stReplayHeader.szLevelDir, "%s", gstCmdLine.szLevelDir);
+    stReplayHeader.uiLevelHash = uiHashLevelSet(gstCmdLine.szLevelDir);
+    if ( !bStartRecording(gstCmdLine.szRecord, &stReplayHeader) ) return -1;
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szReplaySpeed) ) {
+    if ( !bParseReplaySpeed(gstCmdLine.szReplaySpeed, &bMaxSpeed) ) {
+      vShowUsage();
+      return -1;
+    }
+    vSetReplayMaxSpeed(bMaxSpeed);
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szVecEnv) ) return iRunVecEnvServer(stReplayHeader.uiSeed);
+  if ( gstCmdLine.bHeadless ) return iRunHeadless();
+
   sprintf(gszFontDir, "%s", gstCmdLine.szFontDir);
+  sprintf(gszFrameDumpDir, "%s", gstCmdLine.szFrameDumpDir);
+  giOffscreenFrames = gstCmdLine.iOffscreenFrames;
+  /* Headless runs usually have no sound device */
+  if ( gstCmdLine.bNoAudio || giOffscreenFrames > 0 ) geAudioBackend = AUDIO_BACKEND_NULL;
+  if ( !bSetAudioSpec(gstCmdLine.iAudioRate, gstCmdLine.iAudioBuffer, gstCmdLine.iAudioChannels) ) {
+    vShowUsage();
+    return -1;
+  }
+  if ( gstCmdLine.bAudioLatencyTest ) vEnableSoundLatencyTest();
+  if ( !bStrIsEmpty(gstCmdLine.szProfileOut) && !bOpenProfileOutput(gstCmdLine.szProfileOut) ) {
+    return -1;
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szTraceEvents) ) {
+    if ( !bOpenTimeline(gstCmdLine.szTraceEvents) ) return -1;
+    vTimelineThreadName("main");
+  }
+  if ( !bStrIsEmpty(gstCmdLine.szFramePacing) && !bParsePacing(gstCmdLine.szFramePacing, &ePacing) ) {
+    vShowUsage();
+    return -1;
+  }
+  /* Offscreen frames are rendered as fast as possible */
+  if ( giOffscreenFrames > 0 || bReplayMaxSpeed() ) ePacing = PACING_UNLIMITED;
+  gbVSync = ePacing == PACING_VSYNC;
 
   if ( !bInitSDL() ) {
     if ( DEBUG_FATAL ) vTrace("main - F: error in bInitSDL!");
@@ -227,17 +536,55 @@ int main(int argc, char **argv) {
     return -1;
   }
 
+  vInitFramePacer(ePacing, RENDER_FPS);
+
+  /* The offscreen game clock is the frame count, only one thread can drive it.
+   * The replays need the dismissals and the steps in the same order. */
+  if ( gstCmdLine.bThreaded && giOffscreenFrames == 0 && eGetReplayMode() == REPLAY_OFF ) {
+    if ( !bStartSimThread() && DEBUG_WARNING ) vTrace("W: Running the simulation in the main loop");
+  }
+
+  ullLoopStart = ullGetMicroseconds();
   /* main loop */
   while ( gbRun ) {
-    giFrameStart = SDL_GetTicks();
+    vBeginFrame();
+    vTimelineBegin("frame");
+    vProfileBegin(PROFILE_EVENTS);
     vHandleEvents();
+    vProfileEnd(PROFILE_EVENTS);
+    if ( !bSimThreaded() ) vSimStep();
     vUpdateScreen();
-    giFrameTime = SDL_GetTicks() - giFrameStart;
-    if ( giFrameTime < FRAME_DELAY ) {
-      SDL_Delay(FRAME_DELAY - giFrameTime);
-      if ( giCurrentLevelScore > 0 && giCurrentLevelTime > 0 ) giCurrentLevelTime--;
+    vFlushSounds();
+    /* The overlay already waited for events, the game is stopped */
+    if ( bOverlayActive() ) {
+      vSkipFrame();
+      vSkipProfileFrame();
+      vTimelineEnd("frame");
+      continue;
     }
+    vEndProfileFrame();
+    vEndFrame();
+    vTimelineEnd("frame");
+  }
+
+  vStopSimThread();
+
+  if ( gstCmdLine.bFrameStats ) {
+    vPrintFrameStats(stdout);
+    vPrintGfxStats(stdout);
+    vPrintRewindStats(stdout);
+  }
+  vPrintSoundLatency(stdout);
+  vCloseProfile();
+  if ( eGetReplayMode() != REPLAY_OFF ) {
+    vPrintReplayStats(stdout, ullGetMicroseconds() - ullLoopStart);
+    vPrintGameResult(stdout);
+    vCloseReplay();
   }
+  vPrintAgentStats(stdout, ullGetMicroseconds() - ullLoopStart);
+  vPrintMctsStats(stdout);
+  vCloseAgent();
+  vCloseTimeline();
 
   vDestroyGame();
   vDestroySDL();
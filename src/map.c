@@ -30,81 +30,9 @@ int giCurrentLevelScore = 0;
 int giTotalCurrentLevelScore = 0;
 boolean gbShowPowerMessage = TRUE;
 int giPowersCollected = 0;
-Mix_Chunk* gpstPowerUpSound = NULL;
-Mix_Chunk* gpstLevelUpSound = NULL;
-Mix_Chunk* gpstGameWinSound = NULL;
 STRUCT_PLAYER gstPlayer;
 PSTRUCT_SPRITE_SHEET gpstHeartSpriteSheet;
-Mix_Chunk* gpstHeroDeathSound;
 STRUCT_GHOST gastGhost[MAX_GHOSTS];
-Mix_Chunk* gpstGhostDeathSound;
-
-void vSetCoordinates(int iX, int iY) {
-  if ( gbHeroEndMap ) {
-    iX = ( iX > MAP_ROW-1 ? 0 : MAP_ROW-1 );
-    gbHeroEndMap = FALSE;
-  }
-  else if ( gszMap[iY][iX] == ' ' && (iX+1 == MAP_ROW || iX == 0) ) gbHeroEndMap = TRUE;
-  else if ( iX < 0 || iX > MAP_ROW-1 || iY < 0 || iY > MAP_COL-1 ) {
-    gbHeroEndMap = FALSE;
-    return;
-  }
-  else if ( gszMap[iY][iX] == 'R' ||
-    gszMap[iY][iX] == 'G' ||
-    gszMap[iY][iX] == 'B' ||
-    gszMap[iY][iX] == 'A' ) {
-    if ( giPowersCollected > 0 ) {
-      int iIndex = -1;
-      switch( gszMap[iY][iX] ) {
-        case 'R': iIndex = 0; break;
-        case 'G': iIndex = 1; break;
-        case 'B': iIndex = 2; break;
-        case 'A': iIndex = 3; break;
-        default: break;
-      }
-      gszMap[gastGhost[iIndex].iY][gastGhost[iIndex].iX] = gastGhost[iIndex].chOldXY;
-      gastGhost[iIndex].iX = -1;
-      gastGhost[iIndex].iY = -1;
-      if ( giPowersCollected > 0 ) giPowersCollected--;
-      Mix_PlayChannel(-1, gpstGhostDeathSound, 0);
-    }
-    else {
-      gstPlayer.iLives--;
-      Mix_PlayChannel(-1, gpstHeroDeathSound, 0);
-      if ( gstPlayer.iLives == 0 ) {
-        gbGameOver = TRUE;
-        return;
-      }
-      else {
-        iX = gstPlayer.iInitialX;
-        iY = gstPlayer.iInitialY;
-        gszMap[gstPlayer.iY][gstPlayer.iX] = ' ';
-        gstPlayer.iMovementDirection = NONE_MOVEMENT;
-      }
-    }
-    }
-    else if ( gszMap[iY][iX] == '#' ) {
-      return;
-    }
-    if ( gszMap[iY][iX] == '.' ) {
-      giCurrentLevelScore += 10;
-    }
-    else if ( gszMap[iY][iX] == 'O' ) {
-      giCurrentLevelScore += 100;
-      giPowersCollected++;
-      Mix_PlayChannel(-1, gpstPowerUpSound, 0);
-    }
-    gstPlayer.iX = iX;
-    gstPlayer.iY = iY;
-    if ( gszMap[iY][iX] == 'O' && gbShowPowerMessage ) {
-      vMessageBox("Wow, would you like to kill a ghost?", "Press any key to continue.");
-      gbShowPowerMessage = FALSE;
-    }
-}
-
-void vUpdateMap(void) {
-  gszMap[gstPlayer.iY][gstPlayer.iX] = 'H';
-}
 
 void vGetInitialPlayerPosition(void) {
   int iRow = 0;
@@ -116,6 +44,8 @@ void vGetInitialPlayerPosition(void) {
         gstPlayer.iX = iCol;
         gstPlayer.iInitialY = iRow;
         gstPlayer.iInitialX = iCol;
+        gstPlayer.iPrevY = iRow;
+        gstPlayer.iPrevX = iCol;
         return;
       }
     }
@@ -134,6 +64,8 @@ void vGetInitialGhostsPosition(void) {
           gastGhost[ii].iX = iCol;
           gastGhost[ii].iInitialY = iRow;
           gastGhost[ii].iInitialX = iCol;
+          gastGhost[ii].iPrevY = iRow;
+          gastGhost[ii].iPrevX = iCol;
         }
       }
     }
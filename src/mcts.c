@@ -0,0 +1,498 @@
+/**
+ * @file mcts.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "game.h"
+#include "mcts.h"
+
+/**
+ * @def MCTS_CELLS
+ * @brief Cells searched for the nearest dot
+ */
+#define MCTS_CELLS (MAP_ROW * MAP_COL)
+
+/**
+ * @struct STRUCT_MCTS_NODE
+ * @brief Moves played from the root up to here, and how they went
+ */
+typedef struct STRUCT_MCTS_NODE {
+  int aiChild[4];  /**< Node after each move, -1 not expanded yet */
+  Uint32 uiVisits; /**< Iterations through the node               */
+  double dReward;  /**< Sum of their rewards, each in [0, 1]      */
+} STRUCT_MCTS_NODE, *PSTRUCT_MCTS_NODE;
+
+/**
+ * @struct STRUCT_MCTS_WORKER
+ * @brief A search and its tree, the first one runs on the simulation thread
+ */
+typedef struct STRUCT_MCTS_WORKER {
+  SDL_Thread* pstThread;                  /**< NULL for the first one       */
+  SDL_sem* pstStart;                      /**< Posted to start a search     */
+  Uint32 uiRandomState;                   /**< Ghosts and rollouts          */
+  int iCtNodes;                           /**< Nodes used in astNode        */
+  unsigned long ulRollouts;               /**< Iterations of the last search */
+  unsigned long ulSteps;                  /**< Ticks of the last search     */
+  STRUCT_GAME_STATE stGame;               /**< Copy played by an iteration  */
+  int aiDistance[MCTS_CELLS];             /**< Cells from the hero, -1 between searches */
+  int aiFirstMove[MCTS_CELLS];            /**< Move from the hero leading there */
+  int aiQueue[MCTS_CELLS];                /**< Cells to visit               */
+  STRUCT_MCTS_NODE astNode[MCTS_MAX_NODES]; /**< Tree, the root is the first */
+} STRUCT_MCTS_WORKER, *PSTRUCT_MCTS_WORKER;
+
+/**
+ * @struct STRUCT_MCTS
+ * @brief The search shared by the workers
+ */
+typedef struct STRUCT_MCTS {
+  int iBudgetMs;                /**< Search time of a decision     */
+  int iCtThreads;               /**< Searches asked, 0 one per CPU */
+  int iCtWorkers;               /**< Workers in pstWorker          */
+  PSTRUCT_MCTS_WORKER pstWorker; /**< Workers, NULL when closed    */
+  SDL_sem* pstDone;             /**< Posted when a search ends     */
+  SDL_atomic_t stQuit;          /**< Set to stop the threads       */
+  Uint64 ullDeadline;           /**< End of the current search     */
+  STRUCT_GAME_STATE stRoot;     /**< Game of the current decision  */
+  unsigned long ulDecisions;    /**< Searches done                 */
+  unsigned long ulRollouts;     /**< Iterations of all of them     */
+  unsigned long ulSteps;        /**< Ticks simulated by them       */
+  Uint64 ullSearchUs;           /**< Time spent in them            */
+  double dFullReturn;           /**< Return of a dot on every tick */
+} STRUCT_MCTS, *PSTRUCT_MCTS;
+
+/**
+ * @var gstMcts
+ * @brief The search of the mcts agent
+ */
+static STRUCT_MCTS gstMcts = { MCTS_DEFAULT_BUDGET_MS, 0 };
+
+/**
+ * @var gkaiMctsRow
+ * @brief Row step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiMctsRow[4] = { -1, 0, 1, 0 };
+
+/**
+ * @var gkaiMctsCol
+ * @brief Col step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiMctsCol[4] = { 0, -1, 0, 1 };
+
+/**
+ * @brief Take a free node of the tree
+ *
+ * @param pstWorker Worker
+ * @return Node index or -1 when the tree is full
+ */
+static int iMctsNewNode(PSTRUCT_MCTS_WORKER pstWorker);
+
+/**
+ * @brief Check if a move of the hero runs into a wall, it only stops it
+ *
+ * @param kpstState Game
+ * @param iMove Movement
+ * @return TRUE wall
+ * @return FALSE free cell, ghost or tunnel
+ */
+static boolean bMctsWall(const STRUCT_GAME_STATE* kpstState, int iMove);
+
+/**
+ * @brief Choose the move from a node, walls aside: the moves never tried
+ * first, then the best UCB1
+ *
+ * @param pstWorker Worker
+ * @param iNode Node
+ * @return Movement
+ */
+static int iMctsSelect(PSTRUCT_MCTS_WORKER pstWorker, int iNode);
+
+/**
+ * @brief Get the distance of the hero to the nearest dot or power, around
+ * the walls and the ghosts
+ *
+ * @param pstWorker Worker
+ * @param piMove Receives the first move of the way
+ * @return Cells or -1 when none can be reached
+ */
+static int iMctsNearestDot(PSTRUCT_MCTS_WORKER pstWorker, int* piMove);
+
+/**
+ * @brief Choose a move of the rollout, the way of the greedy agent seven
+ * times out of eight, a random one that is not a wall otherwise
+ *
+ * @param pstWorker Worker
+ * @return Movement
+ */
+static int iMctsRolloutMove(PSTRUCT_MCTS_WORKER pstWorker);
+
+/**
+ * @brief Run a tick on the copy of the worker
+ *
+ * @param pstWorker Worker
+ * @param iMove Movement
+ * @param pdDiscount Weight of this tick, multiplied by MCTS_DISCOUNT
+ * @return Weighted reward of the tick
+ */
+static double dMctsStep(PSTRUCT_MCTS_WORKER pstWorker, int iMove, double* pdDiscount);
+
+/**
+ * @brief Select, expand, roll out and back up once
+ *
+ * @param pstWorker Worker
+ */
+static void vMctsIterate(PSTRUCT_MCTS_WORKER pstWorker);
+
+/**
+ * @brief Grow a new tree from gstMcts.stRoot until the deadline
+ *
+ * @param pstWorker Worker
+ */
+static void vMctsSearch(PSTRUCT_MCTS_WORKER pstWorker);
+
+/**
+ * @brief Worker thread loop, a search each time pstStart is posted
+ *
+ * @param pvData Worker
+ * @return 0
+ */
+static int iMctsThread(void* pvData);
+
+static int iMctsNewNode(PSTRUCT_MCTS_WORKER pstWorker) {
+  PSTRUCT_MCTS_NODE pstNode = NULL;
+  if ( pstWorker->iCtNodes == MCTS_MAX_NODES ) return -1;
+  pstNode = &pstWorker->astNode[pstWorker->iCtNodes];
+  pstNode->aiChild[0] = -1;
+  pstNode->aiChild[1] = -1;
+  pstNode->aiChild[2] = -1;
+  pstNode->aiChild[3] = -1;
+  pstNode->uiVisits = 0;
+  pstNode->dReward = 0.0;
+  return pstWorker->iCtNodes++;
+}
+
+static boolean bMctsWall(const STRUCT_GAME_STATE* kpstState, int iMove) {
+  int iRow = kpstState->astEntity[0].iY + gkaiMctsRow[iMove];
+  int iCol = kpstState->astEntity[0].iX + gkaiMctsCol[iMove];
+  if ( iRow < 0 || iRow >= MAP_ROW || iCol < 0 || iCol >= MAP_COL ) return FALSE;
+  return kpstState->aszMap[iRow][iCol] == '#';
+}
+
+static int iMctsSelect(PSTRUCT_MCTS_WORKER pstWorker, int iNode) {
+  PSTRUCT_MCTS_NODE pstNode = &pstWorker->astNode[iNode];
+  double dLogVisits = SDL_log((double) pstNode->uiVisits);
+  double dBest = -1.0;
+  int iFirst = iRandomBelowFrom(&pstWorker->uiRandomState, 4);
+  int iBest = iFirst;
+  int ii = 0;
+
+  for ( ii = 0; ii < 4; ii++ ) {
+    int iMove = (iFirst + ii) % 4;
+    PSTRUCT_MCTS_NODE pstChild = NULL;
+    double dScore = 0.0;
+    if ( bMctsWall(&pstWorker->stGame, iMove) ) continue;
+    if ( pstNode->aiChild[iMove] < 0 ) return iMove;
+    pstChild = &pstWorker->astNode[pstNode->aiChild[iMove]];
+    if ( pstChild->uiVisits == 0 ) return iMove;
+    dScore = pstChild->dReward / (double) pstChild->uiVisits
+      + MCTS_EXPLORATION * SDL_sqrt(dLogVisits / (double) pstChild->uiVisits);
+    if ( dScore > dBest ) {
+      dBest = dScore;
+      iBest = iMove;
+    }
+  }
+  return iBest;
+}
+
+static int iMctsNearestDot(PSTRUCT_MCTS_WORKER pstWorker, int* piMove) {
+  const STRUCT_GAME_STATE* kpstState = &pstWorker->stGame;
+  const STRUCT_ENTITY* kpstHero = &kpstState->astEntity[0];
+  int iHead = 0;
+  int iTail = 0;
+  int iMove = 0;
+  int iFound = -1;
+
+  if ( kpstHero->iY < 0 || kpstHero->iY >= MAP_ROW || kpstHero->iX < 0 || kpstHero->iX >= MAP_COL ) return -1;
+  pstWorker->aiDistance[kpstHero->iY * MAP_COL + kpstHero->iX] = 0;
+  pstWorker->aiFirstMove[kpstHero->iY * MAP_COL + kpstHero->iX] = NONE_MOVEMENT;
+  pstWorker->aiQueue[iTail++] = kpstHero->iY * MAP_COL + kpstHero->iX;
+  /* Breadth first, it stops at the first dot, mostly a few cells away */
+  while ( iHead < iTail ) {
+    int iCell = pstWorker->aiQueue[iHead++];
+    int iRow = iCell / MAP_COL;
+    int iCol = iCell % MAP_COL;
+    char chCell = kpstState->aszMap[iRow][iCol];
+    if ( chCell == '.' || chCell == 'O' ) {
+      *piMove = pstWorker->aiFirstMove[iCell];
+      iFound = pstWorker->aiDistance[iCell];
+      break;
+    }
+    for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+      int iNextRow = iRow + gkaiMctsRow[iMove];
+      int iNextCol = iCol + gkaiMctsCol[iMove];
+      int iNext = iNextRow * MAP_COL + iNextCol;
+      if ( iNextRow < 0 || iNextRow >= MAP_ROW || iNextCol < 0 || iNextCol >= MAP_COL ) continue;
+      if ( pstWorker->aiDistance[iNext] >= 0 ) continue;
+      chCell = kpstState->aszMap[iNextRow][iNextCol];
+      if ( chCell == '#' || chCell == 'R' || chCell == 'G' || chCell == 'B' || chCell == 'A' ) continue;
+      pstWorker->aiDistance[iNext] = pstWorker->aiDistance[iCell] + 1;
+      pstWorker->aiFirstMove[iNext] = pstWorker->aiFirstMove[iCell] == NONE_MOVEMENT ? iMove : pstWorker->aiFirstMove[iCell];
+      pstWorker->aiQueue[iTail++] = iNext;
+    }
+  }
+  /* Only the queued cells were reached, the rest of the map is still -1 */
+  while ( iTail > 0 ) pstWorker->aiDistance[pstWorker->aiQueue[--iTail]] = -1;
+  return iFound;
+}
+
+static int iMctsRolloutMove(PSTRUCT_MCTS_WORKER pstWorker) {
+  int aiOpen[4];
+  int iCtOpen = 0;
+  int iMove = NONE_MOVEMENT;
+
+  if ( iRandomBelowFrom(&pstWorker->uiRandomState, 8) != 0 && iMctsNearestDot(pstWorker, &iMove) > 0 ) return iMove;
+  for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+    if ( !bMctsWall(&pstWorker->stGame, iMove) ) aiOpen[iCtOpen++] = iMove;
+  }
+  if ( iCtOpen == 0 ) return NONE_MOVEMENT;
+  return aiOpen[iRandomBelowFrom(&pstWorker->uiRandomState, iCtOpen)];
+}
+
+static double dMctsStep(PSTRUCT_MCTS_WORKER pstWorker, int iMove, double* pdDiscount) {
+  PSTRUCT_GAME_STATE pstState = &pstWorker->stGame;
+  STRUCT_RULE_EVENTS stEvents;
+  int iScore = pstState->iCurrentLevelScore;
+  boolean bTimeOut = pstState->ucTimeOut;
+  double dReward = 0.0;
+
+  memset(&stEvents, 0x00, sizeof(stEvents));
+  vStepGameState(pstState, iMove, &stEvents);
+  pstWorker->ulSteps++;
+  dReward = (double) (pstState->iCurrentLevelScore - iScore) / MCTS_SCORE_SCALE;
+  dReward -= MCTS_DEATH_PENALTY * (double) stEvents.iHeroDeaths;
+  if ( pstState->ucTimeOut && !bTimeOut ) dReward -= MCTS_TIME_OUT_PENALTY;
+  if ( !pstState->ucGameOver && pstState->iCurrentLevelScore == pstState->iTotalCurrentLevelScore ) dReward += MCTS_LEVEL_BONUS;
+  dReward *= *pdDiscount;
+  *pdDiscount *= MCTS_DISCOUNT;
+  return dReward;
+}
+
+static void vMctsIterate(PSTRUCT_MCTS_WORKER pstWorker) {
+  int aiPath[MCTS_HORIZON_TICKS + 1];
+  int iCtPath = 0;
+  int iNode = 0;
+  int iTick = 0;
+  boolean bInTree = TRUE;
+  double dReturn = 0.0;
+  double dDiscount = 1.0;
+  double dValue = 0.0;
+
+  memcpy(&pstWorker->stGame, &gstMcts.stRoot, sizeof(pstWorker->stGame));
+  /* The ghosts of the copy are not the ones of the game, no peeking */
+  pstWorker->stGame.uiRandomState = uiRandomFrom(&pstWorker->uiRandomState);
+  aiPath[iCtPath++] = iNode;
+  for ( iTick = 0; iTick < MCTS_HORIZON_TICKS && !bGameStateEnded(&pstWorker->stGame); iTick++ ) {
+    int iMove = NONE_MOVEMENT;
+    if ( bInTree ) {
+      int iChild = 0;
+      iMove = iMctsSelect(pstWorker, iNode);
+      if ( (iChild = pstWorker->astNode[iNode].aiChild[iMove]) < 0 ) {
+        /* One node added per iteration, the rest is rolled out */
+        bInTree = FALSE;
+        if ( (iChild = iMctsNewNode(pstWorker)) >= 0 ) {
+          pstWorker->astNode[iNode].aiChild[iMove] = iChild;
+          aiPath[iCtPath++] = iChild;
+        }
+      }
+      else {
+        iNode = iChild;
+        aiPath[iCtPath++] = iNode;
+      }
+    }
+    else {
+      iMove = iMctsRolloutMove(pstWorker);
+    }
+    dReturn += dMctsStep(pstWorker, iMove, &dDiscount);
+  }
+  if ( !bGameStateEnded(&pstWorker->stGame) ) {
+    int iMove = NONE_MOVEMENT;
+    int iDistance = iMctsNearestDot(pstWorker, &iMove);
+    if ( iDistance > 0 ) dReturn += dDiscount * MCTS_NEAR_DOT_BONUS / (double) iDistance;
+  }
+  pstWorker->ulRollouts++;
+
+  /* To [0, 1], the range UCB1 expects: a dot on each tick is 1, a death 0 */
+  dValue = 0.5 + 0.5 * dReturn / gstMcts.dFullReturn;
+  if ( dValue < 0.0 ) dValue = 0.0;
+  if ( dValue > 1.0 ) dValue = 1.0;
+  while ( iCtPath > 0 ) {
+    PSTRUCT_MCTS_NODE pstNode = &pstWorker->astNode[aiPath[--iCtPath]];
+    pstNode->uiVisits++;
+    pstNode->dReward += dValue;
+  }
+}
+
+static void vMctsSearch(PSTRUCT_MCTS_WORKER pstWorker) {
+  vTimelineBegin("search");
+  pstWorker->iCtNodes = 0;
+  pstWorker->ulRollouts = 0;
+  pstWorker->ulSteps = 0;
+  iMctsNewNode(pstWorker);
+  do {
+    vMctsIterate(pstWorker);
+  } while ( ullGetMicroseconds() < gstMcts.ullDeadline );
+  vTimelineEnd("search");
+}
+
+static int iMctsThread(void* pvData) {
+  PSTRUCT_MCTS_WORKER pstWorker = (PSTRUCT_MCTS_WORKER) pvData;
+  vTimelineThreadName("mcts");
+  while ( TRUE ) {
+    SDL_SemWait(pstWorker->pstStart);
+    if ( SDL_AtomicGet(&gstMcts.stQuit) ) break;
+    vMctsSearch(pstWorker);
+    SDL_SemPost(gstMcts.pstDone);
+  }
+  return 0;
+}
+
+void vSetMctsParams(int iBudgetMs, int iThreads) {
+  gstMcts.iBudgetMs = iBudgetMs > 0 ? iBudgetMs : MCTS_DEFAULT_BUDGET_MS;
+  gstMcts.iCtThreads = iThreads > 0 ? iThreads : 0;
+}
+
+boolean bMctsInit(Uint32 uiSeed) {
+  int iCtWorkers = gstMcts.iCtThreads > 0 ? gstMcts.iCtThreads : SDL_GetCPUCount();
+  double dDiscount = 1.0;
+  int ii = 0;
+
+  if ( iCtWorkers < 1 ) iCtWorkers = 1;
+  if ( iCtWorkers > MCTS_MAX_THREADS ) iCtWorkers = MCTS_MAX_THREADS;
+  if ( (gstMcts.pstWorker = (PSTRUCT_MCTS_WORKER) calloc((size_t) iCtWorkers, sizeof(STRUCT_MCTS_WORKER))) == NULL ) {
+    fprintf(stderr, "E: Impossible to allocate the trees of [%d] searches\n", iCtWorkers);
+    return FALSE;
+  }
+  SDL_AtomicSet(&gstMcts.stQuit, 0);
+  gstMcts.ulDecisions = 0;
+  gstMcts.ulRollouts = 0;
+  gstMcts.ulSteps = 0;
+  gstMcts.ullSearchUs = 0;
+  gstMcts.dFullReturn = 0.0;
+  for ( ii = 0, dDiscount = 1.0; ii < MCTS_HORIZON_TICKS; ii++, dDiscount *= MCTS_DISCOUNT ) {
+    gstMcts.dFullReturn += dDiscount * 10.0 / MCTS_SCORE_SCALE;
+  }
+  for ( ii = 0; ii < iCtWorkers; ii++ ) {
+    /* A stream per worker, else they would all grow the same tree */
+    gstMcts.pstWorker[ii].uiRandomState = uiSeed ^ ((Uint32) (ii + 1) * 0x9E3779B9u);
+    if ( gstMcts.pstWorker[ii].uiRandomState == 0 ) gstMcts.pstWorker[ii].uiRandomState = RNG_DEFAULT_SEED;
+    /* Once, each breadth first search clears the cells it reached */
+    memset(gstMcts.pstWorker[ii].aiDistance, 0xFF, sizeof(gstMcts.pstWorker[ii].aiDistance));
+  }
+  gstMcts.iCtWorkers = 1;
+  if ( iCtWorkers > 1 && (gstMcts.pstDone = SDL_CreateSemaphore(0)) == NULL ) {
+    if ( DEBUG_WARNING ) vTrace("W: Impossible to create the mcts semaphore: [%s]", SDL_GetError());
+    return TRUE;
+  }
+  for ( ii = 1; ii < iCtWorkers; ii++ ) {
+    PSTRUCT_MCTS_WORKER pstWorker = &gstMcts.pstWorker[ii];
+    if ( (pstWorker->pstStart = SDL_CreateSemaphore(0)) == NULL ) {
+      if ( DEBUG_WARNING ) vTrace("W: Impossible to create the mcts semaphore: [%s]", SDL_GetError());
+      break;
+    }
+    if ( (pstWorker->pstThread = SDL_CreateThread(iMctsThread, "mcts", pstWorker)) == NULL ) {
+      if ( DEBUG_WARNING ) vTrace("W: Impossible to create the mcts thread: [%s]", SDL_GetError());
+      SDL_DestroySemaphore(pstWorker->pstStart);
+      pstWorker->pstStart = NULL;
+      break;
+    }
+    gstMcts.iCtWorkers++;
+  }
+  if ( DEBUG_INFO ) vTrace("MCTS agent: [%d] searches of [%d] ms", gstMcts.iCtWorkers, gstMcts.iBudgetMs);
+  return TRUE;
+}
+
+int iMctsAct(const STRUCT_GAME_STATE* kpstState) {
+  Uint32 auiVisits[4];
+  Uint64 ullStart = 0;
+  int iBest = NONE_MOVEMENT;
+  int iMove = 0;
+  int ii = 0;
+
+  if ( !gstMcts.pstWorker || bGameStateEnded(kpstState) ) return NONE_MOVEMENT;
+  memcpy(&gstMcts.stRoot, kpstState, sizeof(gstMcts.stRoot));
+  ullStart = ullGetMicroseconds();
+  gstMcts.ullDeadline = ullStart + (Uint64) gstMcts.iBudgetMs * 1000UL;
+  for ( ii = 1; ii < gstMcts.iCtWorkers; ii++ ) {
+    SDL_SemPost(gstMcts.pstWorker[ii].pstStart);
+  }
+  vMctsSearch(&gstMcts.pstWorker[0]);
+  for ( ii = 1; ii < gstMcts.iCtWorkers; ii++ ) {
+    SDL_SemWait(gstMcts.pstDone);
+  }
+  gstMcts.ullSearchUs += ullGetMicroseconds() - ullStart;
+  gstMcts.ulDecisions++;
+
+  memset(auiVisits, 0x00, sizeof(auiVisits));
+  for ( ii = 0; ii < gstMcts.iCtWorkers; ii++ ) {
+    PSTRUCT_MCTS_WORKER pstWorker = &gstMcts.pstWorker[ii];
+    gstMcts.ulRollouts += pstWorker->ulRollouts;
+    gstMcts.ulSteps += pstWorker->ulSteps;
+    for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+      int iChild = pstWorker->astNode[0].aiChild[iMove];
+      if ( iChild >= 0 ) auiVisits[iMove] += pstWorker->astNode[iChild].uiVisits;
+    }
+  }
+  /* The most visited move is the most robust, the best mean may be luck */
+  for ( iMove = UP_MOVEMENT; iMove <= RIGHT_MOVENT; iMove++ ) {
+    if ( iBest == NONE_MOVEMENT || auiVisits[iMove] > auiVisits[iBest] ) iBest = iMove;
+  }
+  return iBest;
+}
+
+void vMctsClose(void) {
+  int ii = 0;
+
+  if ( !gstMcts.pstWorker ) return;
+  SDL_AtomicSet(&gstMcts.stQuit, 1);
+  for ( ii = 1; ii < gstMcts.iCtWorkers; ii++ ) {
+    PSTRUCT_MCTS_WORKER pstWorker = &gstMcts.pstWorker[ii];
+    SDL_SemPost(pstWorker->pstStart);
+    SDL_WaitThread(pstWorker->pstThread, NULL);
+    SDL_DestroySemaphore(pstWorker->pstStart);
+  }
+  if ( gstMcts.pstDone ) SDL_DestroySemaphore(gstMcts.pstDone);
+  gstMcts.pstDone = NULL;
+  free(gstMcts.pstWorker);
+  gstMcts.pstWorker = NULL;
+  gstMcts.iCtWorkers = 0;
+}
+
+void vPrintMctsStats(FILE* fpOut) {
+  double dSeconds = (double) gstMcts.ullSearchUs / 1000000.0;
+  if ( gstMcts.ulDecisions == 0 ) return;
+  fprintf(
+    fpOut, "MCTS: %d searches, %lu decisions, %lu rollouts, %lu ticks in %.3f s (%.0f rollouts/s, %.0f ticks/s)\n",
+    gstMcts.iCtWorkers, gstMcts.ulDecisions, gstMcts.ulRollouts, gstMcts.ulSteps, dSeconds,
+    dSeconds > 0.0 ? (double) gstMcts.ulRollouts / dSeconds : 0.0,
+    dSeconds > 0.0 ? (double) gstMcts.ulSteps / dSeconds : 0.0
+  );
+}
@@ -0,0 +1,380 @@
+/**
+ * @file overlay.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gui.h"
+#include "overlay.h"
+#include "sim.h"
+#include "timeline.h"
+#include "replay.h"
+
+/**
+ * @def MAX_OVERLAY
+ * @brief Maximum overlays waiting to be shown
+ */
+#define MAX_OVERLAY 4
+
+/**
+ * @struct STRUCT_OVERLAY_MSG
+ * @brief A message waiting in the overlay queue
+ */
+typedef struct STRUCT_OVERLAY_MSG {
+  char szMsg[256];            /**< Message                       */
+  char szFooterMsg[256];      /**< Footer message                */
+  PFNOVERLAYCLOSE pfnOnClose; /**< Function called when dismissed */
+  unsigned long ulSerial;     /**< Timeline id of the message     */
+} STRUCT_OVERLAY_MSG, *PSTRUCT_OVERLAY_MSG;
+
+/**
+ * @struct STRUCT_OVERLAY
+ * @brief State of the overlay layer
+ */
+typedef struct STRUCT_OVERLAY {
+  STRUCT_OVERLAY_MSG astQueue[MAX_OVERLAY]; /**< Messages, the first one is shown */
+  int iCtQueue;                             /**< Messages in the queue            */
+  boolean bDirty;                           /**< Frame must be drawn again        */
+  boolean bStale;                           /**< Textures of a closed message     */
+  TTF_Font* pstFont;                        /**< Message font                     */
+  TTF_Font* pstFooterFont;                  /**< Footer font                      */
+  SDL_Texture* pstMsgTexture;               /**< Cached message texture           */
+  SDL_Texture* pstFooterTexture;            /**< Cached footer texture            */
+  SDL_Rect stMsgRect;                       /**< Message texture size             */
+  SDL_Rect stFooterRect;                    /**< Footer texture size              */
+  PFNOVERLAYCLOSE apfnClosed[MAX_OVERLAY];  /**< Close functions not run yet      */
+  int iCtClosed;                            /**< Close functions waiting          */
+  unsigned long ulCtShown;                  /**< Messages queued since the start  */
+  int iCtDismissed;                         /**< Dismissed, not taken by the sim  */
+  SDL_mutex* pstMutex;                      /**< Guards the queues and flags      */
+} STRUCT_OVERLAY, *PSTRUCT_OVERLAY;
+
+/**
+ * @var gstOverlay
+ * @brief The overlay layer
+ */
+static STRUCT_OVERLAY gstOverlay;
+
+/**
+ * @brief Destroy the textures of the message shown
+ */
+static void vFreeOverlayTextures(void);
+
+/**
+ * @brief Open the fonts and render the textures of the message shown
+ *
+ * @return TRUE textures ready
+ * @return FALSE font or render error
+ */
+static boolean bLoadOverlayTextures(void);
+
+/**
+ * @brief Create a texture of a text
+ *
+ * @param pstFont Font
+ * @param kpszText Text
+ * @param pstRect Receives the size of the texture
+ * @return The texture or NULL on error
+ */
+static SDL_Texture* pstCreateTextTexture(TTF_Font* pstFont, const char* kpszText, SDL_Rect* pstRect);
+
+/**
+ * @brief Remove the message shown and hand its close function to the
+ * simulation
+ *
+ * May run on the simulation thread, so the textures are only marked stale
+ * and vDrawOverlay frees them on the render thread.
+ */
+static void vCloseOverlay(void);
+
+static void vFreeOverlayTextures(void) {
+  if ( gstOverlay.pstMsgTexture ) {
+    vGfxDestroyTexture(gstOverlay.pstMsgTexture);
+    gstOverlay.pstMsgTexture = NULL;
+  }
+  if ( gstOverlay.pstFooterTexture ) {
+    vGfxDestroyTexture(gstOverlay.pstFooterTexture);
+    gstOverlay.pstFooterTexture = NULL;
+  }
+}
+
+static SDL_Texture* pstCreateTextTexture(TTF_Font* pstFont, const char* kpszText, SDL_Rect* pstRect) {
+  SDL_Surface* pstSurface = NULL;
+  SDL_Texture* pstTexture = NULL;
+  SDL_Color stTextColor;
+
+  stTextColor.r = 0;
+  stTextColor.g = 0;
+  stTextColor.b = 0;
+  stTextColor.a = 255;
+
+  if ( bStrIsEmpty(kpszText) ) return NULL;
+  if ( (pstSurface = pstGfxRenderTextBlended(pstFont, kpszText, stTextColor)) == NULL ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to render the text [%s]: [%s]", kpszText, TTF_GetError());
+    return NULL;
+  }
+  pstTexture = pstGfxCreateTextureFromSurface(gpstRenderer, pstSurface);
+  pstRect->w = pstSurface->w;
+  pstRect->h = pstSurface->h;
+  SDL_FreeSurface(pstSurface);
+  return pstTexture;
+}
+
+static boolean bLoadOverlayTextures(void) {
+  char szFont[_MAX_PATH + 32] = "";
+
+  if ( gstOverlay.pstMsgTexture ) return TRUE;
+
+  memset(szFont, 0x00, sizeof(szFont));
+  sprintf(szFont, "%s%c%s", gszFontDir, DIR_SEPARATOR, FONT_NAME);
+  if ( !gstOverlay.pstFont && (gstOverlay.pstFont = pstGfxOpenFont(szFont, OVERLAY_FONT_SIZE)) == NULL ) {
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", szFont, TTF_GetError());
+    return FALSE;
+  }
+  if ( !gstOverlay.pstFooterFont && (gstOverlay.pstFooterFont = pstGfxOpenFont(szFont, OVERLAY_FOOTER_FONT_SIZE)) == NULL ) {
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to open the font [%s]: [%s]", szFont, TTF_GetError());
+    return FALSE;
+  }
+
+  gstOverlay.pstMsgTexture = pstCreateTextTexture(gstOverlay.pstFont, gstOverlay.astQueue[0].szMsg, &gstOverlay.stMsgRect);
+  gstOverlay.pstFooterTexture = pstCreateTextTexture(gstOverlay.pstFooterFont, gstOverlay.astQueue[0].szFooterMsg, &gstOverlay.stFooterRect);
+
+  if ( DEBUG_INFO ) {
+    vTrace("vDrawOverlay - %s", gstOverlay.astQueue[0].szMsg);
+    vTrace("vDrawOverlay - %s", gstOverlay.astQueue[0].szFooterMsg);
+  }
+
+  return gstOverlay.pstMsgTexture != NULL;
+}
+
+static void vCloseOverlay(void) {
+  PFNOVERLAYCLOSE pfnOnClose = NULL;
+  int ii = 0;
+
+  SDL_LockMutex(gstOverlay.pstMutex);
+  if ( gstOverlay.iCtQueue == 0 ) {
+    SDL_UnlockMutex(gstOverlay.pstMutex);
+    return;
+  }
+
+  pfnOnClose = gstOverlay.astQueue[0].pfnOnClose;
+  vTimelineAsyncEnd(gstOverlay.astQueue[0].szMsg, gstOverlay.astQueue[0].ulSerial);
+  for ( ii = 1; ii < gstOverlay.iCtQueue; ii++ ) {
+    gstOverlay.astQueue[ii-1] = gstOverlay.astQueue[ii];
+  }
+  gstOverlay.iCtQueue--;
+  gstOverlay.iCtDismissed++;
+  gstOverlay.bStale = TRUE;
+  gstOverlay.bDirty = TRUE;
+  /* The close functions change the game, only the simulation runs them */
+  if ( pfnOnClose ) gstOverlay.apfnClosed[gstOverlay.iCtClosed++] = pfnOnClose;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+
+  vWakeSimThread();
+}
+
+boolean bInitOverlay(void) {
+  if ( (gstOverlay.pstMutex = SDL_CreateMutex()) == NULL ) {
+    if ( DEBUG_FATAL ) vTrace("F: Impossible to create the overlay mutex: [%s]", SDL_GetError());
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void vShowOverlay(const char* kpszMsg, const char* kpszFooterMsg, PFNOVERLAYCLOSE pfnOnClose) {
+  PSTRUCT_OVERLAY_MSG pstMsg = NULL;
+
+  if ( bStrIsEmpty(kpszMsg) ) return;
+
+  SDL_LockMutex(gstOverlay.pstMutex);
+  /* Messages waiting for their close function count as shown */
+  if ( gstOverlay.iCtQueue + gstOverlay.iCtClosed == MAX_OVERLAY ) {
+    SDL_UnlockMutex(gstOverlay.pstMutex);
+    if ( DEBUG_WARNING ) vTrace("W: Overlay queue full, dropping [%s]", kpszMsg);
+    if ( pfnOnClose ) pfnOnClose();
+    return;
+  }
+
+  pstMsg = &gstOverlay.astQueue[gstOverlay.iCtQueue++];
+  memset(pstMsg, 0x00, sizeof(STRUCT_OVERLAY_MSG));
+  sprintf(pstMsg->szMsg, "%.*s", (int) sizeof(pstMsg->szMsg) - 1, kpszMsg);
+  if ( kpszFooterMsg ) {
+    sprintf(pstMsg->szFooterMsg, "%.*s", (int) sizeof(pstMsg->szFooterMsg) - 1, kpszFooterMsg);
+  }
+  pstMsg->pfnOnClose = pfnOnClose;
+  pstMsg->ulSerial = ++gstOverlay.ulCtShown;
+  /* The span ends on the main thread when the message is dismissed */
+  vTimelineAsyncBegin(pstMsg->szMsg, pstMsg->ulSerial);
+  gstOverlay.bDirty = TRUE;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+}
+
+boolean bOverlayActive(void) {
+  boolean bActive = FALSE;
+  SDL_LockMutex(gstOverlay.pstMutex);
+  bActive = gstOverlay.iCtQueue > 0;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+  return bActive;
+}
+
+boolean bOverlayDirty(void) {
+  boolean bDirty = FALSE;
+  SDL_LockMutex(gstOverlay.pstMutex);
+  bDirty = gstOverlay.bDirty;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+  return bDirty;
+}
+
+boolean bRunOverlayCallbacks(void) {
+  PFNOVERLAYCLOSE apfnClosed[MAX_OVERLAY];
+  int iCtClosed = 0;
+  int ii = 0;
+
+  SDL_LockMutex(gstOverlay.pstMutex);
+  iCtClosed = gstOverlay.iCtClosed;
+  for ( ii = 0; ii < iCtClosed; ii++ ) {
+    apfnClosed[ii] = gstOverlay.apfnClosed[ii];
+  }
+  gstOverlay.iCtClosed = 0;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+
+  for ( ii = 0; ii < iCtClosed; ii++ ) {
+    apfnClosed[ii]();
+  }
+  return iCtClosed > 0;
+}
+
+int iTakeOverlayDismissals(void) {
+  int iCtDismissed = 0;
+  SDL_LockMutex(gstOverlay.pstMutex);
+  iCtDismissed = gstOverlay.iCtDismissed;
+  gstOverlay.iCtDismissed = 0;
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+  return iCtDismissed;
+}
+
+void vDismissOverlays(int iCount) {
+  int ii = 0;
+  for ( ii = 0; ii < iCount; ii++ ) {
+    vCloseOverlay();
+  }
+}
+
+void vDrawOverlay(void) {
+  SDL_Rect stRect;
+  SDL_Rect stTextRect;
+  SDL_Rect stFooterTextRect;
+
+  SDL_LockMutex(gstOverlay.pstMutex);
+  /* The renderer only belongs to this thread */
+  if ( gstOverlay.bStale ) {
+    vFreeOverlayTextures();
+    gstOverlay.bStale = FALSE;
+  }
+  if ( gstOverlay.iCtQueue == 0 ) {
+    SDL_UnlockMutex(gstOverlay.pstMutex);
+    return;
+  }
+  gstOverlay.bDirty = FALSE;
+  if ( !bLoadOverlayTextures() ) {
+    SDL_UnlockMutex(gstOverlay.pstMutex);
+    return;
+  }
+
+  stRect.h = 100;
+  stRect.w = LOGICAL_WIDTH / 2;
+  stRect.x = (LOGICAL_WIDTH - stRect.w) / 2;
+  stRect.y = LOGICAL_HEIGHT / 4;
+
+  stTextRect = gstOverlay.stMsgRect;
+  stTextRect.x = stRect.x + (stRect.w - stTextRect.w) / 2;
+  stTextRect.y = stRect.y + (stRect.h - stTextRect.h) / 4;
+
+  stFooterTextRect = gstOverlay.stFooterRect;
+  stFooterTextRect.x = stRect.x + (stRect.w - stFooterTextRect.w) / 2;
+  stFooterTextRect.y = stRect.y + stRect.h - stFooterTextRect.h - 10;
+
+  iGfxSetRenderDrawColor(gpstRenderer, 255, 255, 255, 255);
+  iGfxRenderFillRect(gpstRenderer, &stRect);
+  iGfxSetRenderDrawColor(gpstRenderer, 0, 0, 0, 255);
+  iGfxRenderDrawRect(gpstRenderer, &stRect);
+  iGfxRenderCopy(gpstRenderer, gstOverlay.pstMsgTexture, NULL, &stTextRect);
+  if ( gstOverlay.pstFooterTexture ) {
+    iGfxRenderCopy(gpstRenderer, gstOverlay.pstFooterTexture, NULL, &stFooterTextRect);
+  }
+  SDL_UnlockMutex(gstOverlay.pstMutex);
+}
+
+void vHandleOverlayEvents(void) {
+  /* A replay dismisses the overlays itself, the keys are ignored */
+  boolean bReplay = eGetReplayMode() == REPLAY_PLAY;
+
+  /* Nobody can press a key offscreen, dismiss once it was presented */
+  if ( giOffscreenFrames > 0 ) {
+    if ( !bReplay && !bOverlayDirty() ) vCloseOverlay();
+    return;
+  }
+  /* Don't block before the overlay was presented */
+  if ( bOverlayDirty() || bReplay ) {
+    if ( !SDL_PollEvent(&gunEvent) ) return;
+  }
+  else if ( !SDL_WaitEventTimeout(&gunEvent, OVERLAY_WAIT_TIMEOUT) ) {
+    return;
+  }
+  do {
+    switch ( gunEvent.type ) {
+      case SDL_QUIT: {
+        gbRun = FALSE;
+        vCloseOverlay();
+        return;
+      }
+      case SDL_KEYDOWN: {
+        if ( bReplay ) break;
+        vCloseOverlay();
+        return;
+      }
+      case SDL_WINDOWEVENT: {
+        vHandleWindowEvent();
+        SDL_LockMutex(gstOverlay.pstMutex);
+        gstOverlay.bDirty = TRUE;
+        SDL_UnlockMutex(gstOverlay.pstMutex);
+        break;
+      }
+      default: break;
+    }
+  } while ( SDL_PollEvent(&gunEvent) );
+}
+
+void vDestroyOverlay(void) {
+  vFreeOverlayTextures();
+  if ( gstOverlay.pstFooterFont ) {
+    TTF_CloseFont(gstOverlay.pstFooterFont);
+    gstOverlay.pstFooterFont = NULL;
+  }
+  if ( gstOverlay.pstFont ) {
+    TTF_CloseFont(gstOverlay.pstFont);
+    gstOverlay.pstFont = NULL;
+  }
+  gstOverlay.iCtQueue = 0;
+  gstOverlay.iCtClosed = 0;
+  if ( gstOverlay.pstMutex ) {
+    SDL_DestroyMutex(gstOverlay.pstMutex);
+    gstOverlay.pstMutex = NULL;
+  }
+}
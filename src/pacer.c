@@ -0,0 +1,171 @@
+/**
+ * @file pacer.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "pacer.h"
+
+/**
+ * @struct STRUCT_FRAME_PACER
+ * @brief State of the frame pacer
+ */
+typedef struct STRUCT_FRAME_PACER {
+  ENUM_PACING ePacing;                        /**< How the frame end is waited    */
+  Uint64 ullPeriod;                           /**< Frame period (us)              */
+  Uint64 ullFrameStart;                       /**< Start of the current frame     */
+  Uint64 ullDeadline;                         /**< End of the current frame       */
+  boolean bHasFrame;                          /**< ullFrameStart is valid         */
+  Uint32 auiFrameTime[FRAME_STATS_WINDOW];    /**< Last frame times (us)          */
+  int iNextFrame;                             /**< Next slot of auiFrameTime      */
+  int iCtFrames;                              /**< Used slots of auiFrameTime     */
+} STRUCT_FRAME_PACER, *PSTRUCT_FRAME_PACER;
+
+/**
+ * @var gstPacer
+ * @brief The frame pacer
+ */
+static STRUCT_FRAME_PACER gstPacer;
+
+/**
+ * @brief Compare two frame times for qsort
+ *
+ * @param kpvA First frame time
+ * @param kpvB Second frame time
+ * @return Negative, zero or positive like strcmp
+ */
+static int iCompareFrameTime(const void* kpvA, const void* kpvB);
+
+static int iCompareFrameTime(const void* kpvA, const void* kpvB) {
+  Uint32 uiA = *(const Uint32*) kpvA;
+  Uint32 uiB = *(const Uint32*) kpvB;
+  return uiA < uiB ? -1 : (uiA > uiB ? 1 : 0);
+}
+
+Uint64 ullGetMicroseconds(void) {
+  Uint64 ullCounter = SDL_GetPerformanceCounter();
+  Uint64 ullFrequency = SDL_GetPerformanceFrequency();
+  /* Split the conversion so the counter can't overflow */
+  return (ullCounter / ullFrequency) * 1000000UL + (ullCounter % ullFrequency) * 1000000UL / ullFrequency;
+}
+
+boolean bParsePacing(const char* kpszPacing, PENUM_PACING pePacing) {
+  if ( !strcmp(kpszPacing, "hybrid") ) *pePacing = PACING_HYBRID;
+  else if ( !strcmp(kpszPacing, "vsync") ) *pePacing = PACING_VSYNC;
+  else if ( !strcmp(kpszPacing, "unlimited") ) *pePacing = PACING_UNLIMITED;
+  else return FALSE;
+  return TRUE;
+}
+
+void vInitFramePacer(ENUM_PACING ePacing, int iFps) {
+  memset(&gstPacer, 0x00, sizeof(gstPacer));
+  gstPacer.ePacing = ePacing;
+  gstPacer.ullPeriod = 1000000UL / (Uint64) (iFps > 0 ? iFps : 1);
+}
+
+void vBeginFrame(void) {
+  Uint64 ullNow = ullGetMicroseconds();
+
+  if ( gstPacer.bHasFrame ) {
+    Uint64 ullFrameTime = ullNow - gstPacer.ullFrameStart;
+    gstPacer.auiFrameTime[gstPacer.iNextFrame] = (Uint32) (ullFrameTime > 0xFFFFFFFFUL ? 0xFFFFFFFFUL : ullFrameTime);
+    gstPacer.iNextFrame = (gstPacer.iNextFrame + 1) % FRAME_STATS_WINDOW;
+    if ( gstPacer.iCtFrames < FRAME_STATS_WINDOW ) gstPacer.iCtFrames++;
+    /* Deadlines follow each other so the error of one frame doesn't drift */
+    gstPacer.ullDeadline += gstPacer.ullPeriod;
+    if ( gstPacer.ullDeadline + gstPacer.ullPeriod < ullNow ) {
+      gstPacer.ullDeadline = ullNow + gstPacer.ullPeriod;
+    }
+  }
+  else {
+    gstPacer.ullDeadline = ullNow + gstPacer.ullPeriod;
+  }
+  gstPacer.ullFrameStart = ullNow;
+  gstPacer.bHasFrame = TRUE;
+}
+
+void vEndFrame(void) {
+  Uint64 ullNow = ullGetMicroseconds();
+
+  switch ( gstPacer.ePacing ) {
+    case PACING_UNLIMITED: break;
+    case PACING_VSYNC: {
+      /* Present already waited the display, only sleep a longer period */
+      if ( ullNow < gstPacer.ullDeadline ) {
+        SDL_Delay((Uint32) ((gstPacer.ullDeadline - ullNow) / 1000UL));
+      }
+      break;
+    }
+    case PACING_HYBRID:
+    default: {
+      if ( ullNow + PACER_SPIN_US < gstPacer.ullDeadline ) {
+        SDL_Delay((Uint32) ((gstPacer.ullDeadline - ullNow - PACER_SPIN_US) / 1000UL));
+      }
+      while ( ullGetMicroseconds() < gstPacer.ullDeadline ) {
+        /* Spin the last part, SDL_Delay oversleeps */
+      }
+      break;
+    }
+  }
+}
+
+void vSkipFrame(void) {
+  gstPacer.bHasFrame = FALSE;
+}
+
+void vGetFrameStats(PSTRUCT_FRAME_STATS pstStats) {
+  static Uint32 auiSorted[FRAME_STATS_WINDOW];
+  Uint64 ullSum = 0;
+  int ii = 0;
+  int iCt = gstPacer.iCtFrames;
+  size_t ulLast = 0;
+
+  memset(pstStats, 0x00, sizeof(STRUCT_FRAME_STATS));
+  if ( iCt == 0 ) return;
+
+  memcpy(auiSorted, gstPacer.auiFrameTime, sizeof(Uint32) * (size_t) iCt);
+  qsort(auiSorted, (size_t) iCt, sizeof(Uint32), iCompareFrameTime);
+  ulLast = (size_t) iCt - 1;
+  for ( ii = 0; ii < iCt; ii++ ) {
+    ullSum += auiSorted[ii];
+  }
+  pstStats->iCtFrames = iCt;
+  pstStats->uiAvg = (Uint32) (ullSum / (Uint64) iCt);
+  pstStats->uiMin = auiSorted[0];
+  pstStats->uiMax = auiSorted[iCt - 1];
+  pstStats->uiP50 = auiSorted[ulLast * 50 / 100];
+  pstStats->uiP95 = auiSorted[ulLast * 95 / 100];
+  pstStats->uiP99 = auiSorted[ulLast * 99 / 100];
+}
+
+void vPrintFrameStats(FILE* fpOut) {
+  STRUCT_FRAME_STATS stStats;
+  vGetFrameStats(&stStats);
+  fprintf(
+    fpOut,
+    "frame time (last %d frames, ms): avg %.3f min %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f\n",
+    stStats.iCtFrames,
+    stStats.uiAvg / 1000.0,
+    stStats.uiMin / 1000.0,
+    stStats.uiP50 / 1000.0,
+    stStats.uiP95 / 1000.0,
+    stStats.uiP99 / 1000.0,
+    stStats.uiMax / 1000.0
+  );
+}
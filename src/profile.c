@@ -0,0 +1,211 @@
+/**
+ * @file profile.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "gui.h"
+#include "glyph.h"
+#include "pacer.h"
+#include "profile.h"
+
+/**
+ * @struct STRUCT_PROFILER
+ * @brief State of the frame profiler, the last row of the window is the time
+ * of the whole frame
+ */
+typedef struct STRUCT_PROFILER {
+  Uint64 aullPhaseStart[PROFILE_PHASE_COUNT];                  /**< vProfileBegin time          */
+  SDL_atomic_t astPhaseTime[PROFILE_PHASE_COUNT];              /**< Time in the current frame   */
+  Uint32 aauiWindow[PROFILE_PHASE_COUNT + 1][PROFILE_WINDOW];  /**< Last frame times (us)       */
+  int iNextFrame;                                              /**< Next slot of aauiWindow     */
+  int iCtFrames;                                               /**< Used slots of aauiWindow    */
+  Uint64 ullFrameStart;                                        /**< Start of the current frame  */
+  unsigned long ulFrame;                                       /**< Frames written to the CSV   */
+  boolean bShowOverlay;                                        /**< Overlay shown               */
+  FILE* fpOut;                                                 /**< CSV file or NULL            */
+} STRUCT_PROFILER, *PSTRUCT_PROFILER;
+
+/**
+ * @var gstProfiler
+ * @brief The frame profiler
+ */
+static STRUCT_PROFILER gstProfiler;
+
+/**
+ * @var gkapszProfilePhase
+ * @brief Names of the phases, indexed by ENUM_PROFILE_PHASE
+ */
+static const char* gkapszProfilePhase[PROFILE_PHASE_COUNT + 1] = {
+  "events",
+  "hero",
+  "ghosts",
+  "map",
+  "info",
+  "present",
+  "frame"
+};
+
+boolean bOpenProfileOutput(const char* kpszPath) {
+  int ii = 0;
+
+  if ( (gstProfiler.fpOut = fopen(kpszPath, "w")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    return FALSE;
+  }
+  fprintf(gstProfiler.fpOut, "frame");
+  for ( ii = 0; ii <= PROFILE_PHASE_COUNT; ii++ ) {
+    fprintf(gstProfiler.fpOut, ",%s_us", gkapszProfilePhase[ii]);
+  }
+  for ( ii = 0; ii < GFX_COUNTER_COUNT; ii++ ) {
+    fprintf(gstProfiler.fpOut, ",%s", kpszGfxCounterName((ENUM_GFX_COUNTER) ii));
+  }
+  fprintf(gstProfiler.fpOut, "\n");
+  return TRUE;
+}
+
+void vProfileBegin(ENUM_PROFILE_PHASE ePhase) {
+  gstProfiler.aullPhaseStart[ePhase] = ullGetMicroseconds();
+}
+
+void vProfileEnd(ENUM_PROFILE_PHASE ePhase) {
+  Uint64 ullElapsed = ullGetMicroseconds() - gstProfiler.aullPhaseStart[ePhase];
+  SDL_AtomicAdd(&gstProfiler.astPhaseTime[ePhase], (int) ullElapsed);
+}
+
+void vEndProfileFrame(void) {
+  Uint64 ullNow = ullGetMicroseconds();
+  STRUCT_GFX_STATS stGfxStats;
+  int iSlot = gstProfiler.iNextFrame;
+  int ii = 0;
+
+  vEndGfxFrame();
+
+  /* The moves of the simulation thread land in the frame they end in */
+  for ( ii = 0; ii < PROFILE_PHASE_COUNT; ii++ ) {
+    gstProfiler.aauiWindow[ii][iSlot] = (Uint32) SDL_AtomicSet(&gstProfiler.astPhaseTime[ii], 0);
+  }
+  gstProfiler.aauiWindow[PROFILE_PHASE_COUNT][iSlot] = gstProfiler.ullFrameStart > 0 ? (Uint32) (ullNow - gstProfiler.ullFrameStart) : 0;
+  gstProfiler.ullFrameStart = ullNow;
+  gstProfiler.iNextFrame = (iSlot + 1) % PROFILE_WINDOW;
+  if ( gstProfiler.iCtFrames < PROFILE_WINDOW ) gstProfiler.iCtFrames++;
+
+  if ( !gstProfiler.fpOut ) return;
+  fprintf(gstProfiler.fpOut, "%lu", gstProfiler.ulFrame++);
+  for ( ii = 0; ii <= PROFILE_PHASE_COUNT; ii++ ) {
+    fprintf(gstProfiler.fpOut, ",%u", (unsigned int) gstProfiler.aauiWindow[ii][iSlot]);
+  }
+  for ( ii = 0; ii < GFX_COUNTER_COUNT; ii++ ) {
+    vGetGfxStats((ENUM_GFX_COUNTER) ii, &stGfxStats);
+    fprintf(gstProfiler.fpOut, ",%u", (unsigned int) stGfxStats.uiLast);
+  }
+  fprintf(gstProfiler.fpOut, "\n");
+}
+
+void vSkipProfileFrame(void) {
+  int ii = 0;
+  vSkipGfxFrame();
+  for ( ii = 0; ii < PROFILE_PHASE_COUNT; ii++ ) {
+    SDL_AtomicSet(&gstProfiler.astPhaseTime[ii], 0);
+  }
+  gstProfiler.ullFrameStart = ullGetMicroseconds();
+}
+
+void vGetProfileStats(ENUM_PROFILE_PHASE ePhase, PSTRUCT_PROFILE_STATS pstStats) {
+  Uint64 ullSum = 0;
+  int ii = 0;
+
+  memset(pstStats, 0x00, sizeof(STRUCT_PROFILE_STATS));
+  if ( gstProfiler.iCtFrames == 0 ) return;
+
+  for ( ii = 0; ii < gstProfiler.iCtFrames; ii++ ) {
+    Uint32 uiTime = gstProfiler.aauiWindow[ePhase][ii];
+    ullSum += uiTime;
+    if ( uiTime > pstStats->uiMax ) pstStats->uiMax = uiTime;
+  }
+  pstStats->uiAvg = (Uint32) (ullSum / (Uint64) gstProfiler.iCtFrames);
+  pstStats->uiLast = gstProfiler.aauiWindow[ePhase][(gstProfiler.iNextFrame + PROFILE_WINDOW - 1) % PROFILE_WINDOW];
+}
+
+void vToggleProfileOverlay(void) {
+  gstProfiler.bShowOverlay = !gstProfiler.bShowOverlay;
+}
+
+void vDrawProfileOverlay(void) {
+  static const int kiPadding = 4;
+  char aszLine[PROFILE_OVERLAY_LINES][64];
+  PSTRUCT_GLYPH_ATLAS pstAtlas = NULL;
+  STRUCT_PROFILE_STATS stStats;
+  STRUCT_GFX_STATS stGfxStats;
+  int iLine = 0;
+  SDL_Color stTextColor;
+  SDL_Rect stBox;
+  int ii = 0;
+
+  if ( !gstProfiler.bShowOverlay ) return;
+  if ( (pstAtlas = pstGetGlyphAtlas(PROFILE_FONT_SIZE)) == NULL ) return;
+
+  sprintf(aszLine[iLine++], "%-8s %7s %7s %7s", "ms", "last", "avg", "max");
+  for ( ii = 0; ii <= PROFILE_PHASE_COUNT; ii++ ) {
+    vGetProfileStats((ENUM_PROFILE_PHASE) ii, &stStats);
+    sprintf(
+      aszLine[iLine++], "%-8s %7.2f %7.2f %7.2f", gkapszProfilePhase[ii],
+      stStats.uiLast / 1000.0, stStats.uiAvg / 1000.0, stStats.uiMax / 1000.0
+    );
+  }
+  sprintf(aszLine[iLine++], "%-18s %9s %9s %9s", "per frame", "last", "avg", "max");
+  for ( ii = 0; ii < GFX_COUNTER_COUNT; ii++ ) {
+    vGetGfxStats((ENUM_GFX_COUNTER) ii, &stGfxStats);
+    sprintf(
+      aszLine[iLine++], "%-18s %9u %9u %9u", kpszGfxCounterName((ENUM_GFX_COUNTER) ii),
+      (unsigned int) stGfxStats.uiLast, (unsigned int) stGfxStats.uiAvg, (unsigned int) stGfxStats.uiMax
+    );
+  }
+
+  stBox.w = 0;
+  for ( ii = 0; ii < PROFILE_OVERLAY_LINES; ii++ ) {
+    int iWidth = iGlyphTextWidth(pstAtlas, aszLine[ii]);
+    if ( iWidth > stBox.w ) stBox.w = iWidth;
+  }
+  stBox.w += 2 * kiPadding;
+  stBox.h = PROFILE_OVERLAY_LINES * pstAtlas->iHeight + 2 * kiPadding;
+  stBox.x = LOGICAL_WIDTH - stBox.w - 10;
+  stBox.y = 30;
+
+  SDL_SetRenderDrawBlendMode(gpstRenderer, SDL_BLENDMODE_BLEND);
+  iGfxSetRenderDrawColor(gpstRenderer, 0, 0, 0, 180);
+  iGfxRenderFillRect(gpstRenderer, &stBox);
+  SDL_SetRenderDrawBlendMode(gpstRenderer, SDL_BLENDMODE_NONE);
+
+  stTextColor.r = 255;
+  stTextColor.g = 255;
+  stTextColor.b = 0;
+  stTextColor.a = 255;
+  for ( ii = 0; ii < PROFILE_OVERLAY_LINES; ii++ ) {
+    iDrawGlyphText(gpstRenderer, pstAtlas, stBox.x + kiPadding, stBox.y + kiPadding + ii * pstAtlas->iHeight, aszLine[ii], stTextColor);
+  }
+}
+
+void vCloseProfile(void) {
+  if ( !gstProfiler.fpOut ) return;
+  fclose(gstProfiler.fpOut);
+  gstProfiler.fpOut = NULL;
+}
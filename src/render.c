@@ -0,0 +1,266 @@
+/**
+ * @file render.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "gui.h"
+#include "render.h"
+
+/**
+ * @struct STRUCT_WALL_CHUNK
+ * @brief A cached chunk of the walls
+ */
+typedef struct STRUCT_WALL_CHUNK {
+  SDL_Texture* pstTexture; /**< Walls of the chunk, NULL when free */
+  int iChunkRow;           /**< Row of the chunk                   */
+  int iChunkCol;           /**< Col of the chunk                   */
+  Uint32 uiLastUse;        /**< guiChunkClock of the last use      */
+} STRUCT_WALL_CHUNK, *PSTRUCT_WALL_CHUNK;
+
+/**
+ * @var gastWallChunk
+ * @brief Wall chunks prescaled to the output resolution
+ */
+static STRUCT_WALL_CHUNK gastWallChunk[MAX_WALL_CHUNKS];
+
+/**
+ * @var guiChunkClock
+ * @brief Incremented on each chunk lookup, orders the chunks by use
+ */
+static Uint32 guiChunkClock = 0;
+
+/**
+ * @var gpstMinimap
+ * @brief Walls of the whole map, one texel per cell
+ */
+static SDL_Texture* gpstMinimap = NULL;
+/**
+ * @var gpstDotTexture
+ * @brief Dot prescaled to the output resolution
+ */
+static SDL_Texture* gpstDotTexture = NULL;
+
+/**
+ * @var gpstPowerTexture
+ * @brief Power prescaled to the output resolution
+ */
+static SDL_Texture* gpstPowerTexture = NULL;
+
+/**
+ * @brief Convert a logical size that may be fractional to output pixels
+ *
+ * @param fLogical Logical size
+ * @return Pixel size
+ */
+static int iToPixelF(float fLogical);
+
+/**
+ * @brief Render the walls of a chunk in a new texture
+ *
+ * @param aszMap Map
+ * @param iChunkRow Row of the chunk
+ * @param iChunkCol Col of the chunk
+ * @return The texture or NULL on error
+ */
+static SDL_Texture* pstCreateWallChunk(char aszMap[MAP_ROW][MAP_COL], int iChunkRow, int iChunkCol);
+
+/**
+ * @brief Create a white filled circle texture with the size of a cell
+ *
+ * @param iDivisor Radius is the smaller cell side divided by iDivisor
+ * @return The texture or NULL on error
+ */
+static SDL_Texture* pstCreateCircleTexture(int iDivisor);
+
+static int iToPixelF(float fLogical) {
+  return (int) (fLogical * gfRenderScale + 0.5f);
+}
+
+static SDL_Texture* pstCreateCircleTexture(int iDivisor) {
+  SDL_Surface* pstSurface = NULL;
+  SDL_Texture* pstTexture = NULL;
+  int iWidth = iToPixelF(gstCamera.fCellWidth);
+  int iHeight = iToPixelF(gstCamera.fCellHeight);
+  int iRadius = (iWidth < iHeight ? iWidth : iHeight) / iDivisor;
+  int iCenterX = iWidth / 2;
+  int iCenterY = iHeight / 2;
+  int iX = 0;
+  int iY = 0;
+
+  pstSurface = pstGfxCreateRGBSurfaceWithFormat(0, iWidth, iHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  if ( !pstSurface ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to create the circle surface: [%s]", SDL_GetError());
+    return NULL;
+  }
+  SDL_LockSurface(pstSurface);
+  for ( iY = 0; iY < iHeight; iY++ ) {
+    Uint32* puiRow = (Uint32*) ((Uint8*) pstSurface->pixels + iY * pstSurface->pitch);
+    for ( iX = 0; iX < iWidth; iX++ ) {
+      int iDX = iX - iCenterX;
+      int iDY = iY - iCenterY;
+      puiRow[iX] = iDX * iDX + iDY * iDY <= iRadius * iRadius ? 0xFFFFFFFFu : 0x00000000u;
+    }
+  }
+  SDL_UnlockSurface(pstSurface);
+
+  pstTexture = pstGfxCreateTextureFromSurface(gpstRenderer, pstSurface);
+  SDL_FreeSurface(pstSurface);
+  if ( pstTexture ) SDL_SetTextureBlendMode(pstTexture, SDL_BLENDMODE_BLEND);
+  return pstTexture;
+}
+
+static SDL_Texture* pstCreateWallChunk(char aszMap[MAP_ROW][MAP_COL], int iChunkRow, int iChunkCol) {
+  SDL_Surface* pstSurface = NULL;
+  SDL_Texture* pstTexture = NULL;
+  SDL_RendererInfo stInfo;
+  int iFirstRow = iChunkRow * WALL_CHUNK_CELLS;
+  int iFirstCol = iChunkCol * WALL_CHUNK_CELLS;
+  int iCtRows = MAP_ROW - iFirstRow < WALL_CHUNK_CELLS ? MAP_ROW - iFirstRow : WALL_CHUNK_CELLS;
+  int iCtCols = MAP_COL - iFirstCol < WALL_CHUNK_CELLS ? MAP_COL - iFirstCol : WALL_CHUNK_CELLS;
+  float fCellWidth = gstCamera.fCellWidth * gfRenderScale;
+  float fCellHeight = gstCamera.fCellHeight * gfRenderScale;
+  int iWidth = 0;
+  int iHeight = 0;
+  int iRow = 0;
+  int iCol = 0;
+
+  /* Over the texture limit of the renderer the chunk is made smaller, it is
+   * stretched back when drawn */
+  memset(&stInfo, 0x00, sizeof(stInfo));
+  if ( SDL_GetRendererInfo(gpstRenderer, &stInfo) == 0 ) {
+    if ( stInfo.max_texture_width > 0 && (float) iCtCols * fCellWidth > (float) stInfo.max_texture_width ) {
+      fCellWidth = (float) (stInfo.max_texture_width / iCtCols);
+    }
+    if ( stInfo.max_texture_height > 0 && (float) iCtRows * fCellHeight > (float) stInfo.max_texture_height ) {
+      fCellHeight = (float) (stInfo.max_texture_height / iCtRows);
+    }
+  }
+  iWidth = (int) ((float) iCtCols * fCellWidth + 0.5f);
+  iHeight = (int) ((float) iCtRows * fCellHeight + 0.5f);
+
+  pstSurface = pstGfxCreateRGBSurfaceWithFormat(0, iWidth, iHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  if ( !pstSurface ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to create the wall chunk: [%s]", SDL_GetError());
+    return NULL;
+  }
+  SDL_FillRect(pstSurface, NULL, 0);
+  for ( iRow = 0; iRow < iCtRows; iRow++ ) {
+    for ( iCol = 0; iCol < iCtCols; iCol++ ) {
+      SDL_Rect stRect;
+      if ( aszMap[iFirstRow + iRow][iFirstCol + iCol] != '#' ) continue;
+      /* Edges are converted separately so neighbour walls have no gaps */
+      stRect.x = (int) ((float) iCol * fCellWidth + 0.5f);
+      stRect.y = (int) ((float) iRow * fCellHeight + 0.5f);
+      stRect.w = (int) ((float) (iCol + 1) * fCellWidth + 0.5f) - stRect.x;
+      stRect.h = (int) ((float) (iRow + 1) * fCellHeight + 0.5f) - stRect.y;
+      SDL_FillRect(pstSurface, &stRect, SDL_MapRGBA(pstSurface->format, 0, 0, 255, 255));
+    }
+  }
+  pstTexture = pstGfxCreateTextureFromSurface(gpstRenderer, pstSurface);
+  SDL_FreeSurface(pstSurface);
+  if ( pstTexture ) SDL_SetTextureBlendMode(pstTexture, SDL_BLENDMODE_BLEND);
+  return pstTexture;
+}
+
+void vInvalidateRenderCache(void) {
+  vDestroyRenderCache();
+}
+
+void vDestroyRenderCache(void) {
+  int ii = 0;
+  for ( ii = 0; ii < MAX_WALL_CHUNKS; ii++ ) {
+    if ( gastWallChunk[ii].pstTexture ) {
+      vGfxDestroyTexture(gastWallChunk[ii].pstTexture);
+      gastWallChunk[ii].pstTexture = NULL;
+    }
+  }
+  if ( gpstMinimap ) {
+    vGfxDestroyTexture(gpstMinimap);
+    gpstMinimap = NULL;
+  }
+  if ( gpstDotTexture ) {
+    vGfxDestroyTexture(gpstDotTexture);
+    gpstDotTexture = NULL;
+  }
+  if ( gpstPowerTexture ) {
+    vGfxDestroyTexture(gpstPowerTexture);
+    gpstPowerTexture = NULL;
+  }
+}
+
+SDL_Texture* pstGetWallChunk(char aszMap[MAP_ROW][MAP_COL], int iChunkRow, int iChunkCol) {
+  PSTRUCT_WALL_CHUNK pstVictim = &gastWallChunk[0];
+  int ii = 0;
+
+  guiChunkClock++;
+  for ( ii = 0; ii < MAX_WALL_CHUNKS; ii++ ) {
+    PSTRUCT_WALL_CHUNK pstChunk = &gastWallChunk[ii];
+    if ( pstChunk->pstTexture && pstChunk->iChunkRow == iChunkRow && pstChunk->iChunkCol == iChunkCol ) {
+      pstChunk->uiLastUse = guiChunkClock;
+      return pstChunk->pstTexture;
+    }
+    /* A free slot, otherwise the least recently used one */
+    if ( !pstVictim->pstTexture ) continue;
+    if ( !pstChunk->pstTexture || pstChunk->uiLastUse < pstVictim->uiLastUse ) pstVictim = pstChunk;
+  }
+
+  if ( pstVictim->pstTexture ) vGfxDestroyTexture(pstVictim->pstTexture);
+  pstVictim->pstTexture = pstCreateWallChunk(aszMap, iChunkRow, iChunkCol);
+  pstVictim->iChunkRow = iChunkRow;
+  pstVictim->iChunkCol = iChunkCol;
+  pstVictim->uiLastUse = guiChunkClock;
+  return pstVictim->pstTexture;
+}
+
+SDL_Texture* pstGetMinimap(char aszMap[MAP_ROW][MAP_COL]) {
+  SDL_Surface* pstSurface = NULL;
+  int iRow = 0;
+  int iCol = 0;
+
+  if ( gpstMinimap ) return gpstMinimap;
+
+  pstSurface = pstGfxCreateRGBSurfaceWithFormat(0, MAP_COL, MAP_ROW, 32, SDL_PIXELFORMAT_RGBA32);
+  if ( !pstSurface ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to create the minimap: [%s]", SDL_GetError());
+    return NULL;
+  }
+  SDL_LockSurface(pstSurface);
+  for ( iRow = 0; iRow < MAP_ROW; iRow++ ) {
+    Uint32* puiRow = (Uint32*) ((Uint8*) pstSurface->pixels + iRow * pstSurface->pitch);
+    for ( iCol = 0; iCol < MAP_COL; iCol++ ) {
+      puiRow[iCol] = aszMap[iRow][iCol] == '#' ? SDL_MapRGBA(pstSurface->format, 0, 0, 255, 255) : SDL_MapRGBA(pstSurface->format, 0, 0, 0, 160);
+    }
+  }
+  SDL_UnlockSurface(pstSurface);
+  gpstMinimap = pstGfxCreateTextureFromSurface(gpstRenderer, pstSurface);
+  SDL_FreeSurface(pstSurface);
+  if ( gpstMinimap ) SDL_SetTextureBlendMode(gpstMinimap, SDL_BLENDMODE_BLEND);
+  return gpstMinimap;
+}
+
+SDL_Texture* pstGetDotTexture(void) {
+  if ( !gpstDotTexture ) gpstDotTexture = pstCreateCircleTexture(5);
+  return gpstDotTexture;
+}
+
+SDL_Texture* pstGetPowerTexture(void) {
+  if ( !gpstPowerTexture ) gpstPowerTexture = pstCreateCircleTexture(3);
+  return gpstPowerTexture;
+}
@@ -0,0 +1,261 @@
+/**
+ * @file replay.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "game.h"
+#include "replay.h"
+
+/**
+ * @def REPLAY_FLAG_TICK
+ * @brief Step flag of the tick
+ */
+#define REPLAY_FLAG_TICK 0x01
+
+/**
+ * @def REPLAY_MOVE_SHIFT
+ * @brief Position of the move in the step flags
+ */
+#define REPLAY_MOVE_SHIFT 1
+
+/**
+ * @def REPLAY_PAUSE_SHIFT
+ * @brief Position of the pauses in the step flags
+ */
+#define REPLAY_PAUSE_SHIFT 4
+
+/**
+ * @struct STRUCT_REPLAY
+ * @brief State of the recording or of the replay
+ */
+typedef struct STRUCT_REPLAY {
+  ENUM_REPLAY_MODE eMode;   /**< What is done with the steps        */
+  FILE* fpOut;              /**< Recording file                     */
+  Uint8* pucSteps;          /**< Steps of the replay, 2 bytes each  */
+  long lCtSteps;            /**< Steps in pucSteps                  */
+  long lNextStep;           /**< Next step played                   */
+  boolean bMaxSpeed;        /**< Ticks played without waiting       */
+  unsigned long ulSteps;    /**< Steps recorded or played           */
+  unsigned long ulTicks;    /**< Ticks recorded or played           */
+} STRUCT_REPLAY, *PSTRUCT_REPLAY;
+
+/**
+ * @var gstReplay
+ * @brief The recording or the replay
+ */
+static STRUCT_REPLAY gstReplay;
+
+/**
+ * @brief Write an integer in little endian
+ *
+ * @param fpOut Output file
+ * @param uiValue Value
+ * @param iBytes Bytes written
+ */
+static void vWriteLE(FILE* fpOut, Uint32 uiValue, int iBytes);
+
+/**
+ * @brief Read an integer in little endian
+ *
+ * @param fpIn Input file
+ * @param puiValue Receives the value
+ * @param iBytes Bytes read
+ * @return TRUE value read
+ * @return FALSE end of file
+ */
+static boolean bReadLE(FILE* fpIn, Uint32* puiValue, int iBytes);
+
+static void vWriteLE(FILE* fpOut, Uint32 uiValue, int iBytes) {
+  int ii = 0;
+  for ( ii = 0; ii < iBytes; ii++ ) {
+    fputc((int) ((uiValue >> (8 * ii)) & 0xFF), fpOut);
+  }
+}
+
+static boolean bReadLE(FILE* fpIn, Uint32* puiValue, int iBytes) {
+  int ii = 0;
+  *puiValue = 0;
+  for ( ii = 0; ii < iBytes; ii++ ) {
+    int iCh = fgetc(fpIn);
+    if ( iCh == EOF ) return FALSE;
+    *puiValue |= (Uint32) iCh << (8 * ii);
+  }
+  return TRUE;
+}
+
+Uint32 uiHashLevelSet(const char* kpszLevelDir) {
+  char szLevel[_MAX_PATH + 32];
+  Uint8 aucBuffer[4096];
+  Uint64 ullHash = HASH_SEED;
+  int iLevel = 0;
+
+  for ( iLevel = 1; iLevel <= MAX_LEVEL; iLevel++ ) {
+    FILE* fpLevel = NULL;
+    size_t ulRead = 0;
+    sprintf(szLevel, "%.*s%c%d.txt", _MAX_PATH - 1, kpszLevelDir, DIR_SEPARATOR, iLevel);
+    if ( (fpLevel = fopen(szLevel, "rb")) == NULL ) continue;
+    while ( (ulRead = fread(aucBuffer, 1, sizeof(aucBuffer), fpLevel)) > 0 ) {
+      ullHash = ullHashBytes(aucBuffer, ulRead, ullHash);
+    }
+    fclose(fpLevel);
+  }
+  return HASH_FOLD32(ullHash);
+}
+
+boolean bStartRecording(const char* kpszPath, PSTRUCT_REPLAY_HEADER pstHeader) {
+  size_t ulLen = strlen(pstHeader->szLevelDir);
+
+  if ( (gstReplay.fpOut = fopen(kpszPath, "wb")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    return FALSE;
+  }
+  fwrite(REPLAY_MAGIC, 1, sizeof(REPLAY_MAGIC), gstReplay.fpOut);
+  vWriteLE(gstReplay.fpOut, REPLAY_VERSION, 1);
+  vWriteLE(gstReplay.fpOut, pstHeader->uiSeed, 4);
+  vWriteLE(gstReplay.fpOut, pstHeader->uiLevelHash, 4);
+  vWriteLE(gstReplay.fpOut, (Uint32) ulLen, 2);
+  fwrite(pstHeader->szLevelDir, 1, ulLen, gstReplay.fpOut);
+  gstReplay.eMode = REPLAY_RECORD;
+  return TRUE;
+}
+
+boolean bLoadReplay(const char* kpszPath, PSTRUCT_REPLAY_HEADER pstHeader) {
+  char szMagic[sizeof(REPLAY_MAGIC)];
+  FILE* fpIn = NULL;
+  Uint32 uiVersion = 0;
+  Uint32 uiLen = 0;
+  long lStart = 0;
+  long lEnd = 0;
+
+  memset(pstHeader, 0x00, sizeof(STRUCT_REPLAY_HEADER));
+  if ( (fpIn = fopen(kpszPath, "rb")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    return FALSE;
+  }
+  if ( fread(szMagic, 1, sizeof(szMagic), fpIn) != sizeof(szMagic) || memcmp(szMagic, REPLAY_MAGIC, sizeof(szMagic))
+    || !bReadLE(fpIn, &uiVersion, 1) || uiVersion != REPLAY_VERSION
+    || !bReadLE(fpIn, &pstHeader->uiSeed, 4) || !bReadLE(fpIn, &pstHeader->uiLevelHash, 4)
+    || !bReadLE(fpIn, &uiLen, 2) || uiLen >= sizeof(pstHeader->szLevelDir)
+    || fread(pstHeader->szLevelDir, 1, uiLen, fpIn) != uiLen ) {
+    fprintf(stderr, "E: [%s] is not a replay of this version\n", kpszPath);
+    fclose(fpIn);
+    return FALSE;
+  }
+
+  lStart = ftell(fpIn);
+  fseek(fpIn, 0, SEEK_END);
+  lEnd = ftell(fpIn);
+  fseek(fpIn, lStart, SEEK_SET);
+  gstReplay.lCtSteps = (lEnd - lStart) / 2;
+  if ( gstReplay.lCtSteps > REPLAY_MAX_STEPS ) gstReplay.lCtSteps = REPLAY_MAX_STEPS;
+  /* The whole replay is read once, playing it touches no file */
+  if ( (gstReplay.pucSteps = (Uint8*) malloc((size_t) gstReplay.lCtSteps * 2 + 2)) == NULL ) {
+    fprintf(stderr, "E: No memory for %ld replay steps\n", gstReplay.lCtSteps);
+    fclose(fpIn);
+    return FALSE;
+  }
+  gstReplay.lCtSteps = (long) fread(gstReplay.pucSteps, 2, (size_t) gstReplay.lCtSteps, fpIn);
+  fclose(fpIn);
+  gstReplay.lNextStep = 0;
+  gstReplay.eMode = REPLAY_PLAY;
+  return TRUE;
+}
+
+ENUM_REPLAY_MODE eGetReplayMode(void) {
+  return gstReplay.eMode;
+}
+
+boolean bParseReplaySpeed(const char* kpszSpeed, boolean* pbMax) {
+  if ( !strcmp(kpszSpeed, "max") ) *pbMax = TRUE;
+  else if ( !strcmp(kpszSpeed, "normal") ) *pbMax = FALSE;
+  else return FALSE;
+  return TRUE;
+}
+
+void vSetReplayMaxSpeed(boolean bMax) {
+  gstReplay.bMaxSpeed = bMax;
+}
+
+boolean bReplayMaxSpeed(void) {
+  return gstReplay.bMaxSpeed;
+}
+
+boolean bPeekReplayStep(PSTRUCT_REPLAY_STEP pstStep) {
+  Uint8 ucFlags = 0;
+  int iPause = 0;
+
+  if ( gstReplay.lNextStep >= gstReplay.lCtSteps ) return FALSE;
+  ucFlags = gstReplay.pucSteps[gstReplay.lNextStep * 2];
+  iPause = (ucFlags >> REPLAY_PAUSE_SHIFT) & 0x03;
+  pstStep->bTick = (ucFlags & REPLAY_FLAG_TICK) != 0;
+  pstStep->iMove = (ucFlags >> REPLAY_MOVE_SHIFT) & 0x07;
+  pstStep->iPause = iPause;
+  pstStep->iDismissed = gstReplay.pucSteps[gstReplay.lNextStep * 2 + 1];
+  return TRUE;
+}
+
+void vNextReplayStep(void) {
+  STRUCT_REPLAY_STEP stStep;
+  if ( !bPeekReplayStep(&stStep) ) return;
+  gstReplay.lNextStep++;
+  gstReplay.ulSteps++;
+  if ( stStep.bTick ) gstReplay.ulTicks++;
+}
+
+void vRecordStep(PSTRUCT_REPLAY_STEP pstStep) {
+  int iFlags = 0;
+  int iPause = 0;
+
+  if ( !gstReplay.fpOut ) return;
+  /* Only the parity of the pauses changes the game */
+  if ( pstStep->iPause > 0 ) iPause = pstStep->iPause % 2 == 1 ? 1 : 2;
+  if ( pstStep->bTick ) iFlags |= REPLAY_FLAG_TICK;
+  iFlags |= (pstStep->iMove & 0x07) << REPLAY_MOVE_SHIFT;
+  iFlags |= iPause << REPLAY_PAUSE_SHIFT;
+  fputc(iFlags, gstReplay.fpOut);
+  fputc(pstStep->iDismissed > 0xFF ? 0xFF : pstStep->iDismissed, gstReplay.fpOut);
+  gstReplay.ulSteps++;
+  if ( pstStep->bTick ) gstReplay.ulTicks++;
+  if ( gstReplay.ulSteps % REPLAY_FLUSH_STEPS == 0 ) fflush(gstReplay.fpOut);
+}
+
+void vPrintReplayStats(FILE* fpOut, Uint64 ullElapsed) {
+  double dSeconds = (double) ullElapsed / 1000000.0;
+  if ( gstReplay.eMode == REPLAY_OFF ) return;
+  fprintf(
+    fpOut, "%s %lu steps, %lu ticks in %.3f s (%.0f ticks/s)\n",
+    gstReplay.eMode == REPLAY_PLAY ? "Replayed" : "Recorded",
+    gstReplay.ulSteps, gstReplay.ulTicks, dSeconds,
+    dSeconds > 0.0 ? (double) gstReplay.ulTicks / dSeconds : 0.0
+  );
+}
+
+void vCloseReplay(void) {
+  if ( gstReplay.fpOut ) {
+    fclose(gstReplay.fpOut);
+    gstReplay.fpOut = NULL;
+  }
+  if ( gstReplay.pucSteps ) {
+    free(gstReplay.pucSteps);
+    gstReplay.pucSteps = NULL;
+  }
+}
@@ -0,0 +1,285 @@
+/**
+ * @file rewind.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <string.h>
+#include "game.h"
+#include "rewind.h"
+
+/**
+ * @struct STRUCT_REWIND_RECORD
+ * @brief A tick of the history in the byte ring
+ */
+typedef struct STRUCT_REWIND_RECORD {
+  size_t ulOffset;   /**< First byte in the ring               */
+  size_t ulLength;   /**< Encoded bytes                        */
+  boolean bKeyframe; /**< XOR against the base, not the last tick */
+} STRUCT_REWIND_RECORD, *PSTRUCT_REWIND_RECORD;
+
+/**
+ * @struct STRUCT_REWIND
+ * @brief The rewind history, a ring of records over a ring of bytes, the
+ * oldest record is always a keyframe
+ *
+ * A record is a list of (equal bytes, changed bytes, XOR of the changed
+ * bytes), each count in one byte. The equal bytes at the end are not written.
+ */
+typedef struct STRUCT_REWIND {
+  STRUCT_REWIND_RECORD astRecord[REWIND_MAX_TICKS];        /**< Records, oldest at iFirst     */
+  int iFirst;                                              /**< Slot of the oldest record     */
+  int iCount;                                              /**< Records kept                  */
+  int iSinceKeyframe;                                      /**< Deltas after the last keyframe */
+  size_t ulFirstByte;                                      /**< Offset of the oldest record   */
+  size_t ulUsedBytes;                                      /**< Bytes of the records kept     */
+  Uint8 aucBuffer[REWIND_BUFFER_BYTES];                    /**< Encoded records               */
+  Uint8 aucEncoded[sizeof(STRUCT_GAME_STATE) * 2 + 2];     /**< Record being pushed           */
+  boolean bOff;                                            /**< Nothing kept until the reset  */
+  STRUCT_GAME_STATE stBase;                                /**< Base of the keyframes         */
+  STRUCT_GAME_STATE stLast;                                /**< Last tick pushed              */
+  STRUCT_GAME_STATE stCurrent;                             /**< Tick being pushed or decoded  */
+  SDL_atomic_t stHeld;                                     /**< Rewind key down               */
+} STRUCT_REWIND, *PSTRUCT_REWIND;
+
+/**
+ * @var gstRewind
+ * @brief The rewind history
+ */
+static STRUCT_REWIND gstRewind;
+
+/**
+ * @brief Get a record by age
+ *
+ * @param iIndex 0 is the oldest record
+ * @return Record
+ */
+static PSTRUCT_REWIND_RECORD pstGetRecord(int iIndex);
+
+/**
+ * @brief Encode the bytes that differ between two states
+ *
+ * @param kpucOld Previous state
+ * @param kpucNew New state
+ * @param pucOut Receives the record
+ * @return Bytes written
+ */
+static size_t ulEncodeDelta(const Uint8* kpucOld, const Uint8* kpucNew, Uint8* pucOut);
+
+/**
+ * @brief XOR a record into a state
+ *
+ * @param kpstRecord Record
+ * @param pucState State changed
+ */
+static void vApplyDelta(const STRUCT_REWIND_RECORD* kpstRecord, Uint8* pucState);
+
+/**
+ * @brief Decode a record from the keyframe before it
+ *
+ * @param iIndex 0 is the oldest record
+ * @param pstState Receives the state
+ * @return Deltas applied after the keyframe
+ */
+static int iDecodeRecord(int iIndex, PSTRUCT_GAME_STATE pstState);
+
+/**
+ * @brief Drop the oldest records until the oldest is a keyframe and a record
+ * of ulLength bytes fits
+ *
+ * @param ulLength Bytes of the next record
+ */
+static void vMakeRewindRoom(size_t ulLength);
+
+static PSTRUCT_REWIND_RECORD pstGetRecord(int iIndex) {
+  return &gstRewind.astRecord[(gstRewind.iFirst + iIndex) % REWIND_MAX_TICKS];
+}
+
+static size_t ulEncodeDelta(const Uint8* kpucOld, const Uint8* kpucNew, Uint8* pucOut) {
+  size_t ulSize = sizeof(STRUCT_GAME_STATE);
+  size_t ulPos = 0;
+  size_t ulLen = 0;
+
+  while ( ulPos < ulSize ) {
+    size_t ulSkip = 0;
+    size_t ulCount = 0;
+    size_t ii = 0;
+    while ( ulPos + ulSkip < ulSize && ulSkip < 255 && kpucOld[ulPos + ulSkip] == kpucNew[ulPos + ulSkip] ) ulSkip++;
+    if ( ulPos + ulSkip == ulSize ) break;
+    ulPos += ulSkip;
+    while ( ulPos + ulCount < ulSize && ulCount < 255 && kpucOld[ulPos + ulCount] != kpucNew[ulPos + ulCount] ) ulCount++;
+    pucOut[ulLen++] = (Uint8) ulSkip;
+    pucOut[ulLen++] = (Uint8) ulCount;
+    for ( ii = 0; ii < ulCount; ii++ ) {
+      pucOut[ulLen++] = (Uint8) (kpucOld[ulPos + ii] ^ kpucNew[ulPos + ii]);
+    }
+    ulPos += ulCount;
+  }
+  return ulLen;
+}
+
+static void vApplyDelta(const STRUCT_REWIND_RECORD* kpstRecord, Uint8* pucState) {
+  size_t ulIn = 0;
+  size_t ulPos = 0;
+
+  while ( ulIn < kpstRecord->ulLength ) {
+    size_t ulSkip = gstRewind.aucBuffer[(kpstRecord->ulOffset + ulIn++) % REWIND_BUFFER_BYTES];
+    size_t ulCount = gstRewind.aucBuffer[(kpstRecord->ulOffset + ulIn++) % REWIND_BUFFER_BYTES];
+    ulPos += ulSkip;
+    while ( ulCount-- > 0 ) {
+      pucState[ulPos++] ^= gstRewind.aucBuffer[(kpstRecord->ulOffset + ulIn++) % REWIND_BUFFER_BYTES];
+    }
+  }
+}
+
+static int iDecodeRecord(int iIndex, PSTRUCT_GAME_STATE pstState) {
+  int iKey = iIndex;
+  int ii = 0;
+
+  while ( iKey > 0 && !pstGetRecord(iKey)->bKeyframe ) iKey--;
+  memcpy(pstState, &gstRewind.stBase, sizeof(STRUCT_GAME_STATE));
+  for ( ii = iKey; ii <= iIndex; ii++ ) {
+    vApplyDelta(pstGetRecord(ii), (Uint8*) pstState);
+  }
+  return iIndex - iKey;
+}
+
+static void vMakeRewindRoom(size_t ulLength) {
+  while ( gstRewind.iCount != 0 && (gstRewind.iCount == REWIND_MAX_TICKS || gstRewind.ulUsedBytes + ulLength > REWIND_BUFFER_BYTES) ) {
+    /* A whole keyframe group goes, its deltas mean nothing without it */
+    do {
+      PSTRUCT_REWIND_RECORD pstOldest = pstGetRecord(0);
+      gstRewind.ulFirstByte = (pstOldest->ulOffset + pstOldest->ulLength) % REWIND_BUFFER_BYTES;
+      gstRewind.ulUsedBytes -= pstOldest->ulLength;
+      if ( ++gstRewind.iFirst == REWIND_MAX_TICKS ) gstRewind.iFirst = 0;
+      gstRewind.iCount--;
+    } while ( gstRewind.iCount != 0 && !pstGetRecord(0)->bKeyframe );
+  }
+  if ( gstRewind.iCount == 0 ) vResetRewind();
+}
+
+void vResetRewind(void) {
+  gstRewind.iFirst = 0;
+  gstRewind.iCount = 0;
+  gstRewind.iSinceKeyframe = 0;
+  gstRewind.ulFirstByte = 0;
+  gstRewind.ulUsedBytes = 0;
+  gstRewind.bOff = FALSE;
+}
+
+void vPushRewindTick(void) {
+  PSTRUCT_REWIND_RECORD pstRecord = NULL;
+  boolean bKeyframe = gstRewind.iCount == 0 || gstRewind.iSinceKeyframe >= REWIND_KEYFRAME_TICKS - 1;
+  size_t ulLength = 0;
+  size_t ulOffset = 0;
+  size_t ii = 0;
+
+  if ( gstRewind.bOff ) return;
+  vSaveGameState(&gstRewind.stCurrent);
+  /* The level start, the keyframes are only what changed since */
+  if ( gstRewind.iCount == 0 ) gstRewind.stBase = gstRewind.stCurrent;
+  ulLength = ulEncodeDelta((const Uint8*) (bKeyframe ? &gstRewind.stBase : &gstRewind.stLast), (const Uint8*) &gstRewind.stCurrent, gstRewind.aucEncoded);
+  if ( ulLength > REWIND_BUFFER_BYTES ) {
+    /* Once, not on each tick */
+    if ( DEBUG_WARNING ) vTrace("W: Game state of [%lu] bytes does not fit the rewind history", (unsigned long) ulLength);
+    vResetRewind();
+    gstRewind.bOff = TRUE;
+    return;
+  }
+  vMakeRewindRoom(ulLength);
+  if ( gstRewind.iCount == 0 && !bKeyframe ) {
+    bKeyframe = TRUE;
+    ulLength = ulEncodeDelta((const Uint8*) &gstRewind.stBase, (const Uint8*) &gstRewind.stCurrent, gstRewind.aucEncoded);
+  }
+
+  ulOffset = (gstRewind.ulFirstByte + gstRewind.ulUsedBytes) % REWIND_BUFFER_BYTES;
+  for ( ii = 0; ii < ulLength; ii++ ) {
+    gstRewind.aucBuffer[(ulOffset + ii) % REWIND_BUFFER_BYTES] = gstRewind.aucEncoded[ii];
+  }
+  pstRecord = pstGetRecord(gstRewind.iCount);
+  pstRecord->ulOffset = ulOffset;
+  pstRecord->ulLength = ulLength;
+  pstRecord->bKeyframe = bKeyframe;
+  gstRewind.iCount++;
+  gstRewind.ulUsedBytes += ulLength;
+  gstRewind.iSinceKeyframe = bKeyframe ? 0 : gstRewind.iSinceKeyframe + 1;
+  gstRewind.stLast = gstRewind.stCurrent;
+}
+
+void vPostRewind(boolean bHeld) {
+  SDL_AtomicSet(&gstRewind.stHeld, bHeld ? 1 : 0);
+}
+
+boolean bRewindHeld(void) {
+  return SDL_AtomicGet(&gstRewind.stHeld) != 0 ? TRUE : FALSE;
+}
+
+boolean bRewindTick(void) {
+  PSTRUCT_REWIND_RECORD pstNewest = NULL;
+  int aiOldX[MAX_GHOSTS + 1];
+  int aiOldY[MAX_GHOSTS + 1];
+  int ii = 0;
+
+  /* The newest record is the tick on the screen, one before it is needed */
+  if ( gstRewind.iCount < 2 ) return FALSE;
+  pstNewest = pstGetRecord(gstRewind.iCount - 1);
+  gstRewind.ulUsedBytes -= pstNewest->ulLength;
+  gstRewind.iCount--;
+  gstRewind.iSinceKeyframe = iDecodeRecord(gstRewind.iCount - 1, &gstRewind.stCurrent);
+  gstRewind.stLast = gstRewind.stCurrent;
+
+  aiOldX[0] = gstPlayer.iX;
+  aiOldY[0] = gstPlayer.iY;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    aiOldX[ii+1] = gastGhost[ii].iX;
+    aiOldY[ii+1] = gastGhost[ii].iY;
+  }
+  if ( !bRestoreGameState(&gstRewind.stCurrent) ) return FALSE;
+  /* The render moves the entities from the cells they leave, backwards */
+  gstPlayer.iPrevX = aiOldX[0];
+  gstPlayer.iPrevY = aiOldY[0];
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    gastGhost[ii].iPrevX = aiOldX[ii+1];
+    gastGhost[ii].iPrevY = aiOldY[ii+1];
+  }
+  return TRUE;
+}
+
+int iGetRewindTicks(void) {
+  return gstRewind.iCount;
+}
+
+boolean bGetRewindState(int iTicksAgo, PSTRUCT_GAME_STATE pstState) {
+  if ( iTicksAgo < 0 || iTicksAgo >= gstRewind.iCount ) return FALSE;
+  iDecodeRecord(gstRewind.iCount - 1 - iTicksAgo, pstState);
+  return TRUE;
+}
+
+void vPrintRewindStats(FILE* fpOut) {
+  int iCtKeyframes = 0;
+  int ii = 0;
+
+  for ( ii = 0; ii < gstRewind.iCount; ii++ ) {
+    if ( pstGetRecord(ii)->bKeyframe ) iCtKeyframes++;
+  }
+  fprintf(fpOut, "Rewind: %d ticks (%d s), %d keyframes, %lu of %lu bytes, state %lu bytes\n",
+    gstRewind.iCount, gstRewind.iCount / FPS, iCtKeyframes,
+    (unsigned long) gstRewind.ulUsedBytes, (unsigned long) REWIND_BUFFER_BYTES,
+    (unsigned long) sizeof(STRUCT_GAME_STATE));
+}
@@ -0,0 +1,69 @@
+/**
+ * @file rng.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <time.h>
+#include "rng.h"
+
+/**
+ * @var guiRandomState
+ * @brief State of the xorshift32 generator
+ */
+static Uint32 guiRandomState = RNG_DEFAULT_SEED;
+
+void vSeedRandom(Uint32 uiSeed) {
+  guiRandomState = uiSeed ? uiSeed : RNG_DEFAULT_SEED;
+}
+
+Uint32 uiNewRandomSeed(void) {
+  Uint32 uiSeed = (Uint32) time(NULL) ^ (Uint32) SDL_GetPerformanceCounter();
+  return uiSeed ? uiSeed : RNG_DEFAULT_SEED;
+}
+
+Uint32 uiGetRandomState(void) {
+  return guiRandomState;
+}
+
+void vSetRandomState(Uint32 uiState) {
+  vSeedRandom(uiState);
+}
+
+Uint32 uiRandom(void) {
+  return uiRandomFrom(&guiRandomState);
+}
+
+int iRandomBelow(int iBound) {
+  return iRandomBelowFrom(&guiRandomState, iBound);
+}
+
+Uint32 uiRandomFrom(Uint32* puiState) {
+  Uint32 uiX = *puiState;
+  uiX ^= uiX << 13;
+  uiX ^= uiX >> 17;
+  uiX ^= uiX << 5;
+  *puiState = uiX;
+  return uiX;
+}
+
+int iRandomBelowFrom(Uint32* puiState, int iBound) {
+  /* The high bits of xorshift are the better ones */
+  return (int) (((Uint64) uiRandomFrom(puiState) * (Uint64) iBound) >> 32);
+}
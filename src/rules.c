@@ -0,0 +1,285 @@
+/**
+ * @file rules.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "game.h"
+#include "rules.h"
+
+/**
+ * @var gkaiRuleRow
+ * @brief Row step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiRuleRow[4] = { -1, 0, 1, 0 };
+
+/**
+ * @var gkaiRuleCol
+ * @brief Col step of each movement, indexed by UP_MOVEMENT...RIGHT_MOVENT
+ */
+static const int gkaiRuleCol[4] = { 0, -1, 0, 1 };
+
+/**
+ * @brief Get a cell of the map
+ *
+ * @param kpstView Game
+ * @param iRow Row
+ * @param iCol Col
+ * @return The cell or '\0' out of the map
+ */
+static char chRuleCell(const STRUCT_RULE_VIEW* kpstView, int iRow, int iCol);
+
+/**
+ * @brief Set a cell of the map, nothing out of it
+ *
+ * @param pstView Game
+ * @param iRow Row
+ * @param iCol Col
+ * @param chCell New cell
+ */
+static void vRuleSetCell(PSTRUCT_RULE_VIEW pstView, int iRow, int iCol, char chCell);
+
+/**
+ * @brief Check if a cell holds a ghost
+ *
+ * @param chCell Cell
+ * @return TRUE ghost letter
+ * @return FALSE anything else
+ */
+static boolean bRuleGhostCell(char chCell);
+
+/**
+ * @brief Put the hero on a cell: the tunnels, the ghosts, the walls, the
+ * dots and the powers
+ *
+ * @param pstView Game
+ * @param iX New col
+ * @param iY New row
+ * @param pstEvents Events added to
+ */
+static void vRuleSetHero(PSTRUCT_RULE_VIEW pstView, int iX, int iY, PSTRUCT_RULE_EVENTS pstEvents);
+
+static char chRuleCell(const STRUCT_RULE_VIEW* kpstView, int iRow, int iCol) {
+  if ( iRow < 0 || iRow >= MAP_ROW || iCol < 0 || iCol >= MAP_COL ) return '\0';
+  return kpstView->paszMap[iRow][iCol];
+}
+
+static void vRuleSetCell(PSTRUCT_RULE_VIEW pstView, int iRow, int iCol, char chCell) {
+  if ( iRow < 0 || iRow >= MAP_ROW || iCol < 0 || iCol >= MAP_COL ) return;
+  pstView->paszMap[iRow][iCol] = chCell;
+}
+
+static boolean bRuleGhostCell(char chCell) {
+  return chCell == 'R' || chCell == 'G' || chCell == 'B' || chCell == 'A';
+}
+
+static void vRuleSetHero(PSTRUCT_RULE_VIEW pstView, int iX, int iY, PSTRUCT_RULE_EVENTS pstEvents) {
+  PSTRUCT_ENTITY pstHero = pstView->pstHero;
+  char chCell = chRuleCell(pstView, iY, iX);
+  int ii = 0;
+
+  if ( pstView->bHeroEndMap ) {
+    iX = ( iX > MAP_ROW-1 ? 0 : MAP_ROW-1 );
+    pstView->bHeroEndMap = FALSE;
+  }
+  else if ( chCell == ' ' && (iX+1 == MAP_ROW || iX == 0) ) pstView->bHeroEndMap = TRUE;
+  else if ( iX < 0 || iX > MAP_ROW-1 || iY < 0 || iY > MAP_COL-1 ) {
+    pstView->bHeroEndMap = FALSE;
+    return;
+  }
+  else if ( bRuleGhostCell(chCell) ) {
+    if ( pstView->iPowersCollected > 0 ) {
+      for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+        PSTRUCT_ENTITY pstGhost = &pstView->pastGhost[ii];
+        if ( pstGhost->chLetter != chCell ) continue;
+        vRuleSetCell(pstView, pstGhost->iY, pstGhost->iX, pstGhost->chOldXY);
+        pstGhost->iX = -1;
+        pstGhost->iY = -1;
+        break;
+      }
+      if ( pstView->iPowersCollected > 0 ) pstView->iPowersCollected--;
+      pstEvents->iGhostDeaths++;
+    }
+    else {
+      pstHero->iLives--;
+      pstEvents->iHeroDeaths++;
+      if ( pstHero->iLives == 0 ) {
+        pstView->bGameOver = TRUE;
+        return;
+      }
+      iX = pstHero->iInitialX;
+      iY = pstHero->iInitialY;
+      vRuleSetCell(pstView, pstHero->iY, pstHero->iX, ' ');
+      pstHero->iMovementDirection = NONE_MOVEMENT;
+    }
+  }
+  else if ( chCell == '#' ) {
+    return;
+  }
+  /* The tunnel and the death moved the hero, the cell is another one */
+  chCell = chRuleCell(pstView, iY, iX);
+  if ( chCell == '.' ) {
+    pstView->iCurrentLevelScore += 10;
+  }
+  else if ( chCell == 'O' ) {
+    pstView->iCurrentLevelScore += 100;
+    pstView->iPowersCollected++;
+    pstEvents->iPowersUp++;
+  }
+  pstHero->iX = iX;
+  pstHero->iY = iY;
+  if ( chCell == 'O' && pstView->bShowPowerMessage ) {
+    pstEvents->bPowerMessage = TRUE;
+    pstView->bShowPowerMessage = FALSE;
+  }
+}
+
+void vRuleHeroMove(PSTRUCT_RULE_VIEW pstView, PSTRUCT_RULE_EVENTS pstEvents) {
+  PSTRUCT_ENTITY pstHero = pstView->pstHero;
+  int iMove = pstHero->iMovementDirection;
+
+  if ( iMove < UP_MOVEMENT || iMove > RIGHT_MOVENT ) return;
+  vRuleSetCell(pstView, pstHero->iY, pstHero->iX, ' ');
+  vRuleSetHero(pstView, pstHero->iX + gkaiRuleCol[iMove], pstHero->iY + gkaiRuleRow[iMove], pstEvents);
+  vRuleSetCell(pstView, pstHero->iY, pstHero->iX, 'H');
+}
+
+void vRuleGhostsMove(PSTRUCT_RULE_VIEW pstView, PSTRUCT_RULE_EVENTS pstEvents) {
+  PSTRUCT_ENTITY pstHero = pstView->pstHero;
+  int ii = 0;
+
+  if ( pstHero->iMovementDirection == NONE_MOVEMENT && pstView->iCurrentLevelScore == 0 ) return;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    PSTRUCT_ENTITY pstGhost = &pstView->pastGhost[ii];
+    int iX = 0;
+    int iY = 0;
+    int iMove = 0;
+    char chCell = '\0';
+    if ( pstGhost->iX == -1 || pstGhost->iY == -1 ) continue;
+    do {
+      iMove = iRandomBelowFrom(&pstView->uiRandomState, 4);
+      iX = pstGhost->iX + gkaiRuleCol[iMove];
+      iY = pstGhost->iY + gkaiRuleRow[iMove];
+      if ( pstView->bGhostEndMap ) {
+        iX = ( iX > MAP_ROW-1 ? 0 : MAP_ROW-1 );
+        pstView->bGhostEndMap = FALSE;
+      }
+      else if ( chRuleCell(pstView, iY, iX) == ' ' && (iX+1 == MAP_ROW || iX == 0) ) pstView->bGhostEndMap = TRUE;
+      else if ( iX < 0 || iX > MAP_ROW-1 || iY < 0 || iY > MAP_COL-1 ) {
+        pstView->bGhostEndMap = FALSE;
+        continue;
+      }
+      break;
+    } while ( TRUE );
+    chCell = chRuleCell(pstView, iY, iX);
+    if ( bRuleGhostCell(chCell) || chCell == '#' ) continue;
+    if ( chCell == 'H' ) {
+      if ( pstView->iPowersCollected == 0 ) {
+        pstHero->iLives--;
+        pstEvents->iHeroDeaths++;
+        if ( pstHero->iLives == 0 ) {
+          pstView->bGameOver = TRUE;
+        }
+        else {
+          vRuleSetCell(pstView, pstHero->iY, pstHero->iX, ' ');
+          pstHero->iX = pstHero->iInitialX;
+          pstHero->iY = pstHero->iInitialY;
+          pstHero->iMovementDirection = NONE_MOVEMENT;
+          vRuleSetCell(pstView, pstHero->iY, pstHero->iX, 'H');
+        }
+      }
+      else {
+        vRuleSetCell(pstView, pstGhost->iY, pstGhost->iX, pstGhost->chOldXY);
+        pstGhost->iX = -1;
+        pstGhost->iY = -1;
+        if ( pstView->iPowersCollected > 0 ) pstView->iPowersCollected--;
+        pstEvents->iGhostDeaths++;
+        continue;
+      }
+    }
+    pstGhost->iMovementDirection = iMove;
+    vRuleSetCell(pstView, pstGhost->iY, pstGhost->iX, pstGhost->chOldXY);
+    pstGhost->chOldXY = chRuleCell(pstView, iY, iX);
+    vRuleSetCell(pstView, iY, iX, pstGhost->chLetter);
+    pstGhost->iY = iY;
+    pstGhost->iX = iX;
+  }
+}
+
+boolean bGameStateEnded(const STRUCT_GAME_STATE* kpstState) {
+  return kpstState->ucGameOver || kpstState->ucTimeOut || kpstState->iCurrentLevelScore == kpstState->iTotalCurrentLevelScore;
+}
+
+void vGetStateView(PSTRUCT_GAME_STATE pstState, PSTRUCT_RULE_VIEW pstView) {
+  pstView->paszMap = pstState->aszMap;
+  pstView->pstHero = &pstState->astEntity[0];
+  pstView->pastGhost = &pstState->astEntity[1];
+  pstView->iCurrentLevelScore = pstState->iCurrentLevelScore;
+  pstView->iTotalCurrentLevelScore = pstState->iTotalCurrentLevelScore;
+  pstView->iTotalGameScore = pstState->iTotalGameScore;
+  pstView->iCurrentLevelTime = pstState->iCurrentLevelTime;
+  pstView->iPowersCollected = pstState->iPowersCollected;
+  pstView->bGameOver = pstState->ucGameOver ? TRUE : FALSE;
+  pstView->bTimeOut = pstState->ucTimeOut ? TRUE : FALSE;
+  pstView->bHeroEndMap = pstState->ucHeroEndMap ? TRUE : FALSE;
+  pstView->bGhostEndMap = pstState->ucGhostEndMap ? TRUE : FALSE;
+  pstView->bShowPowerMessage = pstState->ucShowPowerMessage ? TRUE : FALSE;
+  pstView->uiRandomState = pstState->uiRandomState;
+}
+
+void vPutStateView(const STRUCT_RULE_VIEW* kpstView, PSTRUCT_GAME_STATE pstState) {
+  pstState->iCurrentLevelScore = kpstView->iCurrentLevelScore;
+  pstState->iTotalCurrentLevelScore = kpstView->iTotalCurrentLevelScore;
+  pstState->iTotalGameScore = kpstView->iTotalGameScore;
+  pstState->iCurrentLevelTime = kpstView->iCurrentLevelTime;
+  pstState->iPowersCollected = kpstView->iPowersCollected;
+  pstState->ucGameOver = (Uint8) kpstView->bGameOver;
+  pstState->ucTimeOut = (Uint8) kpstView->bTimeOut;
+  pstState->ucHeroEndMap = (Uint8) kpstView->bHeroEndMap;
+  pstState->ucGhostEndMap = (Uint8) kpstView->bGhostEndMap;
+  pstState->ucShowPowerMessage = (Uint8) kpstView->bShowPowerMessage;
+  pstState->uiRandomState = kpstView->uiRandomState;
+}
+
+void vStepGameState(PSTRUCT_GAME_STATE pstState, int iMove, PSTRUCT_RULE_EVENTS pstEvents) {
+  STRUCT_RULE_VIEW stView;
+  int ii = 0;
+
+  vGetStateView(pstState, &stView);
+  if ( iMove >= UP_MOVEMENT && iMove <= RIGHT_MOVENT ) stView.pstHero->iMovementDirection = iMove;
+  for ( ii = 0; ii < STATE_ENTITIES; ii++ ) {
+    pstState->astEntity[ii].iPrevX = pstState->astEntity[ii].iX;
+    pstState->astEntity[ii].iPrevY = pstState->astEntity[ii].iY;
+  }
+  if ( stView.iCurrentLevelTime == 0 ) stView.bTimeOut = TRUE;
+  if ( !stView.bTimeOut ) {
+    vRuleHeroMove(&stView, pstEvents);
+    if ( stView.iCurrentLevelScore != stView.iTotalCurrentLevelScore ) vRuleGhostsMove(&stView, pstEvents);
+  }
+  if ( !stView.bGameOver && stView.iCurrentLevelScore == stView.iTotalCurrentLevelScore ) {
+    stView.iTotalGameScore += stView.iCurrentLevelScore;
+  }
+  /* A message of the game would stop the level time for this tick */
+  if ( !pstEvents->bPowerMessage && !stView.bGameOver && !stView.bTimeOut
+    && stView.iCurrentLevelScore != stView.iTotalCurrentLevelScore
+    && stView.iCurrentLevelScore > 0 && stView.iCurrentLevelTime > 0 ) {
+    stView.iCurrentLevelTime--;
+  }
+  vPutStateView(&stView, pstState);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file sim.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "game.h"
+#include "sim.h"
+
+/**
+ * @var gpstSimThread
+ * @brief Simulation thread, NULL when the main loop runs the simulation
+ */
+static SDL_Thread* gpstSimThread = NULL;
+
+/**
+ * @var gpstSimWake
+ * @brief Posted to wake the simulation thread up
+ */
+static SDL_sem* gpstSimWake = NULL;
+
+/**
+ * @var gstInputMove
+ * @brief Last movement posted + 1, 0 when there is none
+ */
+static SDL_atomic_t gstInputMove;
+
+/**
+ * @var gstInputPause
+ * @brief Pause toggles posted
+ */
+static SDL_atomic_t gstInputPause;
+
+/**
+ * @brief Simulation thread loop
+ *
+ * @param pvData Not used
+ * @return 0
+ */
+static int iSimThread(void* pvData);
+
+static int iSimThread(void* pvData) {
+  (void) pvData;
+  if ( DEBUG_INFO ) vTrace("iSimThread - begin");
+  vTimelineThreadName("simulation");
+  while ( gbRun ) {
+    Uint32 uiWaitMs = 0;
+    vSimStep();
+    uiWaitMs = uiGetTickWaitMs();
+    if ( uiWaitMs > SIM_MAX_WAIT_MS ) uiWaitMs = SIM_MAX_WAIT_MS;
+    if ( uiWaitMs > 0 ) SDL_SemWaitTimeout(gpstSimWake, uiWaitMs);
+  }
+  if ( DEBUG_INFO ) vTrace("iSimThread - end");
+  return 0;
+}
+
+void vPostMove(int iDirection) {
+  SDL_AtomicSet(&gstInputMove, iDirection + 1);
+}
+
+void vPostPause(void) {
+  SDL_AtomicAdd(&gstInputPause, 1);
+}
+
+boolean bApplyInput(PSTRUCT_REPLAY_STEP pstStep) {
+  int iMove = SDL_AtomicSet(&gstInputMove, 0);
+  int iPause = SDL_AtomicSet(&gstInputPause, 0);
+
+  if ( eGetReplayMode() == REPLAY_PLAY ) {
+    iMove = pstStep->iMove;
+    iPause = pstStep->iPause;
+  }
+  pstStep->iMove = iMove;
+  pstStep->iPause = iPause;
+
+  /* Toggling twice in the same step does nothing */
+  if ( iPause % 2 == 1 ) {
+    geStatus = (geStatus == STATUS_IDLE ? STATUS_IDLE : (geStatus == STATUS_PAUSE ? STATUS_RUN : STATUS_PAUSE));
+  }
+  /* As the keys always did, a move takes the game out of the pause */
+  if ( iMove > 0 ) {
+    gstPlayer.iMovementDirection = iMove - 1;
+    if ( geStatus != STATUS_IDLE ) geStatus = STATUS_RUN;
+  }
+  return iMove > 0 || iPause > 0;
+}
+
+boolean bStartSimThread(void) {
+  if ( (gpstSimWake = SDL_CreateSemaphore(0)) == NULL ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to create the simulation semaphore: [%s]", SDL_GetError());
+    return FALSE;
+  }
+  if ( (gpstSimThread = SDL_CreateThread(iSimThread, "simulation", NULL)) == NULL ) {
+    if ( DEBUG_ERROR ) vTrace("E: Impossible to create the simulation thread: [%s]", SDL_GetError());
+    SDL_DestroySemaphore(gpstSimWake);
+    gpstSimWake = NULL;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void vWakeSimThread(void) {
+  if ( gpstSimWake ) SDL_SemPost(gpstSimWake);
+}
+
+void vStopSimThread(void) {
+  if ( !gpstSimThread ) return;
+  vWakeSimThread();
+  SDL_WaitThread(gpstSimThread, NULL);
+  gpstSimThread = NULL;
+  SDL_DestroySemaphore(gpstSimWake);
+  gpstSimWake = NULL;
+}
+
+boolean bSimThreaded(void) {
+  return gpstSimThread != NULL;
+}
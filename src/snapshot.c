@@ -0,0 +1,91 @@
+/**
+ * @file snapshot.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "snapshot.h"
+
+/**
+ * @def SNAPSHOT_SLOTS
+ * @brief One slot being written, one being read and one waiting between them
+ */
+#define SNAPSHOT_SLOTS 3
+
+/**
+ * @def SNAPSHOT_FRESH
+ * @brief Flag of gstMiddleSlot telling the waiting slot was not read yet
+ */
+#define SNAPSHOT_FRESH 0x4
+
+/**
+ * @def SNAPSHOT_SLOT_MASK
+ * @brief Slot index in gstMiddleSlot
+ */
+#define SNAPSHOT_SLOT_MASK 0x3
+
+/**
+ * @var gastSnapshot
+ * @brief Snapshot slots
+ */
+static STRUCT_SNAPSHOT gastSnapshot[SNAPSHOT_SLOTS];
+
+/**
+ * @var giWriteSlot
+ * @brief Slot owned by the simulation
+ */
+static int giWriteSlot = 1;
+
+/**
+ * @var giReadSlot
+ * @brief Slot owned by the render
+ */
+static int giReadSlot = 2;
+
+/**
+ * @var gstMiddleSlot
+ * @brief Slot waiting between both sides, swapped atomically by each side
+ * with its own slot
+ */
+static SDL_atomic_t gstMiddleSlot;
+
+void vInitSnapshots(void) {
+  memset(gastSnapshot, 0x00, sizeof(gastSnapshot));
+  giWriteSlot = 1;
+  giReadSlot = 2;
+  SDL_AtomicSet(&gstMiddleSlot, 0);
+}
+
+PSTRUCT_SNAPSHOT pstBeginSnapshot(void) {
+  return &gastSnapshot[giWriteSlot];
+}
+
+void vPublishSnapshot(void) {
+  /* SDL_AtomicSet is a full barrier, the slot is complete before it is seen */
+  int iOld = SDL_AtomicSet(&gstMiddleSlot, giWriteSlot | SNAPSHOT_FRESH);
+  giWriteSlot = iOld & SNAPSHOT_SLOT_MASK;
+}
+
+PSTRUCT_SNAPSHOT pstAcquireSnapshot(void) {
+  if ( SDL_AtomicGet(&gstMiddleSlot) & SNAPSHOT_FRESH ) {
+    int iOld = SDL_AtomicSet(&gstMiddleSlot, giReadSlot);
+    giReadSlot = iOld & SNAPSHOT_SLOT_MASK;
+  }
+  return &gastSnapshot[giReadSlot];
+}
@@ -0,0 +1,317 @@
+/**
+ * @file sound.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include "trace.h"
+#include "pacer.h"
+#include "sound.h"
+
+/**
+ * @def SOUND_MAX_PRIORITY
+ * @brief Highest priority of gkastSoundRule
+ */
+#define SOUND_MAX_PRIORITY 5
+
+/**
+ * @struct STRUCT_SOUND_RULE
+ * @brief How often a sound effect may play
+ */
+typedef struct STRUCT_SOUND_RULE {
+  int iMaxVoices;        /**< Channels the sound may hold at once        */
+  int iPriority;         /**< Higher cuts lower when no channel is free  */
+  Uint32 uiCoalesceMs;   /**< Requests this close to the last play merge */
+} STRUCT_SOUND_RULE, *PSTRUCT_SOUND_RULE;
+
+/**
+ * @var gkastSoundRule
+ * @brief Rules of each sound effect, indexed by ENUM_SOUND
+ */
+static const STRUCT_SOUND_RULE gkastSoundRule[SOUND_COUNT] = {
+  { 1, 2, 100 }, /* SOUND_POWER_UP    */
+  { 1, 4, 500 }, /* SOUND_LEVEL_UP    */
+  { 1, 5, 500 }, /* SOUND_GAME_WIN    */
+  { 1, 3, 250 }, /* SOUND_HERO_DEATH  */
+  { 2, 1, 100 }, /* SOUND_GHOST_DEATH */
+  { 1, 5, 500 }  /* SOUND_GAME_OVER   */
+};
+
+/**
+ * @var gbSoundOn
+ * @brief Set by vInitSounds, otherwise the queue drops everything
+ */
+static boolean gbSoundOn = FALSE;
+
+/**
+ * @var gapstSound
+ * @brief Chunk of each sound effect
+ */
+static Mix_Chunk* gapstSound[SOUND_COUNT];
+
+/**
+ * @var gastPending
+ * @brief Requests of each sound since the last flush, set by the simulation
+ */
+static SDL_atomic_t gastPending[SOUND_COUNT];
+
+/**
+ * @var gastVoices
+ * @brief Channels playing each sound, released by the mixer thread
+ */
+static SDL_atomic_t gastVoices[SOUND_COUNT];
+
+/**
+ * @var gastChannelSound
+ * @brief Sound playing in each channel, -1 when free
+ */
+static SDL_atomic_t gastChannelSound[SOUND_CHANNELS];
+
+/**
+ * @var gbLatencyTest
+ * @brief Set by vEnableSoundLatencyTest
+ */
+static boolean gbLatencyTest = FALSE;
+
+/**
+ * @var gastQueuedAt
+ * @brief Low 32 bits of the microseconds of the first request of each sound
+ * since the last flush, 0 none
+ */
+static SDL_atomic_t gastQueuedAt[SOUND_COUNT];
+
+/**
+ * @var gastChannelQueuedAt
+ * @brief gastQueuedAt of the sound started in each channel, cleared by the
+ * first callback that mixes it
+ */
+static SDL_atomic_t gastChannelQueuedAt[SOUND_CHANNELS];
+
+/**
+ * @var gstLatencySamples
+ * @brief Sounds measured by the latency test
+ */
+static SDL_atomic_t gstLatencySamples;
+
+/**
+ * @var gstLatencySumUs
+ * @brief Sum of the latencies in microseconds
+ */
+static SDL_atomic_t gstLatencySumUs;
+
+/**
+ * @var gstLatencyMaxUs
+ * @brief Highest latency in microseconds
+ */
+static SDL_atomic_t gstLatencyMaxUs;
+
+/**
+ * @var gauiLastPlay
+ * @brief SDL_GetTicks of the last play of each sound, 0 never played
+ */
+static Uint32 gauiLastPlay[SOUND_COUNT];
+
+/**
+ * @brief Release the voice of a finished channel, called by the mixer thread
+ *
+ * @param iChannel Channel
+ */
+static void vChannelFinished(int iChannel);
+
+/**
+ * @brief Channel effect of the latency test, records the time the sound
+ * reaches the audio callback
+ *
+ * @param iChannel Channel being mixed
+ * @param pvStream Samples (not changed)
+ * @param iLength Bytes of the samples
+ * @param pvData Not used
+ */
+static void vLatencyEffect(int iChannel, void* pvStream, int iLength, void* pvData);
+
+/**
+ * @brief Find a channel for a sound, cutting a less important one if needed
+ *
+ * @param iPriority Priority of the sound
+ * @return Channel or -1 when all of them play something as important
+ */
+static int iGetChannel(int iPriority);
+
+static void vChannelFinished(int iChannel) {
+  int iSound = 0;
+  if ( iChannel < 0 || iChannel >= SOUND_CHANNELS ) return;
+  iSound = SDL_AtomicSet(&gastChannelSound[iChannel], -1);
+  if ( iSound >= 0 ) SDL_AtomicAdd(&gastVoices[iSound], -1);
+}
+
+static void vLatencyEffect(int iChannel, void* pvStream, int iLength, void* pvData) {
+  Uint32 uiQueuedAt = 0;
+  Uint32 uiNow = 0;
+  Uint64 ullNow = ullGetMicroseconds();
+  int iLatency = 0;
+  int iMax = 0;
+
+  (void) pvStream;
+  (void) iLength;
+  (void) pvData;
+  if ( iChannel < 0 || iChannel >= SOUND_CHANNELS ) return;
+  if ( (uiQueuedAt = (Uint32) SDL_AtomicSet(&gastChannelQueuedAt[iChannel], 0)) == 0 ) return;
+  uiNow = (Uint32) ullNow;
+  iLatency = (int) (uiNow - uiQueuedAt);
+  SDL_AtomicAdd(&gstLatencySamples, 1);
+  SDL_AtomicAdd(&gstLatencySumUs, iLatency);
+  while ( iLatency > (iMax = SDL_AtomicGet(&gstLatencyMaxUs)) ) {
+    if ( SDL_AtomicCAS(&gstLatencyMaxUs, iMax, iLatency) ) break;
+  }
+}
+
+static int iGetChannel(int iPriority) {
+  int iVictim = -1;
+  int iVictimPriority = iPriority;
+  int ii = 0;
+
+  for ( ii = 0; ii < SOUND_CHANNELS; ii++ ) {
+    int iSound = SDL_AtomicGet(&gastChannelSound[ii]);
+    if ( iSound < 0 ) return ii;
+    if ( gkastSoundRule[iSound].iPriority < iVictimPriority ) {
+      iVictim = ii;
+      iVictimPriority = gkastSoundRule[iSound].iPriority;
+    }
+  }
+  /* vChannelFinished releases the voice of the cut sound */
+  if ( iVictim >= 0 ) Mix_HaltChannel(iVictim);
+  return iVictim;
+}
+
+void vInitSounds(void) {
+  int ii = 0;
+  for ( ii = 0; ii < SOUND_CHANNELS; ii++ ) {
+    SDL_AtomicSet(&gastChannelSound[ii], -1);
+  }
+  Mix_AllocateChannels(SOUND_CHANNELS);
+  Mix_ChannelFinished(vChannelFinished);
+  gbSoundOn = TRUE;
+}
+
+void vSetSound(ENUM_SOUND eSound, Mix_Chunk* pstChunk) {
+  if ( gapstSound[eSound] ) Mix_FreeChunk(gapstSound[eSound]);
+  gapstSound[eSound] = pstChunk;
+}
+
+void vQueueSound(ENUM_SOUND eSound) {
+  if ( !gbSoundOn ) return;
+  if ( gbLatencyTest ) {
+    Uint64 ullNow = ullGetMicroseconds();
+    Uint32 uiNow = (Uint32) ullNow;
+    /* Only the first request counts, the later ones were merged into it */
+    SDL_AtomicCAS(&gastQueuedAt[eSound], 0, (int) (uiNow ? uiNow : 1));
+  }
+  SDL_AtomicAdd(&gastPending[eSound], 1);
+}
+
+void vFlushSounds(void) {
+  Uint32 uiNow = SDL_GetTicks();
+  int iPriority = 0;
+  int ii = 0;
+
+  if ( !gbSoundOn ) return;
+
+  /* The most important sounds take the free channels first */
+  for ( iPriority = SOUND_MAX_PRIORITY; iPriority >= 0; iPriority-- ) {
+    for ( ii = 0; ii < SOUND_COUNT; ii++ ) {
+      const STRUCT_SOUND_RULE* pkstRule = &gkastSoundRule[ii];
+      int iChannel = -1;
+      int iQueuedAt = 0;
+
+      if ( pkstRule->iPriority != iPriority ) continue;
+      if ( SDL_AtomicSet(&gastPending[ii], 0) == 0 ) continue;
+      iQueuedAt = SDL_AtomicSet(&gastQueuedAt[ii], 0);
+      if ( !gapstSound[ii] ) continue;
+      if ( gauiLastPlay[ii] != 0 && uiNow - gauiLastPlay[ii] < pkstRule->uiCoalesceMs ) continue;
+      if ( SDL_AtomicGet(&gastVoices[ii]) >= pkstRule->iMaxVoices ) continue;
+      if ( (iChannel = iGetChannel(iPriority)) < 0 ) {
+        if ( DEBUG_DETAILS ) vTrace("D: No channel for the sound %d", ii);
+        continue;
+      }
+
+      SDL_AtomicSet(&gastChannelSound[iChannel], ii);
+      SDL_AtomicAdd(&gastVoices[ii], 1);
+      if ( gbLatencyTest ) {
+        /* The mixer drops the effects of a channel when it finishes */
+        SDL_AtomicSet(&gastChannelQueuedAt[iChannel], iQueuedAt);
+        Mix_RegisterEffect(iChannel, vLatencyEffect, NULL, NULL);
+      }
+      if ( Mix_PlayChannel(iChannel, gapstSound[ii], 0) < 0 ) {
+        /* Nothing plays, the mixer would keep the effect for the next sound */
+        if ( gbLatencyTest ) Mix_UnregisterEffect(iChannel, vLatencyEffect);
+        SDL_AtomicSet(&gastChannelSound[iChannel], -1);
+        SDL_AtomicAdd(&gastVoices[ii], -1);
+        continue;
+      }
+      gauiLastPlay[ii] = uiNow ? uiNow : 1;
+    }
+  }
+}
+
+void vEnableSoundLatencyTest(void) {
+  gbLatencyTest = TRUE;
+}
+
+void vPrintSoundLatency(FILE* fpOut) {
+  int iSamples = SDL_AtomicGet(&gstLatencySamples);
+  int iBufferUs = 0;
+
+  if ( !gbLatencyTest ) return;
+  if ( !gbSoundOn ) {
+    fprintf(fpOut, "Audio latency: no sound device\n");
+    return;
+  }
+  iBufferUs = (int) ((long) gstAudioSpec.iChunkSize * 1000000L / gstAudioSpec.iFrequency);
+  if ( iSamples == 0 ) {
+    fprintf(fpOut, "Audio latency: no sound played, buffer %d us\n", iBufferUs);
+    return;
+  }
+  fprintf(
+    fpOut,
+    "Audio latency over %d sounds (event to callback): avg %d us, max %d us; buffer %d us (%d frames at %d Hz)\n",
+    iSamples,
+    SDL_AtomicGet(&gstLatencySumUs) / iSamples,
+    SDL_AtomicGet(&gstLatencyMaxUs),
+    iBufferUs,
+    gstAudioSpec.iChunkSize,
+    gstAudioSpec.iFrequency
+  );
+}
+
+void vDestroySounds(void) {
+  int ii = 0;
+  if ( gbSoundOn ) {
+    Mix_HaltChannel(-1);
+    Mix_ChannelFinished(NULL);
+    gbSoundOn = FALSE;
+  }
+  for ( ii = 0; ii < SOUND_COUNT; ii++ ) {
+    if ( gapstSound[ii] ) {
+      Mix_FreeChunk(gapstSound[ii]);
+      gapstSound[ii] = NULL;
+    }
+    SDL_AtomicSet(&gastPending[ii], 0);
+    SDL_AtomicSet(&gastVoices[ii], 0);
+  }
+}
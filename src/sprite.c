@@ -21,6 +21,7 @@
  */
 
 #include "sprite.h"
+#include "gfxstat.h"
 
 PSTRUCT_SPRITE_SHEET pstLoadSpriteSheet(
   SDL_Renderer *pstRenderer,
@@ -29,26 +30,40 @@ PSTRUCT_SPRITE_SHEET pstLoadSpriteSheet(
   int iHeight,
   int iTotalSprites,
   int iCols) {
+  SDL_Texture* pstTexture = pstGfxLoadTexture(pstRenderer, kpszFile);
+
+  if ( !pstTexture ) {
+    if ( DEBUG_ERROR ) vTrace("Error loading the imagem %s: %s", kpszFile, IMG_GetError());
+    return NULL;
+  }
+
+  return pstCreateSpriteSheet(pstTexture, iWidth, iHeight, iTotalSprites, iCols);
+}
+
+PSTRUCT_SPRITE_SHEET pstCreateSpriteSheet(
+  SDL_Texture *pstTexture,
+  int iWidth,
+  int iHeight,
+  int iTotalSprites,
+  int iCols) {
   PSTRUCT_SPRITE_SHEET pstSpriteSheet = NULL;
   int ii = 0;
 
+  if ( !pstTexture ) return NULL;
+
   pstSpriteSheet = (PSTRUCT_SPRITE_SHEET) calloc(1, sizeof(STRUCT_SPRITE_SHEET));
   if ( !pstSpriteSheet ) {
-    vTrace("Error allocating memory to spritesheet");
+    if ( DEBUG_ERROR ) vTrace("Error allocating memory to spritesheet");
+    vGfxDestroyTexture(pstTexture);
     return NULL;
   }
 
-  pstSpriteSheet->pstTextures = IMG_LoadTexture(pstRenderer, kpszFile);
-  if ( !pstSpriteSheet->pstTextures ) {
-    vTrace("Error loading the imagem %s: %s", kpszFile, IMG_GetError());
-    free(pstSpriteSheet);
-    return NULL;
-  }
+  pstSpriteSheet->pstTextures = pstTexture;
 
   pstSpriteSheet->pstRects = (SDL_Rect *) calloc(1, sizeof(SDL_Rect) * (long unsigned int) iTotalSprites);
   if ( !pstSpriteSheet->pstRects ) {
-    vTrace("Error allocating memory to rectangles");
-    SDL_DestroyTexture(pstSpriteSheet->pstTextures);
+    if ( DEBUG_ERROR ) vTrace("Error allocating memory to rectangles");
+    vGfxDestroyTexture(pstSpriteSheet->pstTextures);
     free(pstSpriteSheet);
     return NULL;
   }
@@ -70,7 +85,7 @@ PSTRUCT_SPRITE_SHEET pstLoadSpriteSheet(
 void vFreeSpriteSheet(PSTRUCT_SPRITE_SHEET pstSpriteSheet) {
   if ( pstSpriteSheet ) {
     if ( pstSpriteSheet->pstTextures ) {
-      SDL_DestroyTexture(pstSpriteSheet->pstTextures);
+      vGfxDestroyTexture(pstSpriteSheet->pstTextures);
     }
     if ( pstSpriteSheet->pstRects ) {
       free(pstSpriteSheet->pstRects);
@@ -0,0 +1,203 @@
+/**
+ * @file state.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "game.h"
+#include "sim.h"
+#include "state.h"
+
+/**
+ * @var gstQuickState
+ * @brief Quick save slot, uiMagic is 0 while it is empty
+ */
+static STRUCT_GAME_STATE gstQuickState;
+
+/**
+ * @var gstInputQuickSave
+ * @brief Quick saves posted
+ */
+static SDL_atomic_t gstInputQuickSave;
+
+/**
+ * @var gstInputQuickLoad
+ * @brief Quick loads posted
+ */
+static SDL_atomic_t gstInputQuickLoad;
+
+/**
+ * @brief Check that a state was saved by this build
+ *
+ * @param kpstState State
+ * @return TRUE state usable
+ * @return FALSE magic, version or map size of another build
+ */
+static boolean bValidGameState(const STRUCT_GAME_STATE* kpstState);
+
+static boolean bValidGameState(const STRUCT_GAME_STATE* kpstState) {
+  return kpstState->uiMagic == STATE_MAGIC
+      && kpstState->usVersion == STATE_VERSION
+      && kpstState->uiMapRows == MAP_ROW
+      && kpstState->uiMapCols == MAP_COL;
+}
+
+void vSaveGameState(PSTRUCT_GAME_STATE pstState) {
+  int ii = 0;
+
+  /* Zeroed padding, two saves of the same game are equal bytes */
+  memset(pstState, 0x00, sizeof(STRUCT_GAME_STATE));
+  pstState->uiMagic = STATE_MAGIC;
+  pstState->usVersion = STATE_VERSION;
+  pstState->uiMapRows = MAP_ROW;
+  pstState->uiMapCols = MAP_COL;
+  memcpy(pstState->aszMap, gszMap, sizeof(pstState->aszMap));
+  pstState->astEntity[0] = gstPlayer;
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    pstState->astEntity[ii+1] = gastGhost[ii];
+  }
+  pstState->iStatus = (int) geStatus;
+  pstState->iLevel = giLevel;
+  pstState->iCurrentLevelScore = giCurrentLevelScore;
+  pstState->iTotalCurrentLevelScore = giTotalCurrentLevelScore;
+  pstState->iTotalGameScore = giTotalGameScore;
+  pstState->iCurrentLevelTime = giCurrentLevelTime;
+  pstState->iPowersCollected = giPowersCollected;
+  pstState->ucGameOver = (Uint8) gbGameOver;
+  pstState->ucTimeOut = (Uint8) gbTimeOut;
+  pstState->ucHeroEndMap = (Uint8) gbHeroEndMap;
+  pstState->ucGhostEndMap = (Uint8) gbGhostEndMap;
+  pstState->ucShowPowerMessage = (Uint8) gbShowPowerMessage;
+  pstState->uiRandomState = uiGetRandomState();
+}
+
+boolean bRestoreGameState(const STRUCT_GAME_STATE* kpstState) {
+  boolean bLevelChanged = FALSE;
+
+  if ( !bValidGameState(kpstState) ) {
+    if ( DEBUG_ERROR ) vTrace("E: Game state of another build, magic [%08X] version [%d]", kpstState->uiMagic, kpstState->usVersion);
+    return FALSE;
+  }
+  bLevelChanged = kpstState->iLevel != giLevel ? TRUE : FALSE;
+  vApplyGameState(kpstState);
+  vRefreshGameState(bLevelChanged);
+  return TRUE;
+}
+
+void vApplyGameState(const STRUCT_GAME_STATE* kpstState) {
+  int ii = 0;
+
+  memcpy(gszMap, kpstState->aszMap, sizeof(gszMap));
+  gstPlayer = kpstState->astEntity[0];
+  for ( ii = 0; ii < MAX_GHOSTS; ii++ ) {
+    gastGhost[ii] = kpstState->astEntity[ii+1];
+  }
+  switch ( kpstState->iStatus ) {
+    case STATUS_RUN: geStatus = STATUS_RUN; break;
+    case STATUS_PAUSE: geStatus = STATUS_PAUSE; break;
+    case STATUS_IDLE:
+    default: geStatus = STATUS_IDLE; break;
+  }
+  giLevel = kpstState->iLevel;
+  giCurrentLevelScore = kpstState->iCurrentLevelScore;
+  giTotalCurrentLevelScore = kpstState->iTotalCurrentLevelScore;
+  giTotalGameScore = kpstState->iTotalGameScore;
+  giCurrentLevelTime = kpstState->iCurrentLevelTime;
+  giPowersCollected = kpstState->iPowersCollected;
+  gbGameOver = kpstState->ucGameOver ? TRUE : FALSE;
+  gbTimeOut = kpstState->ucTimeOut ? TRUE : FALSE;
+  gbHeroEndMap = kpstState->ucHeroEndMap ? TRUE : FALSE;
+  gbGhostEndMap = kpstState->ucGhostEndMap ? TRUE : FALSE;
+  gbShowPowerMessage = kpstState->ucShowPowerMessage ? TRUE : FALSE;
+  vSetRandomState(kpstState->uiRandomState);
+}
+
+void vPostQuickSave(void) {
+  SDL_AtomicAdd(&gstInputQuickSave, 1);
+}
+
+void vPostQuickLoad(void) {
+  SDL_AtomicAdd(&gstInputQuickLoad, 1);
+}
+
+boolean bApplyQuickState(void) {
+  int iSave = SDL_AtomicSet(&gstInputQuickSave, 0);
+  int iLoad = SDL_AtomicSet(&gstInputQuickLoad, 0);
+  boolean bLoaded = FALSE;
+
+  if ( iSave == 0 && iLoad == 0 ) return FALSE;
+  if ( eGetReplayMode() != REPLAY_OFF || bOverlayActive() ) {
+    if ( DEBUG_WARNING ) vTrace("W: Quick save and load ignored now");
+    return FALSE;
+  }
+  if ( iSave > 0 ) {
+    vSaveGameState(&gstQuickState);
+    if ( !bStrIsEmpty(gstCmdLine.szStateFile) ) bSaveGameFile(gstCmdLine.szStateFile);
+    if ( DEBUG_INFO ) vTrace("Quick save of level [%d]", giLevel);
+  }
+  if ( iLoad == 0 ) return FALSE;
+  if ( gstQuickState.uiMagic != STATE_MAGIC ) {
+    if ( bStrIsEmpty(gstCmdLine.szStateFile) ) return FALSE;
+    bLoaded = bLoadGameFile(gstCmdLine.szStateFile);
+  }
+  else {
+    bLoaded = bRestoreGameState(&gstQuickState);
+  }
+  if ( !bLoaded ) return FALSE;
+  /* The ticks before the load may be of another level, the history starts here */
+  vResetRewind();
+  vPushRewindTick();
+  return TRUE;
+}
+
+boolean bSaveGameFile(const char* kpszPath) {
+  STRUCT_GAME_STATE stState;
+  FILE* fpOut = NULL;
+  boolean bOk = FALSE;
+
+  vSaveGameState(&stState);
+  if ( (fpOut = fopen(kpszPath, "wb")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    return FALSE;
+  }
+  bOk = fwrite(&stState, sizeof(stState), 1, fpOut) == 1 ? TRUE : FALSE;
+  if ( fclose(fpOut) != 0 ) bOk = FALSE;
+  if ( !bOk && DEBUG_ERROR ) vTrace("E: Impossible to write the game state [%s]", kpszPath);
+  return bOk;
+}
+
+boolean bLoadGameFile(const char* kpszPath) {
+  STRUCT_GAME_STATE stState;
+  FILE* fpIn = NULL;
+  size_t ulRead = 0;
+
+  if ( (fpIn = fopen(kpszPath, "rb")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    return FALSE;
+  }
+  ulRead = fread(&stState, sizeof(stState), 1, fpIn);
+  fclose(fpIn);
+  if ( ulRead != 1 ) {
+    if ( DEBUG_ERROR ) vTrace("E: Game state [%s] is truncated", kpszPath);
+    return FALSE;
+  }
+  return bRestoreGameState(&stState);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file timeline.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "pacer.h"
+#include "timeline.h"
+
+/**
+ * @struct STRUCT_TIMELINE
+ * @brief State of the trace event file
+ */
+typedef struct STRUCT_TIMELINE {
+  FILE* fpOut;          /**< JSON file or NULL            */
+  SDL_mutex* pstMutex;  /**< Serializes the writers       */
+  Uint64 ullStart;      /**< Time of the first event (us) */
+  boolean bHasEvent;    /**< An event was written         */
+} STRUCT_TIMELINE, *PSTRUCT_TIMELINE;
+
+/**
+ * @var gstTimeline
+ * @brief The trace event file
+ */
+static STRUCT_TIMELINE gstTimeline;
+
+/**
+ * @brief Write an event
+ *
+ * @param chPhase Event phase: B, E, b, e or M
+ * @param kpszName Span name
+ * @param kpszId Id of an async span or NULL
+ * @param kpszArgs JSON object of the arguments or NULL
+ */
+static void vWriteTimelineEvent(char chPhase, const char* kpszName, const char* kpszId, const char* kpszArgs);
+
+/**
+ * @brief Write a string escaping the JSON special characters
+ *
+ * @param kpszText Text
+ */
+static void vWriteJsonString(const char* kpszText);
+
+static void vWriteJsonString(const char* kpszText) {
+  fputc('"', gstTimeline.fpOut);
+  for ( ; *kpszText; kpszText++ ) {
+    if ( *kpszText == '"' || *kpszText == '\\' ) fputc('\\', gstTimeline.fpOut);
+    /* Control characters have no use in a span name */
+    if ( (unsigned char) *kpszText < 0x20 ) continue;
+    fputc(*kpszText, gstTimeline.fpOut);
+  }
+  fputc('"', gstTimeline.fpOut);
+}
+
+static void vWriteTimelineEvent(char chPhase, const char* kpszName, const char* kpszId, const char* kpszArgs) {
+  Uint64 ullNow = 0;
+
+  if ( !gstTimeline.fpOut ) return;
+  SDL_LockMutex(gstTimeline.pstMutex);
+  /* Taken inside the lock so the events of the file are in time order */
+  ullNow = ullGetMicroseconds();
+  fprintf(gstTimeline.fpOut, "%s{\"name\":", gstTimeline.bHasEvent ? ",\n" : "");
+  vWriteJsonString(kpszName);
+  fprintf(
+    gstTimeline.fpOut, ",\"cat\":\"game\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":%d,\"tid\":%lu",
+    chPhase, (unsigned long) (ullNow - gstTimeline.ullStart), TIMELINE_PID, (unsigned long) SDL_ThreadID()
+  );
+  if ( kpszId ) fprintf(gstTimeline.fpOut, ",\"id\":\"%s\"", kpszId);
+  if ( kpszArgs ) fprintf(gstTimeline.fpOut, ",\"args\":%s", kpszArgs);
+  fprintf(gstTimeline.fpOut, "}");
+  gstTimeline.bHasEvent = TRUE;
+  SDL_UnlockMutex(gstTimeline.pstMutex);
+}
+
+boolean bOpenTimeline(const char* kpszPath) {
+  if ( (gstTimeline.pstMutex = SDL_CreateMutex()) == NULL ) {
+    fprintf(stderr, "E: Impossible to create the timeline mutex: [%s]\n", SDL_GetError());
+    return FALSE;
+  }
+  if ( (gstTimeline.fpOut = fopen(kpszPath, "w")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]\n", kpszPath, strerror(errno));
+    SDL_DestroyMutex(gstTimeline.pstMutex);
+    gstTimeline.pstMutex = NULL;
+    return FALSE;
+  }
+  gstTimeline.ullStart = ullGetMicroseconds();
+  gstTimeline.bHasEvent = FALSE;
+  fprintf(gstTimeline.fpOut, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  return TRUE;
+}
+
+void vTimelineThreadName(const char* kpszName) {
+  char szArgs[128];
+  if ( !gstTimeline.fpOut ) return;
+  sprintf(szArgs, "{\"name\":\"%.*s\"}", (int) sizeof(szArgs) - 16, kpszName);
+  vWriteTimelineEvent('M', "thread_name", NULL, szArgs);
+}
+
+void vTimelineBegin(const char* kpszName) {
+  vWriteTimelineEvent('B', kpszName, NULL, NULL);
+}
+
+void vTimelineEnd(const char* kpszName) {
+  vWriteTimelineEvent('E', kpszName, NULL, NULL);
+}
+
+void vTimelineAsyncBegin(const char* kpszName, unsigned long ulId) {
+  char szId[32];
+  if ( !gstTimeline.fpOut ) return;
+  sprintf(szId, "0x%lx", ulId);
+  vWriteTimelineEvent('b', kpszName, szId, NULL);
+}
+
+void vTimelineAsyncEnd(const char* kpszName, unsigned long ulId) {
+  char szId[32];
+  if ( !gstTimeline.fpOut ) return;
+  sprintf(szId, "0x%lx", ulId);
+  vWriteTimelineEvent('e', kpszName, szId, NULL);
+}
+
+void vCloseTimeline(void) {
+  if ( !gstTimeline.fpOut ) return;
+  SDL_LockMutex(gstTimeline.pstMutex);
+  fprintf(gstTimeline.fpOut, "\n]}\n");
+  fclose(gstTimeline.fpOut);
+  gstTimeline.fpOut = NULL;
+  SDL_UnlockMutex(gstTimeline.pstMutex);
+  SDL_DestroyMutex(gstTimeline.pstMutex);
+  gstTimeline.pstMutex = NULL;
+}
@@ -21,59 +21,618 @@
  */
 
 #include <ctype.h>
+#include <SDL2/SDL.h>
 #include "trace.h"
 
 STRUCT_TRACE_PRM gstTracePrm;
 
-static int bStrIsEmpty(const char *kpszString) {
-  if ( kpszString == NULL ) {
-    return 1;
+/**
+ * @struct STRUCT_TRACE_SLOT
+ * @brief A line in the ring
+ */
+typedef struct STRUCT_TRACE_SLOT {
+  SDL_atomic_t stSeq;            /**< Position the slot waits for, +1 when filled */
+  time_t lSeconds;               /**< Time of the line                            */
+  int iLen;                      /**< Length of the line                          */
+  char szLine[TRACE_LINE_MAX];   /**< Line without the time                       */
+} STRUCT_TRACE_SLOT, *PSTRUCT_TRACE_SLOT;
+
+/**
+ * @var gastTraceRing
+ * @brief Lines formatted by any thread, written by the flush thread
+ */
+static STRUCT_TRACE_SLOT gastTraceRing[TRACE_RING_SLOTS];
+
+/**
+ * @var gstTraceHead
+ * @brief Next position taken by a producer
+ */
+static SDL_atomic_t gstTraceHead;
+
+/**
+ * @var giTraceTail
+ * @brief Next position read by the flush thread
+ */
+static int giTraceTail = 0;
+
+/**
+ * @var gpstTraceWake
+ * @brief Posted when the ring is half full, wakes the flush thread earlier
+ */
+static SDL_sem* gpstTraceWake = NULL;
+
+/**
+ * @var gstTraceStop
+ * @brief Set to stop the flush thread
+ */
+static SDL_atomic_t gstTraceStop;
+
+/**
+ * @var gpstTraceThread
+ * @brief Flush thread, NULL writes synchronously
+ */
+static SDL_Thread* gpstTraceThread = NULL;
+
+/**
+ * @var gpstTraceLock
+ * @brief Serializes the writers when there is no flush thread
+ */
+static SDL_mutex* gpstTraceLock = NULL;
+
+/**
+ * @var gfpTrace
+ * @brief Trace file, open from vInitTrace to vCloseTrace
+ */
+static FILE* gfpTrace = NULL;
+
+/**
+ * @var glTraceSize
+ * @brief Bytes in the trace file
+ */
+static long glTraceSize = 0;
+
+/**
+ * @var glStampSeconds
+ * @brief Second of gszStamp
+ */
+static time_t glStampSeconds = 0;
+
+/**
+ * @var gszStamp
+ * @brief Formatted time of glStampSeconds, only used by the writer
+ */
+static char gszStamp[32] = "";
+
+/**
+ * @var gapvTraceFormat
+ * @brief Format strings of the binary trace, the id is the index. Filled by
+ * the producers with a CAS, the pointer of the literal is the key
+ */
+static void* gapvTraceFormat[TRACE_MAX_FORMATS];
+
+/**
+ * @var gullTraceStart
+ * @brief Performance counter when the trace started
+ */
+static Uint64 gullTraceStart = 0;
+
+/**
+ * @var glTraceStart
+ * @brief Time when the trace started, the event times are relative to it
+ */
+static time_t glTraceStart = 0;
+
+/**
+ * @var gszWriteBuffer
+ * @brief Lines gathered by the writer
+ */
+static char gszWriteBuffer[TRACE_WRITE_SIZE];
+
+/**
+ * @var giWriteLen
+ * @brief Bytes in gszWriteBuffer
+ */
+static int giWriteLen = 0;
+
+/**
+ * @brief Write gszWriteBuffer to the file, rotating it when it grows past
+ * gstTracePrm.lMaxSize
+ */
+static void vWriteBuffer(void);
+
+/**
+ * @brief Write the header of the binary trace in the file
+ *
+ * @param bFormats Also write the formats registered so far, used when the
+ * file is rotated
+ */
+static void vWriteBinaryHeader(int bFormats);
+
+/**
+ * @brief Append a format record to a buffer
+ *
+ * @param pszRecord Buffer of TRACE_LINE_MAX bytes
+ * @param iId Format id
+ * @param kpszFmt Format string
+ * @return Bytes of the record
+ */
+static int iEncodeFormat(char* pszRecord, int iId, const char* kpszFmt);
+
+/**
+ * @brief Get the id of a format, registering it on first use
+ *
+ * @param kpszFmt Format string, a literal that lives until the end
+ * @return Id or -1 when the table is full
+ */
+static int iGetFormatId(const char* kpszFmt);
+
+/**
+ * @brief Encode an event with the raw arguments of its format
+ *
+ * @param pszRecord Buffer of TRACE_LINE_MAX bytes
+ * @param iId Format id
+ * @param kpszFmt Format string
+ * @param ap Arguments
+ * @return Bytes of the record
+ */
+static int iEncodeEvent(char* pszRecord, int iId, const char* kpszFmt, va_list ap);
+
+/**
+ * @brief Encode a text event, the line is the only argument
+ *
+ * @param pszRecord Buffer of TRACE_LINE_MAX bytes
+ * @param kpszFmt Always "%s"
+ * @return Bytes of the record
+ */
+static int iEncodeText(char* pszRecord, const char* kpszFmt, ...);
+
+/**
+ * @brief Copy bytes at the end of a record
+ *
+ * @param pszRecord Buffer of TRACE_LINE_MAX bytes
+ * @param iLen Bytes in the record
+ * @param pvData Bytes to copy
+ * @param iSize Quantity of bytes
+ * @return New length or -1 when they don't fit
+ */
+static int iPutBytes(char* pszRecord, int iLen, const void* pvData, int iSize);
+
+/**
+ * @brief Queue a line or a binary record for the flush thread
+ *
+ * @param kpszRecord Line or record
+ * @param iLen Bytes of the record
+ */
+static void vPushRecord(const char* kpszRecord, int iLen);
+
+/**
+ * @brief Append a line to gszWriteBuffer with its time, the time is formatted
+ * once per second. Binary records are appended as they are
+ *
+ * @param lSeconds Time of the line
+ * @param kpszLine Line
+ * @param iLen Length of the line
+ */
+static void vAppendLine(time_t lSeconds, const char* kpszLine, int iLen);
+
+/**
+ * @brief Move the filled slots of the ring to the file
+ *
+ * @return Lines written
+ */
+static int iDrainTrace(void);
+
+/**
+ * @brief Flush thread loop
+ *
+ * @param pvData Not used
+ * @return 0
+ */
+static int iTraceThread(void* pvData);
+
+static int iPutBytes(char* pszRecord, int iLen, const void* pvData, int iSize) {
+  if ( iLen < 0 || iSize > TRACE_LINE_MAX - iLen ) return -1;
+  memcpy(pszRecord + iLen, pvData, (size_t) iSize);
+  return iLen + iSize;
+}
+
+static int iEncodeFormat(char* pszRecord, int iId, const char* kpszFmt) {
+  Uint8 ucType = TRACE_RECORD_FORMAT;
+  Uint16 usId = (Uint16) iId;
+  Uint16 usLen = 0;
+  size_t lFmtLen = strlen(kpszFmt);
+  int iLen = 0;
+
+  if ( lFmtLen > TRACE_LINE_MAX - 5 ) lFmtLen = TRACE_LINE_MAX - 5;
+  usLen = (Uint16) lFmtLen;
+  iLen = iPutBytes(pszRecord, iLen, &ucType, 1);
+  iLen = iPutBytes(pszRecord, iLen, &usId, 2);
+  iLen = iPutBytes(pszRecord, iLen, &usLen, 2);
+  return iPutBytes(pszRecord, iLen, kpszFmt, (int) usLen);
+}
+
+static int iGetFormatId(const char* kpszFmt) {
+  char szRecord[TRACE_LINE_MAX];
+  unsigned long ulHash = (unsigned long) kpszFmt;
+  int iProbe = 0;
+
+  ulHash ^= ulHash >> 9;
+  for ( iProbe = 0; iProbe < TRACE_MAX_FORMATS; iProbe++ ) {
+    int iSlot = (int) ((ulHash + (unsigned long) iProbe) & (TRACE_MAX_FORMATS - 1));
+    void* pvFmt = SDL_AtomicGetPtr(&gapvTraceFormat[iSlot]);
+    if ( pvFmt == (const void*) kpszFmt ) return iSlot;
+    if ( pvFmt != NULL ) continue;
+    if ( SDL_AtomicCASPtr(&gapvTraceFormat[iSlot], NULL, (void*) kpszFmt) ) {
+      vPushRecord(szRecord, iEncodeFormat(szRecord, iSlot, kpszFmt));
+      return iSlot;
+    }
+    /* Another thread took the slot, it may be the same format */
+    iProbe--;
+  }
+  return -1;
+}
+
+static int iEncodeEvent(char* pszRecord, int iId, const char* kpszFmt, va_list ap) {
+  Uint64 ullTicks = SDL_GetPerformanceCounter() - gullTraceStart;
+  Uint64 ullFrequency = SDL_GetPerformanceFrequency();
+  Uint64 ullUs = ullTicks / ullFrequency * 1000000 + ullTicks % ullFrequency * 1000000 / ullFrequency;
+  Uint32 auiUs[2];
+  Uint8 ucType = TRACE_RECORD_EVENT;
+  Uint16 usId = (Uint16) iId;
+  Uint16 usArgs = 0;
+  const char* kpszConv = kpszFmt;
+  int iArgsAt = 0;
+  int iLen = 0;
+
+  auiUs[0] = (Uint32) (ullUs & 0xFFFFFFFFu);
+  auiUs[1] = (Uint32) (ullUs >> 32);
+  iLen = iPutBytes(pszRecord, iLen, &ucType, 1);
+  iLen = iPutBytes(pszRecord, iLen, &usId, 2);
+  iLen = iPutBytes(pszRecord, iLen, auiUs, 8);
+  iLen = iPutBytes(pszRecord, iLen, &usArgs, 2);
+  iArgsAt = iLen;
+
+  while ( *kpszConv ) {
+    int iNext = 0;
+    int bLong = 0;
+
+    if ( *kpszConv++ != '%' ) continue;
+    if ( *kpszConv == '%' ) {
+      kpszConv++;
+      continue;
+    }
+    while ( *kpszConv && strchr("-+ #0", *kpszConv) ) kpszConv++;
+    if ( *kpszConv == '*' ) {
+      int iWidth = va_arg(ap, int);
+      if ( (iNext = iPutBytes(pszRecord, iLen, &iWidth, 4)) < 0 ) break;
+      iLen = iNext;
+      kpszConv++;
+    }
+    while ( isdigit((unsigned char) *kpszConv) ) kpszConv++;
+    if ( *kpszConv == '.' ) {
+      kpszConv++;
+      if ( *kpszConv == '*' ) {
+        int iPrecision = va_arg(ap, int);
+        if ( (iNext = iPutBytes(pszRecord, iLen, &iPrecision, 4)) < 0 ) break;
+        iLen = iNext;
+        kpszConv++;
+      }
+      while ( isdigit((unsigned char) *kpszConv) ) kpszConv++;
+    }
+    if ( *kpszConv == 'l' ) {
+      bLong = 1;
+      kpszConv++;
+    }
+    else if ( *kpszConv == 'h' ) {
+      kpszConv++;
+    }
+    switch ( *kpszConv ) {
+      case 'd': case 'i': case 'c': case 'u': case 'x': case 'X': case 'o': {
+        if ( bLong ) {
+          unsigned long ulValue = va_arg(ap, unsigned long);
+          Uint32 auiValue[2];
+          auiValue[0] = (Uint32) (ulValue & 0xFFFFFFFFul);
+          auiValue[1] = (Uint32) ((ulValue >> 16) >> 16);
+          iNext = iPutBytes(pszRecord, iLen, auiValue, 8);
+        }
+        else {
+          int iValue = va_arg(ap, int);
+          iNext = iPutBytes(pszRecord, iLen, &iValue, 4);
+        }
+        break;
+      }
+      case 'f': case 'e': case 'E': case 'g': case 'G': {
+        double dValue = va_arg(ap, double);
+        iNext = iPutBytes(pszRecord, iLen, &dValue, 8);
+        break;
+      }
+      case 's': {
+        const char* kpszValue = va_arg(ap, const char*);
+        size_t lValueLen = kpszValue ? strlen(kpszValue) : 0;
+        Uint16 usValueLen = 0;
+        /* Strings are cut to what is left of the record */
+        if ( lValueLen > (size_t) (TRACE_LINE_MAX - iLen - 2) ) lValueLen = (size_t) (TRACE_LINE_MAX - iLen - 2);
+        usValueLen = (Uint16) lValueLen;
+        iNext = iPutBytes(pszRecord, iLen, &usValueLen, 2);
+        iNext = iPutBytes(pszRecord, iNext, kpszValue, (int) usValueLen);
+        break;
+      }
+      case 'p': {
+        unsigned long ulValue = (unsigned long) va_arg(ap, void*);
+        Uint32 auiValue[2];
+        auiValue[0] = (Uint32) (ulValue & 0xFFFFFFFFul);
+        auiValue[1] = (Uint32) ((ulValue >> 16) >> 16);
+        iNext = iPutBytes(pszRecord, iLen, auiValue, 8);
+        break;
+      }
+      default: {
+        iNext = iLen;
+        break;
+      }
+    }
+    if ( iNext < 0 ) break;
+    iLen = iNext;
+    if ( *kpszConv ) kpszConv++;
+  }
+
+  usArgs = (Uint16) (iLen - iArgsAt);
+  memcpy(pszRecord + iArgsAt - 2, &usArgs, 2);
+  return iLen;
+}
+
+static int iEncodeText(char* pszRecord, const char* kpszFmt, ...) {
+  int iLen = 0;
+  va_list ap;
+  va_start(ap, kpszFmt);
+  iLen = iEncodeEvent(pszRecord, TRACE_TEXT_ID, kpszFmt, ap);
+  va_end(ap);
+  return iLen;
+}
+
+static void vWriteBinaryHeader(int bFormats) {
+  char szRecord[TRACE_LINE_MAX];
+  Uint32 auiHeader[4];
+  unsigned long ulStart = (unsigned long) glTraceStart;
+  int ii = 0;
+
+  auiHeader[0] = 0x01020304u;
+  auiHeader[1] = TRACE_BINARY_VERSION;
+  auiHeader[2] = (Uint32) (ulStart & 0xFFFFFFFFul);
+  auiHeader[3] = (Uint32) ((ulStart >> 16) >> 16);
+  fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), gfpTrace);
+  fwrite(auiHeader, 1, sizeof(auiHeader), gfpTrace);
+  glTraceSize += (long) (sizeof(TRACE_MAGIC) + sizeof(auiHeader));
+  if ( !bFormats ) return;
+  for ( ii = 0; ii < TRACE_MAX_FORMATS; ii++ ) {
+    const char* kpszFmt = (const char*) SDL_AtomicGetPtr(&gapvTraceFormat[ii]);
+    int iLen = 0;
+    if ( !kpszFmt ) continue;
+    iLen = iEncodeFormat(szRecord, ii, kpszFmt);
+    fwrite(szRecord, 1, (size_t) iLen, gfpTrace);
+    glTraceSize += iLen;
   }
-  while ( *kpszString ) {
-    if ( !isspace((unsigned char) *kpszString) ) {
-      return 0;
+}
+
+static void vWriteBuffer(void) {
+  char szOld[sizeof(gstTracePrm.szTrace) + 2];
+
+  if ( giWriteLen == 0 || !gfpTrace ) return;
+  if ( gstTracePrm.lMaxSize > 0 && glTraceSize > 0 && glTraceSize + giWriteLen > gstTracePrm.lMaxSize ) {
+    fclose(gfpTrace);
+    sprintf(szOld, "%s.1", gstTracePrm.szTrace);
+    remove(szOld);
+    rename(gstTracePrm.szTrace, szOld);
+    glTraceSize = 0;
+    if ( (gfpTrace = fopen(gstTracePrm.szTrace, gstTracePrm.bBinary ? "ab" : "a")) == NULL ) {
+      fprintf(stderr, "E: Impossible to open the file [%s]: [%s]", gstTracePrm.szTrace, strerror(errno));
+      giWriteLen = 0;
+      return;
     }
-    kpszString++;
+    /* The new file must be readable alone */
+    if ( gstTracePrm.bBinary ) vWriteBinaryHeader(1);
   }
-  return 1;
+  fwrite(gszWriteBuffer, 1, (size_t) giWriteLen, gfpTrace);
+  fflush(gfpTrace);
+  glTraceSize += giWriteLen;
+  giWriteLen = 0;
+}
+
+static void vAppendLine(time_t lSeconds, const char* kpszLine, int iLen) {
+  int iStampLen = 0;
+
+  if ( gstTracePrm.bBinary ) {
+    if ( TRACE_WRITE_SIZE - giWriteLen < iLen ) vWriteBuffer();
+    memcpy(gszWriteBuffer + giWriteLen, kpszLine, (size_t) iLen);
+    giWriteLen += iLen;
+    return;
+  }
+  if ( lSeconds != glStampSeconds || gszStamp[0] == '\0' ) {
+    struct tm* pstToday = localtime(&lSeconds);
+    glStampSeconds = lSeconds;
+    sprintf(
+      gszStamp,
+      "%02d/%02d/%02d %02d:%02d:%02d - ",
+      pstToday->tm_mday,
+      pstToday->tm_mon+1,
+      pstToday->tm_year+1900,
+      pstToday->tm_hour,
+      pstToday->tm_min,
+      pstToday->tm_sec
+    );
+  }
+  iStampLen = (int) strlen(gszStamp);
+  if ( TRACE_WRITE_SIZE - giWriteLen <= iStampLen + iLen ) vWriteBuffer();
+  memcpy(gszWriteBuffer + giWriteLen, gszStamp, (size_t) iStampLen);
+  giWriteLen += iStampLen;
+  memcpy(gszWriteBuffer + giWriteLen, kpszLine, (size_t) iLen);
+  giWriteLen += iLen;
+  gszWriteBuffer[giWriteLen++] = '\n';
+}
+
+static int iDrainTrace(void) {
+  int iCtLines = 0;
+
+  for ( ;; ) {
+    PSTRUCT_TRACE_SLOT pstSlot = &gastTraceRing[giTraceTail & (TRACE_RING_SLOTS - 1)];
+    if ( SDL_AtomicGet(&pstSlot->stSeq) != giTraceTail + 1 ) break;
+    vAppendLine(pstSlot->lSeconds, pstSlot->szLine, pstSlot->iLen);
+    /* Free for the producer of the next lap */
+    SDL_AtomicSet(&pstSlot->stSeq, giTraceTail + TRACE_RING_SLOTS);
+    giTraceTail++;
+    iCtLines++;
+  }
+  vWriteBuffer();
+  return iCtLines;
+}
+
+static int iTraceThread(void* pvData) {
+  (void) pvData;
+  while ( !SDL_AtomicGet(&gstTraceStop) ) {
+    if ( iDrainTrace() == 0 ) SDL_SemWaitTimeout(gpstTraceWake, TRACE_FLUSH_MS);
+  }
+  iDrainTrace();
+  return 0;
 }
 
 void vInitTrace(const char *kpszTrace, const char *kpszDebugLevel) {
+  char chLevel = '0';
+  int ii = 0;
+
   sprintf(gstTracePrm.szTrace, "%s", kpszTrace);
   sprintf(gstTracePrm.szDebugLevel, "%s", kpszDebugLevel);
+
+  /* The format ids and the times only hold for one run, a binary trace is not appended */
+  if ( (gfpTrace = fopen(gstTracePrm.szTrace, gstTracePrm.bBinary ? "wb" : "a")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]", gstTracePrm.szTrace, strerror(errno));
+    return;
+  }
+  fseek(gfpTrace, 0L, SEEK_END);
+  glTraceSize = ftell(gfpTrace);
+  /* Parsed once, the DEBUG_ macros compare integers */
+  chLevel = gstTracePrm.szDebugLevel[0];
+  gstTracePrm.iLevel = chLevel > '9' ? 9 : chLevel > '0' ? chLevel - '0' : 0;
+  gullTraceStart = SDL_GetPerformanceCounter();
+  glTraceStart = time(NULL);
+  if ( gstTracePrm.bBinary ) vWriteBinaryHeader(0);
+
+  for ( ii = 0; ii < TRACE_RING_SLOTS; ii++ ) {
+    SDL_AtomicSet(&gastTraceRing[ii].stSeq, ii);
+  }
+  SDL_AtomicSet(&gstTraceHead, 0);
+  SDL_AtomicSet(&gstTraceStop, 0);
+  giTraceTail = 0;
+  if ( (gpstTraceLock = SDL_CreateMutex()) == NULL ) {
+    fprintf(stderr, "W: Impossible to create the trace mutex: [%s]", SDL_GetError());
+  }
+  if ( (gpstTraceWake = SDL_CreateSemaphore(0)) == NULL ) {
+    fprintf(stderr, "W: Impossible to create the trace semaphore: [%s]", SDL_GetError());
+  }
+  else if ( (gpstTraceThread = SDL_CreateThread(iTraceThread, "trace", NULL)) == NULL ) {
+    fprintf(stderr, "W: Impossible to create the trace thread: [%s]", SDL_GetError());
+  }
+  atexit(vCloseTrace);
 }
 
+void vSetTraceMaxSize(long lMaxSize) {
+  gstTracePrm.lMaxSize = lMaxSize;
+}
+
+int bSetTraceFormat(const char* kpszFormat) {
+  if ( strcmp(kpszFormat, "text") == 0 ) gstTracePrm.bBinary = 0;
+  else if ( strcmp(kpszFormat, "binary") == 0 ) gstTracePrm.bBinary = 1;
+  else return 0;
+  return 1;
+}
 
 void vTrace(const char* kpszFmt, ...) {
-  FILE* fpTrace = NULL;
-  time_t lSeconds = 0;
-  struct tm* pstToday = NULL;
+  char szLine[TRACE_FORMAT_MAX];
+  int iLen = 0;
+  int iId = 0;
   va_list ap;
 
-  if ( bStrIsEmpty(gstTracePrm.szTrace) || bStrIsEmpty(gstTracePrm.szDebugLevel) ) return;
-  lSeconds = time(NULL);
-  pstToday = localtime(&lSeconds);
+  if ( !gfpTrace ) return;
 
   va_start(ap, kpszFmt);
-  if ( (fpTrace = fopen(gstTracePrm.szTrace, "a")) == NULL ) {
-    fprintf(stderr, "E: Impossible to open the file [%s]: [%s]", gstTracePrm.szTrace, strerror(errno));
+  if ( gstTracePrm.bBinary && (iId = iGetFormatId(kpszFmt)) >= 0 ) {
+    iLen = iEncodeEvent(szLine, iId, kpszFmt, ap);
+    va_end(ap);
+    vPushRecord(szLine, iLen);
     return;
   }
-  fprintf(
-    fpTrace,
-    "%02d/%02d/%02d %02d:%02d:%02d - ",
-    pstToday->tm_mday,
-    pstToday->tm_mon+1,
-    pstToday->tm_year+1900,
-    pstToday->tm_hour,
-    pstToday->tm_min,
-    pstToday->tm_sec
-  );
-  vfprintf(fpTrace, kpszFmt, ap);
-  fprintf(fpTrace, "\n");
-  fclose(fpTrace);
-  fpTrace = NULL;
+  iLen = SDL_vsnprintf(szLine, sizeof(szLine), kpszFmt, ap);
   va_end(ap);
+  if ( iLen < 0 ) return;
+  if ( iLen >= (int) sizeof(szLine) ) iLen = (int) sizeof(szLine) - 1;
+  if ( gstTracePrm.bBinary ) {
+    /* Format table full, the line goes as the argument of a text event */
+    char szRecord[TRACE_LINE_MAX];
+    szLine[TRACE_LINE_MAX - 16] = '\0';
+    iLen = iEncodeText(szRecord, "%s", szLine);
+    vPushRecord(szRecord, iLen);
+    return;
+  }
+  if ( iLen > TRACE_LINE_MAX ) iLen = TRACE_LINE_MAX;
+  vPushRecord(szLine, iLen);
+}
+
+static void vPushRecord(const char* kpszRecord, int iLen) {
+  PSTRUCT_TRACE_SLOT pstSlot = NULL;
+  int iPos = 0;
+
+  if ( !gpstTraceThread ) {
+    /* No flush thread, the lines are written at once by the caller */
+    if ( gpstTraceLock ) SDL_LockMutex(gpstTraceLock);
+    vAppendLine(time(NULL), kpszRecord, iLen);
+    vWriteBuffer();
+    if ( gpstTraceLock ) SDL_UnlockMutex(gpstTraceLock);
+    return;
+  }
+
+  /* Bounded MPSC queue: a slot is free when its sequence is the position */
+  iPos = SDL_AtomicGet(&gstTraceHead);
+  for ( ;; ) {
+    int iDiff = 0;
+    pstSlot = &gastTraceRing[iPos & (TRACE_RING_SLOTS - 1)];
+    iDiff = SDL_AtomicGet(&pstSlot->stSeq) - iPos;
+    if ( iDiff == 0 ) {
+      if ( SDL_AtomicCAS(&gstTraceHead, iPos, iPos + 1) ) break;
+      iPos = SDL_AtomicGet(&gstTraceHead);
+    }
+    else if ( iDiff < 0 ) {
+      /* Full, only when the writer can not keep up: wait instead of losing the line */
+      SDL_SemPost(gpstTraceWake);
+      SDL_Delay(1);
+      iPos = SDL_AtomicGet(&gstTraceHead);
+    }
+    else {
+      iPos = SDL_AtomicGet(&gstTraceHead);
+    }
+  }
+  if ( (iPos & (TRACE_RING_SLOTS / 2 - 1)) == 0 ) SDL_SemPost(gpstTraceWake);
+  pstSlot->lSeconds = time(NULL);
+  pstSlot->iLen = iLen;
+  memcpy(pstSlot->szLine, kpszRecord, (size_t) iLen);
+  /* Full barrier, the line is visible before the sequence */
+  SDL_AtomicSet(&pstSlot->stSeq, iPos + 1);
+}
+
+void vCloseTrace(void) {
+  if ( !gfpTrace ) return;
+  if ( gpstTraceThread ) {
+    SDL_AtomicSet(&gstTraceStop, 1);
+    SDL_WaitThread(gpstTraceThread, NULL);
+    gpstTraceThread = NULL;
+  }
+  if ( gpstTraceWake ) {
+    SDL_DestroySemaphore(gpstTraceWake);
+    gpstTraceWake = NULL;
+  }
+  if ( gpstTraceLock ) {
+    SDL_DestroyMutex(gpstTraceLock);
+    gpstTraceLock = NULL;
+  }
+  fclose(gfpTrace);
+  gfpTrace = NULL;
 }
 
 void vTraceCmdLine(int argc, char **argv) {
@@ -35,3 +35,12 @@ boolean bStrIsEmpty(const char *kpszString) {
   return TRUE;
 }
 
+Uint64 ullHashBytes(const void* kpvData, size_t ulSize, Uint64 ullHash) {
+  const Uint8* kpbyData = (const Uint8*) kpvData;
+  size_t ii = 0;
+  for ( ii = 0; ii < ulSize; ii++ ) {
+    ullHash ^= kpbyData[ii];
+    ullHash *= HASH_PRIME;
+  }
+  return ullHash;
+}
@@ -0,0 +1,321 @@
+/**
+ * @file vecenv.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief A simple dot maze game written in ANSI C using SDL2
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <semaphore.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+#include "game.h"
+#include "vecenv.h"
+
+/**
+ * @def VECENV_CELLS
+ * @brief Cells of a layer of the observation
+ */
+#define VECENV_CELLS (MAP_ROW * MAP_COL)
+
+/**
+ * @brief Write the layers of a game
+ *
+ * @param kpstState Game
+ * @param pucObs Receives VECENV_OBS_BYTES
+ */
+static void vWriteVecEnvObs(const STRUCT_GAME_STATE* kpstState, Uint8* pucObs);
+
+/**
+ * @brief Start a new episode in an environment, the ghosts draw a new seed
+ *
+ * @param pstEnv Batch
+ * @param iEnv Environment
+ */
+static void vResetVecEnvGame(PSTRUCT_VECENV pstEnv, int iEnv);
+
+/**
+ * @brief Round a size up to VECENV_SHM_ALIGN
+ *
+ * @param ulSize Size
+ * @return Aligned size
+ */
+static unsigned long ulAlignVecEnv(unsigned long ulSize);
+
+static void vWriteVecEnvObs(const STRUCT_GAME_STATE* kpstState, Uint8* pucObs) {
+  Uint8* pucWalls = pucObs;
+  Uint8* pucDots = pucObs + VECENV_CELLS;
+  Uint8* pucPowers = pucObs + 2 * VECENV_CELLS;
+  Uint8* pucHero = pucObs + 3 * VECENV_CELLS;
+  Uint8* pucGhosts = pucObs + 4 * VECENV_CELLS;
+  Uint8* pucPowersHeld = pucObs + 5 * VECENV_CELLS;
+  const STRUCT_ENTITY* kpstEntity = NULL;
+  int iRow = 0;
+  int iCol = 0;
+  int ii = 0;
+
+  memset(pucObs, 0x00, VECENV_OBS_BYTES);
+  for ( iRow = 0; iRow < MAP_ROW; iRow++ ) {
+    for ( iCol = 0; iCol < MAP_COL; iCol++ ) {
+      switch ( kpstState->aszMap[iRow][iCol] ) {
+        case '#': pucWalls[iRow * MAP_COL + iCol] = 1; break;
+        case '.': pucDots[iRow * MAP_COL + iCol] = 1; break;
+        case 'O': pucPowers[iRow * MAP_COL + iCol] = 1; break;
+        default: break;
+      }
+    }
+  }
+  for ( ii = 0; ii < STATE_ENTITIES; ii++ ) {
+    kpstEntity = &kpstState->astEntity[ii];
+    if ( kpstEntity->iX < 0 || kpstEntity->iX >= MAP_COL || kpstEntity->iY < 0 || kpstEntity->iY >= MAP_ROW ) continue;
+    if ( ii == 0 ) {
+      pucHero[kpstEntity->iY * MAP_COL + kpstEntity->iX] = 1;
+      continue;
+    }
+    pucGhosts[kpstEntity->iY * MAP_COL + kpstEntity->iX] = 1;
+    /* The ghost hides the cell it is over */
+    if ( kpstEntity->chOldXY == '.' ) pucDots[kpstEntity->iY * MAP_COL + kpstEntity->iX] = 1;
+    if ( kpstEntity->chOldXY == 'O' ) pucPowers[kpstEntity->iY * MAP_COL + kpstEntity->iX] = 1;
+  }
+  if ( kpstState->iPowersCollected > 0 ) memset(pucPowersHeld, 1, VECENV_CELLS);
+}
+
+static void vResetVecEnvGame(PSTRUCT_VECENV pstEnv, int iEnv) {
+  memcpy(&pstEnv->pastGame[iEnv], &pstEnv->stStart, sizeof(STRUCT_GAME_STATE));
+  pstEnv->paiTicks[iEnv] = 0;
+  pstEnv->pastGame[iEnv].uiRandomState = uiRandomFrom(&pstEnv->uiRandomState);
+  if ( pstEnv->pastGame[iEnv].uiRandomState == 0 ) pstEnv->pastGame[iEnv].uiRandomState = RNG_DEFAULT_SEED;
+}
+
+static unsigned long ulAlignVecEnv(unsigned long ulSize) {
+  return (ulSize + VECENV_SHM_ALIGN - 1) / VECENV_SHM_ALIGN * VECENV_SHM_ALIGN;
+}
+
+PSTRUCT_VECENV pstCreateVecEnv(int iCtEnvs, const STRUCT_GAME_STATE* kpstStart, Uint32 uiSeed) {
+  PSTRUCT_VECENV pstEnv = NULL;
+
+  if ( iCtEnvs < 1 || iCtEnvs > VECENV_MAX_COUNT ) {
+    if ( DEBUG_ERROR ) vTrace("E: Invalid count of environments: [%d]", iCtEnvs);
+    return NULL;
+  }
+  if ( (pstEnv = (PSTRUCT_VECENV) calloc(1, sizeof(STRUCT_VECENV))) == NULL ) return NULL;
+  pstEnv->pastGame = (PSTRUCT_GAME_STATE) calloc((size_t) iCtEnvs, sizeof(STRUCT_GAME_STATE));
+  pstEnv->paiTicks = (int*) calloc((size_t) iCtEnvs, sizeof(int));
+  if ( !pstEnv->pastGame || !pstEnv->paiTicks ) {
+    vDestroyVecEnv(pstEnv);
+    return NULL;
+  }
+  pstEnv->iCtEnvs = iCtEnvs;
+  pstEnv->uiRandomState = uiSeed != 0 ? uiSeed : RNG_DEFAULT_SEED;
+  memcpy(&pstEnv->stStart, kpstStart, sizeof(STRUCT_GAME_STATE));
+  vResetVecEnv(pstEnv, NULL);
+  if ( DEBUG_INFO ) vTrace("Vector of [%d] environments created", iCtEnvs);
+  return pstEnv;
+}
+
+void vResetVecEnv(PSTRUCT_VECENV pstEnv, Uint8* pucObs) {
+  int ii = 0;
+
+  for ( ii = 0; ii < pstEnv->iCtEnvs; ii++ ) {
+    vResetVecEnvGame(pstEnv, ii);
+    if ( pucObs ) vWriteVecEnvObs(&pstEnv->pastGame[ii], pucObs + (size_t) ii * VECENV_OBS_BYTES);
+  }
+}
+
+void vStepVecEnv(PSTRUCT_VECENV pstEnv, const Sint32* kpiActions, Uint8* pucObs, float* pfRewards, Uint8* pucDones) {
+  STRUCT_RULE_EVENTS stEvents;
+  PSTRUCT_GAME_STATE pstGame = NULL;
+  Uint64 ullStart = SDL_GetPerformanceCounter();
+  double dReward = 0.0;
+  int iScore = 0;
+  boolean bTimeOut = FALSE;
+  Uint8 ucDone = 0;
+  int ii = 0;
+
+  for ( ii = 0; ii < pstEnv->iCtEnvs; ii++ ) {
+    pstGame = &pstEnv->pastGame[ii];
+    iScore = pstGame->iCurrentLevelScore;
+    bTimeOut = pstGame->ucTimeOut;
+    memset(&stEvents, 0x00, sizeof(stEvents));
+    vStepGameState(pstGame, (int) kpiActions[ii], &stEvents);
+    dReward = (double) (pstGame->iCurrentLevelScore - iScore) / VECENV_POINTS_PER_REWARD;
+    dReward += VECENV_LIFE_REWARD * (double) stEvents.iHeroDeaths;
+    if ( pstGame->ucTimeOut && !bTimeOut ) dReward += VECENV_LIFE_REWARD;
+    /* A hero that never eats would never end the level */
+    if ( bGameStateEnded(pstGame) ) ucDone = VECENV_DONE_TERMINATED;
+    else if ( pstEnv->paiTicks[ii] >= VECENV_MAX_TICKS - 1 ) ucDone = VECENV_DONE_TRUNCATED;
+    else {
+      pstEnv->paiTicks[ii]++;
+      ucDone = 0;
+    }
+    if ( ucDone ) {
+      pstEnv->ulEpisodes++;
+      vResetVecEnvGame(pstEnv, ii);
+    }
+    pfRewards[ii] = (float) dReward;
+    pucDones[ii] = ucDone;
+    vWriteVecEnvObs(pstGame, pucObs + (size_t) ii * VECENV_OBS_BYTES);
+  }
+  pstEnv->ulSteps++;
+  pstEnv->ullStepCounts += SDL_GetPerformanceCounter() - ullStart;
+}
+
+#ifndef _WIN32
+boolean bServeVecEnv(PSTRUCT_VECENV pstEnv, const char* kpszName) {
+  PSTRUCT_VECENV_SHM pstShm = NULL;
+  Uint8* pucBase = NULL;
+  sem_t* pstRequest = NULL;
+  sem_t* pstResponse = NULL;
+  unsigned long ulOffset = 0;
+  unsigned long ulSize = 0;
+  boolean bRun = TRUE;
+  int iFd = -1;
+
+  /* Head, semaphores and the arrays, each area on its own cache lines */
+  ulOffset = ulAlignVecEnv(sizeof(STRUCT_VECENV_SHM));
+  ulSize = ulOffset + 2 * ulAlignVecEnv(sizeof(sem_t));
+  ulSize += ulAlignVecEnv(sizeof(Sint32) * (unsigned long) pstEnv->iCtEnvs);
+  ulSize += ulAlignVecEnv((unsigned long) VECENV_OBS_BYTES * (unsigned long) pstEnv->iCtEnvs);
+  ulSize += ulAlignVecEnv(sizeof(float) * (unsigned long) pstEnv->iCtEnvs);
+  ulSize += ulAlignVecEnv((unsigned long) pstEnv->iCtEnvs);
+  if ( ulSize > 0xFFFFFFFFul ) {
+    fprintf(stderr, "E: Too many environments for the shared memory: [%d]\n", pstEnv->iCtEnvs);
+    return FALSE;
+  }
+
+  if ( (iFd = shm_open(kpszName, O_RDWR | O_CREAT | O_EXCL, 0600)) < 0 ) {
+    fprintf(stderr, "E: Impossible to open the shared memory [%s]: [%s]\n", kpszName, strerror(errno));
+    return FALSE;
+  }
+  if ( ftruncate(iFd, (off_t) ulSize) != 0 ) {
+    fprintf(stderr, "E: Impossible to size the shared memory [%s]: [%s]\n", kpszName, strerror(errno));
+    close(iFd);
+    shm_unlink(kpszName);
+    return FALSE;
+  }
+  pucBase = (Uint8*) mmap(NULL, (size_t) ulSize, PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0);
+  close(iFd);
+  if ( (void*) pucBase == MAP_FAILED ) {
+    fprintf(stderr, "E: Impossible to map the shared memory [%s]: [%s]\n", kpszName, strerror(errno));
+    shm_unlink(kpszName);
+    return FALSE;
+  }
+
+  pstShm = (PSTRUCT_VECENV_SHM) pucBase;
+  pstShm->usVersion = VECENV_SHM_VERSION;
+  pstShm->usLayers = VECENV_LAYERS;
+  pstShm->usRows = MAP_ROW;
+  pstShm->usCols = MAP_COL;
+  pstShm->iCtEnvs = pstEnv->iCtEnvs;
+  pstShm->iCommand = VECENV_CMD_STEP;
+  pstShm->uiSize = (Uint32) ulSize;
+  pstShm->uiRequest = (Uint32) ulOffset;
+  ulOffset += ulAlignVecEnv(sizeof(sem_t));
+  pstShm->uiResponse = (Uint32) ulOffset;
+  ulOffset += ulAlignVecEnv(sizeof(sem_t));
+  pstShm->uiActions = (Uint32) ulOffset;
+  ulOffset += ulAlignVecEnv(sizeof(Sint32) * (unsigned long) pstEnv->iCtEnvs);
+  pstShm->uiObs = (Uint32) ulOffset;
+  ulOffset += ulAlignVecEnv((unsigned long) VECENV_OBS_BYTES * (unsigned long) pstEnv->iCtEnvs);
+  pstShm->uiRewards = (Uint32) ulOffset;
+  ulOffset += ulAlignVecEnv(sizeof(float) * (unsigned long) pstEnv->iCtEnvs);
+  pstShm->uiDones = (Uint32) ulOffset;
+
+  pstRequest = (sem_t*) (pucBase + pstShm->uiRequest);
+  pstResponse = (sem_t*) (pucBase + pstShm->uiResponse);
+  if ( sem_init(pstRequest, 1, 0) != 0 || sem_init(pstResponse, 1, 0) != 0 ) {
+    fprintf(stderr, "E: Impossible to create the semaphores of [%s]: [%s]\n", kpszName, strerror(errno));
+    munmap(pucBase, (size_t) ulSize);
+    shm_unlink(kpszName);
+    return FALSE;
+  }
+  /* The trainer waits the magic, the first observations are already there */
+  vResetVecEnv(pstEnv, pucBase + pstShm->uiObs);
+  /* Nothing written above may be seen after the magic */
+  SDL_MemoryBarrierRelease();
+  pstShm->uiMagic = VECENV_SHM_MAGIC;
+  if ( DEBUG_INFO ) vTrace("Serving [%d] environments in [%s] of [%lu] bytes", pstEnv->iCtEnvs, kpszName, ulSize);
+
+  while ( bRun ) {
+    if ( sem_wait(pstRequest) != 0 ) {
+      if ( errno == EINTR ) continue;
+      fprintf(stderr, "E: Impossible to wait the trainer of [%s]: [%s]\n", kpszName, strerror(errno));
+      break;
+    }
+    switch ( pstShm->iCommand ) {
+      case VECENV_CMD_STEP:
+        vStepVecEnv(pstEnv,
+                    (const Sint32*) (pucBase + pstShm->uiActions),
+                    pucBase + pstShm->uiObs,
+                    (float*) (pucBase + pstShm->uiRewards),
+                    pucBase + pstShm->uiDones);
+        break;
+      case VECENV_CMD_RESET:
+        vResetVecEnv(pstEnv, pucBase + pstShm->uiObs);
+        memset(pucBase + pstShm->uiDones, 0x00, (size_t) pstEnv->iCtEnvs);
+        break;
+      case VECENV_CMD_CLOSE:
+      default:
+        bRun = FALSE;
+        break;
+    }
+    sem_post(pstResponse);
+  }
+
+  if ( DEBUG_INFO ) vTrace("Shared memory [%s] closed", kpszName);
+  /* The memory stays mapped by the trainer until it unmaps it */
+  sem_destroy(pstRequest);
+  sem_destroy(pstResponse);
+  munmap(pucBase, (size_t) ulSize);
+  shm_unlink(kpszName);
+  return !bRun;
+}
+#else
+boolean bServeVecEnv(PSTRUCT_VECENV pstEnv, const char* kpszName) {
+  (void) pstEnv;
+  fprintf(stderr, "E: Impossible to open the shared memory [%s]: [POSIX shared memory is not available]\n", kpszName);
+  return FALSE;
+}
+#endif
+
+void vPrintVecEnvStats(FILE* fpOut, const STRUCT_VECENV* kpstEnv) {
+  Uint64 ullFrequency = SDL_GetPerformanceFrequency();
+  double dSeconds = (double) kpstEnv->ullStepCounts / (double) ullFrequency;
+  double dEnvSteps = (double) kpstEnv->ulSteps * (double) kpstEnv->iCtEnvs;
+
+  fprintf(fpOut, "Vecenv: [%lu] steps of [%d] environments, [%lu] episodes, [%.0f] environment steps/s\n",
+          kpstEnv->ulSteps, kpstEnv->iCtEnvs, kpstEnv->ulEpisodes, dSeconds > 0.0 ? dEnvSteps / dSeconds : 0.0);
+}
+
+void vDestroyVecEnv(PSTRUCT_VECENV pstEnv) {
+  if ( !pstEnv ) return;
+  free(pstEnv->paiTicks);
+  free(pstEnv->pastGame);
+  free(pstEnv);
+}
@@ -0,0 +1,444 @@
+/**
+ * @file tracedec.c
+ *
+ * Copyright (C) 2025 Gustavo Bacagine
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, see <https://www.gnu.org/licenses>.
+ *
+ * @brief Decoder of the binary trace of PhasmaPhuge (--trace-format=binary)
+ *
+ * @author Gustavo Bacagine <gustavo.bacagine@protonmail.com> in Aug 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "trace.h"
+
+/**
+ * @def HEADER_SIZE
+ * @brief Bytes of the header: magic plus four 32 bit words
+ */
+#define HEADER_SIZE (sizeof(TRACE_MAGIC) + 16)
+
+/**
+ * @def MAX_SPEC
+ * @brief Longest conversion specification
+ */
+#define MAX_SPEC 64
+
+/**
+ * @def MAX_FIELD
+ * @brief Widths and precisions are clamped so a field fits its buffer
+ */
+#define MAX_FIELD TRACE_LINE_MAX
+
+/**
+ * @var gapszFormat
+ * @brief Registered formats, NUL terminated copies
+ */
+static char* gapszFormat[TRACE_MAX_FORMATS];
+
+/**
+ * @var gbCsv
+ * @brief Print CSV instead of text lines
+ */
+static int gbCsv = 0;
+
+/**
+ * @brief Read a 16 bit word
+ *
+ * @param kpucData Bytes
+ * @return The word
+ */
+static unsigned int uiRead16(const unsigned char* kpucData);
+
+/**
+ * @brief Read a 32 bit word
+ *
+ * @param kpucData Bytes
+ * @return The word
+ */
+static unsigned long ulRead32(const unsigned char* kpucData);
+
+/**
+ * @brief Read a 64 bit integer written as two 32 bit words
+ *
+ * @param kpucData Bytes
+ * @return The integer (the high word is lost when long has 32 bits)
+ */
+static unsigned long ulRead64(const unsigned char* kpucData);
+
+/**
+ * @brief Print a CSV field, quoted when needed
+ *
+ * @param kpszField Field
+ */
+static void vPrintCsvField(const char* kpszField);
+
+/**
+ * @brief Print an event
+ *
+ * @param lStart Time of the start of the trace
+ * @param ulUs Microseconds since the start
+ * @param iId Format id
+ * @param kpucArgs Arguments
+ * @param iArgsLen Bytes of the arguments
+ */
+static void vPrintEvent(time_t lStart, unsigned long ulUs, int iId, const unsigned char* kpucArgs, int iArgsLen);
+
+/**
+ * @brief Check for a header of this version and byte order
+ *
+ * @param kpucData Bytes
+ * @param ulLeft Bytes left in the file
+ * @return 1 header, 0 otherwise
+ */
+static int bIsHeader(const unsigned char* kpucData, unsigned long ulLeft);
+
+/**
+ * @brief Free the formats of the previous run
+ */
+static void vFreeFormats(void);
+
+/**
+ * @brief Read the records of a run, the formats on the first pass and the
+ * events on the second one
+ *
+ * @param kpucData Bytes of the file
+ * @param ulSize Bytes to read
+ * @param ulAt First record after the header of the run
+ * @param iPass 0 formats, 1 events
+ * @param lStart Time of the start of the run
+ * @return Offset of the header of the next run, ulSize at the end or on a
+ * corrupted record
+ */
+static unsigned long ulDecodeRun(const unsigned char* kpucData, unsigned long ulSize, unsigned long ulAt, int iPass, time_t lStart);
+
+static unsigned int uiRead16(const unsigned char* kpucData) {
+  unsigned short usValue = 0;
+  memcpy(&usValue, kpucData, 2);
+  return usValue;
+}
+
+static unsigned long ulRead32(const unsigned char* kpucData) {
+  unsigned int uiValue = 0;
+  memcpy(&uiValue, kpucData, 4);
+  return uiValue;
+}
+
+static unsigned long ulRead64(const unsigned char* kpucData) {
+  unsigned long ulLow = ulRead32(kpucData);
+  unsigned long ulHigh = ulRead32(kpucData + 4);
+  if ( sizeof(unsigned long) > 4 ) return ((ulHigh << 16) << 16) | ulLow;
+  return ulLow;
+}
+
+static void vPrintCsvField(const char* kpszField) {
+  const char* kpszChar = kpszField;
+  if ( !strpbrk(kpszField, ",\"\n") ) {
+    printf("%s", kpszField);
+    return;
+  }
+  putchar('"');
+  for ( kpszChar = kpszField; *kpszChar; kpszChar++ ) {
+    if ( *kpszChar == '"' ) putchar('"');
+    putchar(*kpszChar);
+  }
+  putchar('"');
+}
+
+static void vPrintEvent(time_t lStart, unsigned long ulUs, int iId, const unsigned char* kpucArgs, int iArgsLen) {
+  char szMessage[TRACE_FORMAT_MAX];
+  char szField[MAX_FIELD * 3];
+  char szSpec[MAX_SPEC];
+  char szString[TRACE_LINE_MAX + 1];
+  char aszCsv[32][MAX_FIELD + 1];
+  const char* kpszFmt = NULL;
+  const char* kpszConv = NULL;
+  int iCtCsv = 0;
+  int iMsgLen = 0;
+  int iAt = 0;
+  int ii = 0;
+
+  if ( iId == TRACE_TEXT_ID ) kpszFmt = "%s";
+  else if ( iId < TRACE_MAX_FORMATS ) kpszFmt = gapszFormat[iId];
+  if ( !kpszFmt ) kpszFmt = "<unknown format>";
+
+  szMessage[0] = '\0';
+  for ( kpszConv = kpszFmt; *kpszConv && TRACE_FORMAT_MAX - iMsgLen > (int) sizeof(szField); ) {
+    const char* kpszBegin = kpszConv;
+    int iSpecLen = 0;
+    int bLong = 0;
+    int bMissing = 0;
+
+    if ( *kpszConv != '%' ) {
+      szMessage[iMsgLen++] = *kpszConv++;
+      szMessage[iMsgLen] = '\0';
+      continue;
+    }
+    if ( kpszConv[1] == '%' ) {
+      szMessage[iMsgLen++] = '%';
+      szMessage[iMsgLen] = '\0';
+      kpszConv += 2;
+      continue;
+    }
+
+    /* Copy the specification, the '*' are replaced by the recorded values
+     * and the widths and precisions are clamped like them */
+    szSpec[iSpecLen++] = *kpszConv++;
+    while ( *kpszConv && !isalpha((unsigned char) *kpszConv) && iSpecLen < MAX_SPEC - 16 ) {
+      /* A leading '0' is the flag, it is copied as is */
+      if ( *kpszConv >= '1' && *kpszConv <= '9' ) {
+        long lValue = 0;
+        while ( isdigit((unsigned char) *kpszConv) ) {
+          if ( lValue <= MAX_FIELD ) lValue = lValue * 10 + (*kpszConv - '0');
+          kpszConv++;
+        }
+        if ( lValue > MAX_FIELD ) lValue = MAX_FIELD;
+        iSpecLen += sprintf(szSpec + iSpecLen, "%ld", lValue);
+        continue;
+      }
+      if ( *kpszConv == '*' ) {
+        long lValue = 0;
+        if ( iArgsLen - iAt < 4 ) {
+          bMissing = 1;
+          break;
+        }
+        lValue = (long) (int) ulRead32(kpucArgs + iAt);
+        iAt += 4;
+        if ( lValue < 0 ) lValue = 0;
+        if ( lValue > MAX_FIELD ) lValue = MAX_FIELD;
+        iSpecLen += sprintf(szSpec + iSpecLen, "%ld", lValue);
+        kpszConv++;
+        continue;
+      }
+      szSpec[iSpecLen++] = *kpszConv++;
+    }
+    if ( *kpszConv == 'l' ) {
+      bLong = 1;
+      szSpec[iSpecLen++] = *kpszConv++;
+    }
+    else if ( *kpszConv == 'h' ) {
+      kpszConv++;
+    }
+    szSpec[iSpecLen++] = *kpszConv;
+    szSpec[iSpecLen] = '\0';
+
+    szField[0] = '\0';
+    switch ( *kpszConv ) {
+      case 'd': case 'i': case 'c': case 'u': case 'x': case 'X': case 'o': {
+        if ( bLong ) {
+          if ( iArgsLen - iAt < 8 ) {
+            bMissing = 1;
+            break;
+          }
+          sprintf(szField, szSpec, ulRead64(kpucArgs + iAt));
+          iAt += 8;
+        }
+        else {
+          if ( iArgsLen - iAt < 4 ) {
+            bMissing = 1;
+            break;
+          }
+          sprintf(szField, szSpec, (int) ulRead32(kpucArgs + iAt));
+          iAt += 4;
+        }
+        break;
+      }
+      case 'f': case 'e': case 'E': case 'g': case 'G': {
+        double dValue = 0;
+        if ( iArgsLen - iAt < 8 ) {
+          bMissing = 1;
+          break;
+        }
+        memcpy(&dValue, kpucArgs + iAt, 8);
+        iAt += 8;
+        sprintf(szField, szSpec, dValue);
+        break;
+      }
+      case 's': {
+        int iLen = 0;
+        if ( iArgsLen - iAt < 2 ) {
+          bMissing = 1;
+          break;
+        }
+        iLen = (int) uiRead16(kpucArgs + iAt);
+        iAt += 2;
+        if ( iArgsLen - iAt < iLen ) iLen = iArgsLen - iAt;
+        memcpy(szString, kpucArgs + iAt, (size_t) iLen);
+        szString[iLen] = '\0';
+        iAt += iLen;
+        sprintf(szField, szSpec, szString);
+        break;
+      }
+      case 'p': {
+        if ( iArgsLen - iAt < 8 ) {
+          bMissing = 1;
+          break;
+        }
+        sprintf(szField, "0x%lx", ulRead64(kpucArgs + iAt));
+        iAt += 8;
+        break;
+      }
+      default: {
+        sprintf(szField, "%.*s", (int) (kpszConv - kpszBegin + 1), kpszBegin);
+        break;
+      }
+    }
+    if ( bMissing ) strcpy(szField, "?");
+    if ( *kpszConv ) kpszConv++;
+
+    iMsgLen += sprintf(szMessage + iMsgLen, "%s", szField);
+    if ( iCtCsv < 32 ) sprintf(aszCsv[iCtCsv++], "%.*s", MAX_FIELD, szField);
+  }
+
+  if ( gbCsv ) {
+    char szTime[32];
+    sprintf(szTime, "%lu,%d,", ulUs, iId == TRACE_TEXT_ID ? -1 : iId);
+    printf("%s", szTime);
+    vPrintCsvField(kpszFmt);
+    for ( ii = 0; ii < iCtCsv; ii++ ) {
+      putchar(',');
+      vPrintCsvField(aszCsv[ii]);
+    }
+    putchar('\n');
+  }
+  else {
+    time_t lSeconds = lStart + (time_t) (ulUs / 1000000ul);
+    struct tm* pstToday = localtime(&lSeconds);
+    printf(
+      "%02d/%02d/%02d %02d:%02d:%02d.%06lu - %s\n",
+      pstToday->tm_mday,
+      pstToday->tm_mon+1,
+      pstToday->tm_year+1900,
+      pstToday->tm_hour,
+      pstToday->tm_min,
+      pstToday->tm_sec,
+      ulUs % 1000000ul,
+      szMessage
+    );
+  }
+}
+
+static int bIsHeader(const unsigned char* kpucData, unsigned long ulLeft) {
+  return ulLeft >= HEADER_SIZE &&
+         memcmp(kpucData, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0 &&
+         ulRead32(kpucData + sizeof(TRACE_MAGIC)) == 0x01020304ul &&
+         ulRead32(kpucData + sizeof(TRACE_MAGIC) + 4) == TRACE_BINARY_VERSION;
+}
+
+static void vFreeFormats(void) {
+  int ii = 0;
+  for ( ii = 0; ii < TRACE_MAX_FORMATS; ii++ ) {
+    if ( gapszFormat[ii] ) free(gapszFormat[ii]);
+    gapszFormat[ii] = NULL;
+  }
+}
+
+static unsigned long ulDecodeRun(const unsigned char* kpucData, unsigned long ulSize, unsigned long ulAt, int iPass, time_t lStart) {
+  while ( ulAt < ulSize ) {
+    unsigned long ulLeft = ulSize - ulAt;
+    unsigned char ucType = kpucData[ulAt];
+    if ( ucType == TRACE_RECORD_FORMAT && ulLeft >= 5 ) {
+      unsigned int uiId = uiRead16(kpucData + ulAt + 1);
+      unsigned int uiLen = uiRead16(kpucData + ulAt + 3);
+      if ( ulLeft - 5 < uiLen ) break;
+      if ( iPass == 0 && uiId < TRACE_MAX_FORMATS && !gapszFormat[uiId] && (gapszFormat[uiId] = (char*) malloc(uiLen + 1)) != NULL ) {
+        memcpy(gapszFormat[uiId], kpucData + ulAt + 5, uiLen);
+        gapszFormat[uiId][uiLen] = '\0';
+      }
+      ulAt += 5 + uiLen;
+    }
+    else if ( ucType == TRACE_RECORD_EVENT && ulLeft >= 13 ) {
+      unsigned int uiId = uiRead16(kpucData + ulAt + 1);
+      unsigned long ulUs = ulRead64(kpucData + ulAt + 3);
+      unsigned int uiLen = uiRead16(kpucData + ulAt + 11);
+      if ( ulLeft - 13 < uiLen ) break;
+      if ( iPass == 1 ) vPrintEvent(lStart, ulUs, (int) uiId, kpucData + ulAt + 13, (int) uiLen);
+      ulAt += 13 + uiLen;
+    }
+    else if ( bIsHeader(kpucData + ulAt, ulLeft) ) {
+      /* Another run, rotated files put together */
+      return ulAt;
+    }
+    else {
+      if ( iPass == 0 ) fprintf(stderr, "E: Corrupted record at offset %lu\n", ulAt);
+      break;
+    }
+  }
+  return ulSize;
+}
+
+int main(int argc, char** argv) {
+  FILE* fpTrace = NULL;
+  unsigned char* pucData = NULL;
+  const char* kpszPath = NULL;
+  time_t lStart = 0;
+  unsigned long ulSize = 0;
+  unsigned long ulAt = 0;
+  unsigned long ulEnd = 0;
+  long lSize = 0;
+  int ii = 0;
+
+  for ( ii = 1; ii < argc; ii++ ) {
+    if ( strcmp(argv[ii], "--csv") == 0 ) gbCsv = 1;
+    else kpszPath = argv[ii];
+  }
+  if ( !kpszPath ) {
+    fprintf(stderr, "Usage: %s [--csv] <binary trace>\n", argv[0]);
+    return 1;
+  }
+
+  if ( (fpTrace = fopen(kpszPath, "rb")) == NULL ) {
+    fprintf(stderr, "E: Impossible to open the file [%s]\n", kpszPath);
+    return 1;
+  }
+  fseek(fpTrace, 0L, SEEK_END);
+  lSize = ftell(fpTrace);
+  fseek(fpTrace, 0L, SEEK_SET);
+  if ( lSize < (long) HEADER_SIZE || (pucData = (unsigned char*) malloc((size_t) lSize)) == NULL ) {
+    fprintf(stderr, "E: [%s] is not a binary trace\n", kpszPath);
+    fclose(fpTrace);
+    return 1;
+  }
+  if ( fread(pucData, 1, (size_t) lSize, fpTrace) != (size_t) lSize ) {
+    fprintf(stderr, "E: Error reading [%s]\n", kpszPath);
+    fclose(fpTrace);
+    free(pucData);
+    return 1;
+  }
+  fclose(fpTrace);
+
+  ulSize = (unsigned long) lSize;
+  if ( !bIsHeader(pucData, ulSize) ) {
+    fprintf(stderr, "E: [%s] is not a binary trace of this version and byte order\n", kpszPath);
+    free(pucData);
+    return 1;
+  }
+  if ( gbCsv ) printf("time_us,event_id,format,args\n");
+
+  /* Each run has its own formats and start, they may follow their first event */
+  for ( ulAt = 0; ulAt < ulSize; ulAt = ulEnd ) {
+    lStart = (time_t) ulRead64(pucData + ulAt + sizeof(TRACE_MAGIC) + 8);
+    vFreeFormats();
+    ulEnd = ulDecodeRun(pucData, ulSize, ulAt + HEADER_SIZE, 0, lStart);
+    ulDecodeRun(pucData, ulEnd, ulAt + HEADER_SIZE, 1, lStart);
+  }
+
+  vFreeFormats();
+  free(pucData);
+  return 0;
+}